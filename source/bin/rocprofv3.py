@@ -172,6 +172,10 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
         "--kernel-rename",
         help="Use region names defined by roctxRangePush/roctxRangePop regions to rename the kernels",
     )
+    add_parser_bool_argument(
+        "--streaming-output",
+        help="Write the CSV output incrementally while the application runs instead of at exit",
+    )
     parser.add_argument(
         "-i",
         "--input",
@@ -202,6 +206,13 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
         choices=("csv", "json", "pftrace", "otf2"),
         type=str.lower,
     )
+    parser.add_argument(
+        "--output-threads",
+        help="Number of threads used to generate the output files at exit. The output files are generated concurrently by default (previously, they were generated one after the other): use 1 to generate them sequentially in the exiting thread. default: number of CPUs (at most 16)",
+        default=None,
+        type=int,
+        metavar="N",
+    )
     parser.add_argument(
         "--log-level",
         help="Set the log level",
@@ -618,6 +629,7 @@ def run(app_args, args, **kwargs):
     for opt, env_val in dict(
         [
             ["kernel_rename", "KERNEL_RENAME"],
+            ["streaming_output", "STREAMING_OUTPUT"],
         ]
     ).items():
         val = getattr(args, f"{opt}")
@@ -630,6 +642,7 @@ def run(app_args, args, **kwargs):
             ["perfetto_shmem_size_hint", "PERFETTO_SHMEM_SIZE_HINT_KB"],
             ["perfetto_fill_policy", "PERFETTO_BUFFER_FILL_POLICY"],
             ["perfetto_backend", "PERFETTO_BACKEND"],
+            ["output_threads", "OUTPUT_THREADS"],
         ]
     ).items():
         val = getattr(args, f"{opt}")
@@ -167,6 +167,73 @@ rocprofiler_att_parse_data(rocprofiler_att_parser_se_data_callback_t se_data_cal
                            rocprofiler_att_parser_isa_callback_t     isa_callback,
                            void*                                     userdata) ROCPROFILER_API;
 
+/**
+ * @brief Data of a single shader engine for rocprofiler_att_parse_data_batched(), e.g. as
+ * received by ::rocprofiler_att_shader_data_callback_t.
+ */
+typedef struct
+{
+    int64_t        shader_engine_id;  ///< ID of the shader engine
+    const uint8_t* data;              ///< Pointer to the ATT data of the shader engine
+    uint64_t       data_size;         ///< Number of bytes in "data"
+} rocprofiler_att_parser_shader_engine_data_t;
+
+/**
+ * @brief Contiguous arrays of parsed ATT records of a shader engine. Within each array, the
+ * records are in the order produced by the parser. The arrays are only valid for the duration
+ * of the callback.
+ */
+typedef struct
+{
+    uint64_t                                     size;  ///< Size of this struct
+    int64_t                                      shader_engine_id;
+    const rocprofiler_att_data_type_isa_t*       isa;
+    uint64_t                                     isa_count;
+    const rocprofiler_att_data_type_occupancy_t* occupancy;
+    uint64_t                                     occupancy_count;
+} rocprofiler_att_parser_batch_t;
+
+/**
+ * @brief Callback for rocprofiler to return batches of parsed ATT data.
+ * @param[in] batch Batch of ISA and occupancy records.
+ * @param[in] userdata Arbitrary data pointer to be sent back to the user via callback.
+ */
+typedef void (*rocprofiler_att_parser_batch_callback_t)(const rocprofiler_att_parser_batch_t* batch,
+                                                        void* userdata);
+
+typedef enum
+{
+    ROCPROFILER_ATT_PARSER_FLAG_NONE = 0,
+    /// Decode the shader engines concurrently on the internal thread pool of rocprofiler-sdk.
+    /// The batch and ISA callbacks are invoked concurrently from multiple threads and must be
+    /// thread-safe. The decoder of aqlprofile (aqlprofile_att_parse_data) is then invoked
+    /// concurrently on the data of different shader engines: only set this flag with an
+    /// aqlprofile whose decoder is reentrant. The calls into aqlprofile are not serialized.
+    ROCPROFILER_ATT_PARSER_FLAG_PARALLEL_SHADER_ENGINES = (1 << 0),
+} rocprofiler_att_parser_flags_t;
+
+/**
+ * @brief Parses the ATT data of a set of shader engines and returns the records in batches
+ * instead of one callback per record as in rocprofiler_att_parse_data().
+ * @param[in] shader_engines Array of shader engine data.
+ * @param[in] num_shader_engines Number of entries in shader_engines.
+ * @param[in] batch_callback Callback where the batches of trace data are returned to.
+ * @param[in] isa_callback Callback to return ISA lines.
+ * @param[in] flags Bitwise-or of ::rocprofiler_att_parser_flags_t.
+ * @param[in] userdata Userdata passed back to caller via callback.
+ * @retval ROCPROFILER_STATUS_SUCCESS on success.
+ * @retval ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT if a callback is null.
+ * @retval ROCPROFILER_STATUS_ERROR if parsing of a shader engine failed.
+ */
+rocprofiler_status_t
+rocprofiler_att_parse_data_batched(
+    const rocprofiler_att_parser_shader_engine_data_t* shader_engines,
+    uint64_t                                           num_shader_engines,
+    rocprofiler_att_parser_batch_callback_t            batch_callback,
+    rocprofiler_att_parser_isa_callback_t              isa_callback,
+    uint64_t                                           flags,
+    void*                                              userdata) ROCPROFILER_API;
+
 /** @} */
 
 ROCPROFILER_EXTERN_C_FINI
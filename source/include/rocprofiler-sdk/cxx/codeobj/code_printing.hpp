@@ -26,12 +26,17 @@
 #include <hsa/amd_hsa_elf.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -64,6 +69,125 @@ struct Instruction
     marker_id_t codeobj_id{0};  // Instruction code object load id, if from loaded codeobj
 };
 
+/**
+ * @brief Same as Instruction, but the text and the source location reference a
+ * DecodedInstructionTable, which must outlive the view.
+ */
+struct InstructionView
+{
+    std::string_view inst{};
+    std::string_view comment{};
+    uint64_t         faddr{0};
+    uint64_t         vaddr{0};
+    size_t           size{0};
+    uint64_t         ld_addr{0};
+    marker_id_t      codeobj_id{0};
+
+    std::unique_ptr<Instruction> to_instruction() const
+    {
+        auto _inst        = std::make_unique<Instruction>(std::string{inst}, size);
+        _inst->comment    = comment;
+        _inst->faddr      = faddr;
+        _inst->vaddr      = vaddr;
+        _inst->ld_addr    = ld_addr;
+        _inst->codeobj_id = codeobj_id;
+        return _inst;
+    }
+};
+
+/**
+ * @brief Immutable table of every instruction of a code object, sorted by vaddr. The instruction
+ * text and source locations are interned, so each distinct string is stored once. Lookups are
+ * read-only and can be done concurrently without locking.
+ */
+class DecodedInstructionTable
+{
+public:
+    struct decoded_t
+    {
+        uint64_t         vaddr{0};
+        uint64_t         faddr{0};
+        size_t           size{0};
+        std::string      inst{};
+        std::string_view comment{};
+    };
+
+    DecodedInstructionTable() = default;
+    explicit DecodedInstructionTable(std::vector<std::vector<decoded_t>>&& decoded)
+    {
+        auto string_ids = std::unordered_map<std::string_view, uint32_t>{};
+        auto intern     = [&](std::string_view str) -> uint32_t {
+            auto it = string_ids.find(str);
+            if(it != string_ids.end()) return it->second;
+
+            auto id = static_cast<uint32_t>(m_strings.size());
+            string_ids.emplace(m_strings.emplace_back(str), id);
+            return id;
+        };
+        intern("");
+
+        size_t count = 0;
+        for(auto& itr : decoded)
+            count += itr.size();
+
+        m_entries.reserve(count);
+        for(auto& itr : decoded)
+            for(auto& inst : itr)
+                m_entries.push_back(entry_t{inst.vaddr,
+                                            inst.faddr,
+                                            static_cast<uint32_t>(inst.size),
+                                            intern(inst.inst),
+                                            intern(inst.comment)});
+
+        std::sort(m_entries.begin(), m_entries.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.vaddr < rhs.vaddr;
+        });
+        // symbols may alias the same code
+        auto last = std::unique(m_entries.begin(), m_entries.end(), [](auto& lhs, auto& rhs) {
+            return lhs.vaddr == rhs.vaddr;
+        });
+        m_entries.erase(last, m_entries.end());
+        m_entries.shrink_to_fit();
+    }
+
+    DecodedInstructionTable(const DecodedInstructionTable&) = delete;
+    DecodedInstructionTable& operator=(const DecodedInstructionTable&) = delete;
+
+    // vaddr must be the address of the first byte of an instruction
+    std::optional<InstructionView> find(uint64_t vaddr) const
+    {
+        auto it = std::lower_bound(
+            m_entries.begin(), m_entries.end(), vaddr, [](const auto& entry, uint64_t addr) {
+                return entry.vaddr < addr;
+            });
+        if(it == m_entries.end() || it->vaddr != vaddr) return std::nullopt;
+
+        auto view    = InstructionView{};
+        view.inst    = m_strings.at(it->inst);
+        view.comment = m_strings.at(it->comment);
+        view.faddr   = it->faddr;
+        view.vaddr   = it->vaddr;
+        view.size    = it->size;
+        return view;
+    }
+
+    size_t size() const { return m_entries.size(); }
+    size_t num_strings() const { return m_strings.size(); }
+
+private:
+    struct entry_t
+    {
+        uint64_t vaddr{0};
+        uint64_t faddr{0};
+        uint32_t size{0};
+        uint32_t inst{0};
+        uint32_t comment{0};
+    };
+
+    std::vector<entry_t>    m_entries{};
+    std::deque<std::string> m_strings{};  // deque so the interned strings never move
+};
+
 class CodeobjDecoderComponent
 {
     struct ProtectedFd
@@ -185,6 +309,80 @@ public:
         return inst;
     }
 
+    /**
+     * @brief Disassembles every function symbol once. A comgr disassembler is not thread safe, so
+     * each of the num_threads threads decodes its share of the symbols with its own instance.
+     * A symbol which fails to decode is left out of the table entirely, so lookups into its range
+     * fall back to decoding on demand, as without predecoding.
+     */
+    std::shared_ptr<const DecodedInstructionTable> decode_all(size_t num_threads = 1) const
+    {
+        if(!disassembly) throw std::exception();
+
+        auto symbols = std::vector<SymbolInfo>{};
+        for(const auto& [_, symbol] : m_symbol_map)
+            symbols.emplace_back(symbol);
+
+        auto decoded     = std::vector<std::vector<DecodedInstructionTable::decoded_t>>{};
+        auto next_symbol = std::atomic<size_t>{0};
+
+        num_threads = std::max<size_t>(std::min(num_threads, symbols.size()), 1);
+        decoded.resize(symbols.size());
+
+        auto decode_symbol = [&](DisassemblyInstance& inst, size_t i) {
+            const auto& symbol = symbols.at(i);
+            for(uint64_t offset = 0; offset < symbol.mem_size;)
+            {
+                auto [text, size] = inst.ReadInstruction(symbol.faddr + offset);
+                if(size == 0) break;
+
+                auto& itr = decoded.at(i).emplace_back();
+                itr.vaddr = symbol.vaddr + offset;
+                itr.faddr = symbol.faddr + offset;
+                itr.size  = size;
+                itr.inst  = std::move(text);
+
+                auto line = m_line_number_map.find({itr.vaddr, 0, 0});
+                if(line != m_line_number_map.end()) itr.comment = line->second;
+
+                offset += size;
+            }
+        };
+
+        auto decode_symbols = [&]() {
+            auto inst = std::unique_ptr<DisassemblyInstance>{};
+            try
+            {
+                const auto& buffer = disassembly->buffer;
+                inst = std::make_unique<DisassemblyInstance>(buffer.data(), buffer.size());
+            } catch(...)
+            {
+                // the other threads decode the symbols
+                return;
+            }
+
+            for(size_t i = next_symbol++; i < symbols.size(); i = next_symbol++)
+            {
+                try
+                {
+                    decode_symbol(*inst, i);
+                } catch(...)
+                {
+                    decoded.at(i).clear();
+                }
+            }
+        };
+
+        auto threads = std::vector<std::thread>{};
+        for(size_t i = 1; i < num_threads; ++i)
+            threads.emplace_back(decode_symbols);
+        decode_symbols();
+        for(auto& itr : threads)
+            itr.join();
+
+        return std::make_shared<const DecodedInstructionTable>(std::move(decoded));
+    }
+
     std::map<uint64_t, SymbolInfo>            m_symbol_map{};
     std::vector<std::shared_ptr<Instruction>> instructions{};
     std::unique_ptr<DisassemblyInstance>      disassembly{};
@@ -235,6 +433,13 @@ public:
     {
         if(!decoder || ld_addr < load_addr) return nullptr;
 
+        // The table only covers what decode_all() reached, e.g. not code outside of the
+        // symbols. Anything else is decoded on demand, as without predecoding.
+        if(decoded)
+        {
+            if(auto view = get_view(ld_addr)) return view->to_instruction();
+        }
+
         uint64_t voffset = ld_addr - load_addr;
         auto     faddr   = decoder->va2fo(voffset);
         if(!faddr) return nullptr;
@@ -245,6 +450,23 @@ public:
         return unique;
     }
 
+    // Decodes the whole code object up front, after which get() only invokes comgr on a miss
+    void decode_all(size_t num_threads = 1)
+    {
+        if(decoder) decoded = decoder->decode_all(num_threads);
+    }
+    bool is_decoded() const { return decoded != nullptr; }
+
+    // Only available after decode_all(). Safe to call concurrently.
+    std::optional<InstructionView> get_view(uint64_t ld_addr) const
+    {
+        if(!decoded || ld_addr < load_addr) return std::nullopt;
+
+        auto view = decoded->find(ld_addr - load_addr);
+        if(view) view->ld_addr = ld_addr;
+        return view;
+    }
+
     uint64_t begin() const { return load_addr; };
     uint64_t end() const { return load_end; }
     uint64_t size() const { return load_end - load_addr; }
@@ -270,7 +492,8 @@ public:
 private:
     uint64_t load_end{0};
 
-    std::unique_ptr<CodeobjDecoderComponent> decoder{nullptr};
+    std::unique_ptr<CodeobjDecoderComponent>       decoder{nullptr};
+    std::shared_ptr<const DecodedInstructionTable> decoded{nullptr};
 };
 
 /**
@@ -287,7 +510,9 @@ public:
                             uint64_t    load_addr,
                             uint64_t    memsize)
     {
-        decoders[id] = std::make_shared<LoadedCodeobjDecoder>(filepath, load_addr, memsize);
+        auto decoder = std::make_shared<LoadedCodeobjDecoder>(filepath, load_addr, memsize);
+        if(predecode_threads > 0) decoder->decode_all(predecode_threads);
+        decoders[id] = std::move(decoder);
     }
 
     virtual void addDecoder(const void* data,
@@ -296,8 +521,19 @@ public:
                             uint64_t    load_addr,
                             uint64_t    memsize)
     {
-        decoders[id] =
+        auto decoder =
             std::make_shared<LoadedCodeobjDecoder>(data, memory_size, load_addr, memsize);
+        if(predecode_threads > 0) decoder->decode_all(predecode_threads);
+        decoders[id] = std::move(decoder);
+    }
+
+    /**
+     * @brief Code objects added from now on are decoded entirely when added, using num_threads
+     * threads. Instruction lookups then become a binary search and get_view() can be used.
+     */
+    void enablePredecode(size_t num_threads = 1)
+    {
+        predecode_threads = std::max<size_t>(num_threads, 1);
     }
 
     virtual bool removeDecoderbyId(marker_id_t id) { return decoders.erase(id) != 0; }
@@ -315,6 +551,20 @@ public:
         return nullptr;
     }
 
+    /**
+     * @brief Lookup into the predecoded code object. Does not modify the map, so it only needs
+     * to be serialized against adding and removing decoders.
+     */
+    std::optional<InstructionView> get_view(marker_id_t id, uint64_t offset) const
+    {
+        auto it = decoders.find(id);
+        if(it == decoders.end()) return std::nullopt;
+
+        auto view = it->second->get_view(it->second->begin() + offset);
+        if(view) view->codeobj_id = id;
+        return view;
+    }
+
     const char* getSymbolName(marker_id_t id, uint64_t offset)
     {
         try
@@ -329,6 +579,7 @@ public:
 
 protected:
     std::unordered_map<marker_id_t, std::shared_ptr<LoadedCodeobjDecoder>> decoders{};
+    size_t                                                                  predecode_threads{0};
 };
 
 /**
@@ -382,6 +633,21 @@ public:
             return this->Super::get(id, offset);
     }
 
+    std::optional<InstructionView> get_view(uint64_t vaddr) const
+    {
+        auto it = table.find(segment::address_range_t{vaddr, 0, 0});
+        if(it == table.end()) return std::nullopt;
+        return this->Super::get_view(it->id, vaddr - it->addr);
+    }
+
+    std::optional<InstructionView> get_view(marker_id_t id, uint64_t offset) const
+    {
+        if(id == 0)
+            return get_view(offset);
+        else
+            return this->Super::get_view(id, offset);
+    }
+
     const char* getSymbolName(uint64_t vaddr)
     {
         for(auto& [_, decoder] : decoders)
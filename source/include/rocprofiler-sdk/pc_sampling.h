@@ -194,6 +194,42 @@ rocprofiler_query_pc_sampling_agent_configurations(
     rocprofiler_available_pc_sampling_configurations_cb_t cb,
     void* user_data) ROCPROFILER_API ROCPROFILER_NONNULL(2, 3);
 
+/**
+ * @brief Aggregate the PC samples of the agent with @p agent_id inside rocprofiler-SDK instead
+ * of delivering every sample.
+ *
+ * Instead of one ::rocprofiler_pc_sampling_record_t per sample, the samples are counted in a
+ * histogram keyed by the code object, the offset of the PC within the code object, the exec
+ * mask and the stall/issue reason. Only the keys whose counts changed since the previous flush
+ * are delivered, as ::rocprofiler_pc_sampling_aggregate_record_t records of the
+ * ::ROCPROFILER_PC_SAMPLING_RECORD_AGGREGATE kind, into the buffer passed to
+ * @ref rocprofiler_configure_pc_sampling_service.
+ *
+ * The counts are flushed when a batch of samples is processed and at least @p flush_interval
+ * nanoseconds have elapsed since the previous flush. Regardless of @p flush_interval, the
+ * counts are also flushed when the buffer is flushed (see @ref rocprofiler_flush_buffer), when
+ * the PC sampling service is stopped, and before every code object load/unload marker record.
+ * A @p flush_interval of zero restricts flushing to these events.
+ *
+ * @param [in] context_id     - id of the context containing the PC sampling service
+ * @param [in] agent_id       - id of the agent on which PC sampling service is configured
+ * @param [in] flush_interval - minimum number of nanoseconds between periodic flushes
+ * @return ::rocprofiler_status_t
+ * @retval ::ROCPROFILER_STATUS_SUCCESS aggregation configured successfully
+ * @retval ::ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED function invoked outside of the tool
+ * initialization
+ * @retval ::ROCPROFILER_STATUS_ERROR_CONTEXT_NOT_FOUND invalid @p context_id
+ * @retval ::ROCPROFILER_STATUS_ERROR_AGENT_NOT_FOUND invalid @p agent_id
+ * @retval ::ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT PC sampling service is not configured on
+ * the agent within the context
+ * @retval ::ROCPROFILER_STATUS_ERROR_SERVICE_ALREADY_CONFIGURED aggregation has already been
+ * configured for the agent
+ */
+rocprofiler_status_t
+rocprofiler_configure_pc_sampling_aggregation(rocprofiler_context_id_t context_id,
+                                              rocprofiler_agent_id_t   agent_id,
+                                              uint64_t flush_interval) ROCPROFILER_API;
+
 /**
  * @brief The header of the @ref rocprofiler_pc_sampling_record_t, indicating
  * what fields of the @ref rocprofiler_pc_sampling_record_t instance are meaningful
@@ -302,6 +338,36 @@ typedef struct
     uint64_t code_object_id;  /// unique code object identifier
 } rocprofiler_pc_sampling_code_object_unload_marker_t;
 
+/**
+ * @brief Number of PC samples sharing the same code object, offset, exec mask and stall/issue
+ * reason since the previous record of this key.
+ *
+ * @see rocprofiler_configure_pc_sampling_aggregation for more information
+ */
+typedef struct
+{
+    uint64_t                              size;  ///< Size of this struct
+    rocprofiler_pc_sampling_header_v1_t   flags;
+    uint8_t                               wave_issued : 1;
+    uint8_t                               reserved    : 7;  ///< reserved 7 bits, must be zero
+    uint16_t                              reserved1;        ///< for future use
+    rocprofiler_pc_sampling_snapshot_v1_t snapshot;
+    uint64_t                              code_object_id;
+    uint64_t                              code_object_offset;
+    uint64_t                              exec_mask;
+    uint64_t                              count;  ///< number of samples
+
+    /// @var flags
+    /// @brief flags of the aggregated samples, @see rocprofiler_pc_sampling_record_t
+    /// @var snapshot
+    /// @brief stall/issue reason of the aggregated samples, if flags.has_stall_reason is set
+    /// @var code_object_id
+    /// @brief code object containing the PC of the samples. Zero if the PC does not belong to
+    /// a code object loaded on the agent, in which case @ref code_object_offset is the PC.
+    /// @var code_object_offset
+    /// @brief offset of the PC from the load base of the code object
+} rocprofiler_pc_sampling_aggregate_record_t;
+
 /** @} */
 
 ROCPROFILER_EXTERN_C_FINI
@@ -313,3 +379,8 @@ ROCPROFILER_CXX_CODE(
 ROCPROFILER_CXX_CODE(static_assert(offsetof(rocprofiler_pc_sampling_record_t, chiplet) == 9 &&
                                        offsetof(rocprofiler_pc_sampling_record_t, reserved2) == 76,
                                    "PC sampling record layout changed."));
+
+ROCPROFILER_CXX_CODE(
+    static_assert(sizeof(rocprofiler_pc_sampling_aggregate_record_t) == 48 &&
+                      offsetof(rocprofiler_pc_sampling_aggregate_record_t, snapshot) == 12,
+                  "PC sampling aggregate record layout changed."));
@@ -46,7 +46,11 @@ struct rhb_raii_lock
 };
 }  // namespace
 
-record_header_buffer::record_header_buffer(size_t num_bytes) { allocate(num_bytes); }
+record_header_buffer::record_header_buffer(size_t num_bytes, sync_mode _mode)
+: m_mode{_mode}
+{
+    allocate(num_bytes);
+}
 
 record_header_buffer::record_header_buffer(record_header_buffer&& _rhs) noexcept
 {
@@ -59,6 +63,7 @@ record_header_buffer::operator=(record_header_buffer&& _rhs) noexcept
     if(this != &_rhs)
     {
         auto _lk  = rhb_raii_lock{_rhs};
+        m_mode    = _rhs.m_mode;
         m_index   = _rhs.m_index.load(std::memory_order_acquire);
         m_buffer  = std::move(_rhs.m_buffer);
         m_headers = std::move(_rhs.m_headers);
@@ -81,6 +86,15 @@ record_header_buffer::allocate(size_t num_bytes)
     return true;
 }
 
+bool
+record_header_buffer::set_sync_mode(sync_mode _mode)
+{
+    if(m_buffer.is_initialized()) return false;
+
+    m_mode = _mode;
+    return true;
+}
+
 record_header_buffer::record_ptr_vec_t
 record_header_buffer::get_record_headers(size_t _n)
 {
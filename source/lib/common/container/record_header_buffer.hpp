@@ -26,10 +26,12 @@
 
 #include "lib/common/container/ring_buffer.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <limits>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <vector>
 
 namespace rocprofiler
@@ -42,12 +44,26 @@ namespace container
 /// It is thread-safe to have multiple threads emplace records into the buffer.
 struct record_header_buffer
 {
+    /// @brief synchronization strategy used between writers (emplace) and the reader (flush)
+    ///
+    ///  - locked: every emplace takes the exclusive lock around the space reservation and the
+    ///    shared lock while constructing the record. Writers contend on a single mutex.
+    ///  - lock_free: space is reserved via the atomic compare-and-swap in the ring buffer and
+    ///    writers only announce themselves via an in-flight counter. The reader (lock()) raises
+    ///    the lock count and waits for the in-flight writers to drain so emplace never takes a
+    ///    mutex and only spins if it targets a buffer which is actively being read.
+    enum class sync_mode : uint8_t
+    {
+        locked = 0,
+        lock_free,
+    };
+
     using base_buffer_t    = base::ring_buffer;
     using record_vec_t     = std::vector<rocprofiler_record_header_t>;
     using record_ptr_vec_t = std::vector<rocprofiler_record_header_t*>;
 
     record_header_buffer() = default;
-    explicit record_header_buffer(size_t nbytes);
+    explicit record_header_buffer(size_t nbytes, sync_mode _mode = sync_mode::locked);
     ~record_header_buffer() = default;
 
     record_header_buffer(const record_header_buffer&) = delete;
@@ -63,6 +79,12 @@ struct record_header_buffer
     // return whether the buffer has been allocated
     bool is_allocated() const;
 
+    /// set the synchronization strategy. Will return false if the buffer is already allocated
+    bool set_sync_mode(sync_mode);
+
+    /// get the synchronization strategy
+    sync_mode get_sync_mode() const { return m_mode; }
+
     /// place an object in the buffer using its typeid hash code
     template <typename Tp>
     bool emplace(Tp&);
@@ -75,6 +97,13 @@ struct record_header_buffer
     template <typename Tp>
     bool emplace(uint32_t, uint32_t, Tp&);
 
+    /// place a range of objects in the buffer using the specified numerical identifier. The space
+    /// for the objects is reserved with a single request and their headers are published together.
+    /// Returns the number of objects placed, which is less than the size of the range when the
+    /// buffer only has room for the leading objects of the range
+    template <typename Tp>
+    size_t emplace_range(uint32_t, uint32_t, const Tp*, size_t);
+
     /// this function will return a vector of pointers to the record headers
     /// at the time of invocation.
     record_ptr_vec_t get_record_headers(size_t _n = std::numeric_limits<size_t>::max());
@@ -133,7 +162,21 @@ private:
     /// this is an explicit write unlock that does not guard against deadlocking like unlock()
     void write_unlock();
 
+    /// reserve space for a record and register the calling thread as a writer.
+    /// Every invocation must be paired with end_write(), even if nullptr is returned
+    void* begin_write(size_t);
+
+    /// reserve contiguous space for up to the given number of records of the given size and
+    /// register the calling thread as a writer. The number of records is updated to the number
+    /// of records which the reserved space holds (zero if nullptr is returned).
+    /// Every invocation must be paired with end_write(), even if nullptr is returned
+    void* begin_write(size_t, size_t&);
+
+    /// unregister the calling thread as a writer
+    void end_write();
+
 private:
+    sync_mode            m_mode      = sync_mode::locked;
     std::atomic<int64_t> m_requested = {0};
     std::atomic<int64_t> m_locked    = {0};
     std::atomic<size_t>  m_index     = {};
@@ -151,8 +194,16 @@ record_header_buffer::is_locked() const
 inline void
 record_header_buffer::lock()
 {
-    auto n = m_locked.fetch_add(1, std::memory_order_release);
+    auto n = m_locked.fetch_add(1, std::memory_order_seq_cst);
     if(n == 0) write_lock();
+
+    // in lock-free mode, emplace does not hold the shared lock while writing so wait for
+    // any writers which registered before the lock count was raised
+    if(m_mode == sync_mode::lock_free)
+    {
+        while(m_requested.load(std::memory_order_seq_cst) > 0)
+            std::this_thread::yield();
+    }
 }
 
 inline void
@@ -192,6 +243,65 @@ record_header_buffer::is_allocated() const
     return m_buffer.is_initialized();
 }
 
+inline void*
+record_header_buffer::begin_write(size_t request_size)
+{
+    size_t _n = 1;
+    return begin_write(request_size, _n);
+}
+
+inline void*
+record_header_buffer::begin_write(size_t record_size, size_t& num_records)
+{
+    // request the space for as many of the records as the buffer has room for
+    auto _request = [this, record_size, &num_records]() -> void* {
+        while(num_records > 0)
+        {
+            if(auto* _addr = m_buffer.request(num_records * record_size, false)) return _addr;
+            num_records = std::min(num_records - 1, m_buffer.free() / record_size);
+        }
+        return nullptr;
+    };
+
+    if(m_mode == sync_mode::lock_free)
+    {
+        // announce the request and then verify that a reader did not acquire the lock
+        // in between. If it did, back off until the read completes.
+        while(true)
+        {
+            while(is_locked())
+                std::this_thread::yield();
+
+            m_requested.fetch_add(1, std::memory_order_seq_cst);
+            if(m_locked.load(std::memory_order_seq_cst) == 0) break;
+            m_requested.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        return _request();
+    }
+
+    // notify there was a request
+    m_requested.fetch_add(1);
+
+    // in theory, we shouldn't need to lock here but the thread sanitizer says there is a race.
+    // the lock will be short-lived so hopefully, it will scale fine
+    write_lock();
+    auto* _addr = _request();
+    write_unlock();
+
+    read_lock();
+    return _addr;
+}
+
+inline void
+record_header_buffer::end_write()
+{
+    if(m_mode == sync_mode::locked) read_unlock();
+
+    // remove notification of request
+    m_requested.fetch_sub(1, std::memory_order_seq_cst);
+}
+
 inline auto
 record_header_buffer::size() const
 {
@@ -236,16 +346,7 @@ record_header_buffer::emplace(uint64_t _hash, Tp& _v)
 
     constexpr auto request_size = sizeof(Tp);
 
-    // notify there was a request
-    m_requested.fetch_add(1);
-
-    // in theory, we shouldn't need to lock here but the thread sanitizer says there is a race.
-    // the lock will be short-lived so hopefully, it will scale fine
-    write_lock();
-    auto* _addr = m_buffer.request(request_size, false);
-    write_unlock();
-
-    read_lock();
+    auto* _addr = begin_write(request_size);
     if(_addr)
     {
         // if there is space in the buffer, atomically get an index
@@ -262,10 +363,7 @@ record_header_buffer::emplace(uint64_t _hash, Tp& _v)
         record.payload    = _addr;
         m_headers.at(idx) = record;
     }
-    read_unlock();
-
-    // remove notification of request
-    m_requested.fetch_sub(1);
+    end_write();
 
     return (_addr != nullptr);
 }
@@ -278,16 +376,7 @@ record_header_buffer::emplace(uint32_t _category, uint32_t _kind, Tp& _v)
 
     constexpr auto request_size = sizeof(Tp);
 
-    // notify there was a request
-    m_requested.fetch_add(1);
-
-    // in theory, we shouldn't need to lock here but the thread sanitizer says there is a race.
-    // the lock will be short-lived so hopefully, it will scale fine
-    write_lock();
-    auto* _addr = m_buffer.request(request_size, false);
-    write_unlock();
-
-    read_lock();
+    auto* _addr = begin_write(request_size);
     if(_addr)
     {
         // if there is space in the buffer, atomically get an index
@@ -305,14 +394,40 @@ record_header_buffer::emplace(uint32_t _category, uint32_t _kind, Tp& _v)
         record.payload    = _addr;
         m_headers.at(idx) = record;
     }
-    read_unlock();
-
-    // remove notification of request
-    m_requested.fetch_sub(1);
+    end_write();
 
     return (_addr != nullptr);
 }
 
+template <typename Tp>
+size_t
+record_header_buffer::emplace_range(uint32_t _category, uint32_t _kind, const Tp* _v, size_t _n)
+{
+    if(m_headers.empty() || _n == 0) return 0;
+
+    auto* _addr = static_cast<Tp*>(begin_write(sizeof(Tp), _n));
+    if(_addr)
+    {
+        // a single index reservation for the headers of all the records
+        auto idx = m_index.fetch_add(_n, std::memory_order_release);
+
+        for(size_t i = 0; i < _n; ++i)
+        {
+            // placement new
+            new(_addr + i) Tp{_v[i]};
+
+            auto record           = rocprofiler_record_header_t{};
+            record.category       = _category;
+            record.kind           = _kind;
+            record.payload        = _addr + i;
+            m_headers.at(idx + i) = record;
+        }
+    }
+    end_write();
+
+    return _n;
+}
+
 template <typename Tp>
 bool
 record_header_buffer::emplace(Tp& _v)
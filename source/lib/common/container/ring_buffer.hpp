@@ -323,9 +323,23 @@ struct ring_buffer : private base::ring_buffer
     /// Get an uninitialized address at tail of buffer.
     Tp* request(bool wrap = true) { return base_type::request<Tp>(wrap); }
 
+    /// Get an uninitialized address at tail of buffer for \param n contiguous instances.
+    Tp* request(size_t n, bool wrap)
+    {
+        return static_cast<Tp*>(base_type::request(n * sizeof(Tp), wrap));
+    }
+
     /// Read data from head of buffer.
     Tp* retrieve() { return base_type::retrieve<Tp>(); }
 
+    /// Pointer to the head of buffer without advancing the read pointer. The instances are only
+    /// contiguous from the head when the writes never wrapped around, e.g. request(false).
+    const Tp* peek() const
+    {
+        if(!is_initialized()) return nullptr;
+        return static_cast<const Tp*>(base_type::read_ptr(base_type::m_read_count.load()));
+    }
+
     /// Returns number of Tp instances currently held by the buffer.
     size_t count() const { return (base_type::count()) / sizeof(Tp); }
 
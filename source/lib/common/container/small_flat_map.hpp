@@ -0,0 +1,139 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "lib/common/container/small_vector.hpp"
+#include "lib/common/defines.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+/// @brief Associative container with an (unordered) linear layout on top of a small_vector.
+/// Intended for maps which are constructed frequently (e.g. once per traced API call) and nearly
+/// always contain only a few entries: up to N entries are stored inline without any heap
+/// allocation and lookups are a linear scan which, for a handful of entries, is cheaper than
+/// hashing. Beyond N entries, the storage falls back to the heap like small_vector.
+/// Iterators are invalidated by insertion.
+template <typename KeyT, typename MappedT, size_t N>
+struct small_flat_map
+{
+    using key_type       = KeyT;
+    using mapped_type    = MappedT;
+    using value_type     = std::pair<KeyT, MappedT>;
+    using container_type = small_vector<value_type, N>;
+    using iterator       = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    small_flat_map()                          = default;
+    ~small_flat_map()                         = default;
+    small_flat_map(const small_flat_map&)     = default;
+    small_flat_map(small_flat_map&&) noexcept = default;
+    small_flat_map& operator=(const small_flat_map&) = default;
+    small_flat_map& operator=(small_flat_map&&) noexcept = default;
+
+    /// inserts the value if the key does not exist. Does not overwrite an existing value
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const key_type& _key, Args&&... _args);
+
+    iterator       find(const key_type& _key);
+    const_iterator find(const key_type& _key) const;
+
+    mapped_type&       at(const key_type& _key);
+    const mapped_type& at(const key_type& _key) const;
+
+    mapped_type& operator[](const key_type& _key) { return emplace(_key).first->second; }
+
+    size_t count(const key_type& _key) const { return (find(_key) != end()) ? 1 : 0; }
+
+    void   clear() { m_data.clear(); }
+    void   reserve(size_t _n) { m_data.reserve(_n); }
+    size_t size() const { return m_data.size(); }
+    bool   empty() const { return m_data.empty(); }
+
+    iterator       begin() { return m_data.begin(); }
+    const_iterator begin() const { return m_data.begin(); }
+    iterator       end() { return m_data.end(); }
+    const_iterator end() const { return m_data.end(); }
+
+private:
+    container_type m_data = {};
+};
+
+template <typename KeyT, typename MappedT, size_t N>
+template <typename... Args>
+std::pair<typename small_flat_map<KeyT, MappedT, N>::iterator, bool>
+small_flat_map<KeyT, MappedT, N>::emplace(const key_type& _key, Args&&... _args)
+{
+    if(auto itr = find(_key); itr != end()) return {itr, false};
+
+    m_data.emplace_back(_key, mapped_type{std::forward<Args>(_args)...});
+    return {std::prev(m_data.end()), true};
+}
+
+template <typename KeyT, typename MappedT, size_t N>
+typename small_flat_map<KeyT, MappedT, N>::iterator
+small_flat_map<KeyT, MappedT, N>::find(const key_type& _key)
+{
+    for(auto itr = m_data.begin(); itr != m_data.end(); ++itr)
+        if(itr->first == _key) return itr;
+    return m_data.end();
+}
+
+template <typename KeyT, typename MappedT, size_t N>
+typename small_flat_map<KeyT, MappedT, N>::const_iterator
+small_flat_map<KeyT, MappedT, N>::find(const key_type& _key) const
+{
+    for(auto itr = m_data.begin(); itr != m_data.end(); ++itr)
+        if(itr->first == _key) return itr;
+    return m_data.end();
+}
+
+template <typename KeyT, typename MappedT, size_t N>
+typename small_flat_map<KeyT, MappedT, N>::mapped_type&
+small_flat_map<KeyT, MappedT, N>::at(const key_type& _key)
+{
+    auto itr = find(_key);
+    if(ROCPROFILER_UNLIKELY(itr == end()))
+        throw std::out_of_range{"small_flat_map::at(key) :: key does not exist"};
+    return itr->second;
+}
+
+template <typename KeyT, typename MappedT, size_t N>
+const typename small_flat_map<KeyT, MappedT, N>::mapped_type&
+small_flat_map<KeyT, MappedT, N>::at(const key_type& _key) const
+{
+    auto itr = find(_key);
+    if(ROCPROFILER_UNLIKELY(itr == end()))
+        throw std::out_of_range{"small_flat_map::at(key) :: key does not exist"};
+    return itr->second;
+}
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "lib/common/defines.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+/// @brief Single-producer/single-consumer queue made of a linked list of fixed-size segments.
+/// push() never blocks and never waits for the consumer: when the current segment is full, the
+/// producer links a new segment. The consumer releases a segment once it has consumed all of its
+/// elements and the producer has moved on to the next segment.
+///
+/// The queue is unbounded unless a maximum number of segments is provided. The capacity is not
+/// enforced by push(): the producer checks full() and has the queue consumed before pushing.
+///
+/// push()/full() may only be invoked by one thread at a time and consume()/empty() may only be
+/// invoked by one thread at a time.
+template <typename Tp, size_t SegmentBytes = (64 * 1024)>
+class spsc_queue
+{
+public:
+    using value_type = Tp;
+
+    static constexpr size_t segment_size = std::max<size_t>(SegmentBytes / sizeof(Tp), 1);
+
+    /// @param max_segments maximum number of segments (0 for unbounded, at least 2 otherwise)
+    explicit spsc_queue(size_t max_segments = 0);
+    ~spsc_queue();
+
+    spsc_queue(const spsc_queue&)     = delete;
+    spsc_queue(spsc_queue&&) noexcept = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+    spsc_queue& operator=(spsc_queue&&) noexcept = delete;
+
+    /// producer: appends the value. Returns true if a new segment had to be allocated
+    bool push(Tp&& _v);
+    bool push(const Tp& _v) { return push(Tp{_v}); }
+
+    /// producer: whether the next push would exceed the maximum number of segments
+    bool full() const;
+
+    /// consumer: invokes the function with every element published so far (in order) and
+    /// returns the number of consumed elements
+    template <typename FuncT>
+    size_t consume(FuncT&& _func);
+
+    /// consumer: whether all the elements published so far have been consumed
+    bool empty() const;
+
+private:
+    struct segment
+    {
+        std::array<Tp, segment_size> data = {};
+        std::atomic<size_t>          size = {0};
+        std::atomic<segment*>        next = {nullptr};
+    };
+
+    // producer state and consumer state are kept on separate cache lines
+    alignas(64) segment* m_tail         = nullptr;
+    size_t               m_max_segments = 0;
+    alignas(64) segment* m_head         = nullptr;
+    size_t               m_read         = 0;
+    std::atomic<size_t>  m_segments     = {1};  // allocated by the producer, freed by the consumer
+};
+
+template <typename Tp, size_t SegmentBytes>
+spsc_queue<Tp, SegmentBytes>::spsc_queue(size_t max_segments)
+: m_tail{new segment{}}
+, m_max_segments{(max_segments == 0) ? 0 : std::max<size_t>(max_segments, 2)}
+, m_head{m_tail}
+{}
+
+template <typename Tp, size_t SegmentBytes>
+spsc_queue<Tp, SegmentBytes>::~spsc_queue()
+{
+    while(m_head)
+    {
+        auto* _next = m_head->next.load(std::memory_order_relaxed);
+        delete m_head;
+        m_head = _next;
+    }
+}
+
+template <typename Tp, size_t SegmentBytes>
+bool
+spsc_queue<Tp, SegmentBytes>::push(Tp&& _v)
+{
+    bool _grown = false;
+    auto _idx   = m_tail->size.load(std::memory_order_relaxed);
+    if(ROCPROFILER_UNLIKELY(_idx == segment_size))
+    {
+        auto* _segment = new segment{};
+        m_segments.fetch_add(1, std::memory_order_relaxed);
+        m_tail->next.store(_segment, std::memory_order_release);
+        m_tail = _segment;
+        _idx   = 0;
+        _grown = true;
+    }
+
+    m_tail->data[_idx] = std::move(_v);
+    m_tail->size.store(_idx + 1, std::memory_order_release);
+    return _grown;
+}
+
+template <typename Tp, size_t SegmentBytes>
+template <typename FuncT>
+size_t
+spsc_queue<Tp, SegmentBytes>::consume(FuncT&& _func)
+{
+    size_t _count = 0;
+    while(true)
+    {
+        auto _size = m_head->size.load(std::memory_order_acquire);
+        for(; m_read < _size; ++m_read, ++_count)
+            _func(m_head->data[m_read]);
+
+        // the producer may still append to a segment which is not full
+        if(m_read < segment_size) break;
+
+        auto* _next = m_head->next.load(std::memory_order_acquire);
+        if(!_next) break;
+
+        delete m_head;
+        m_head = _next;
+        m_read = 0;
+        m_segments.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return _count;
+}
+
+template <typename Tp, size_t SegmentBytes>
+bool
+spsc_queue<Tp, SegmentBytes>::full() const
+{
+    return (m_max_segments > 0 &&
+            m_tail->size.load(std::memory_order_relaxed) == segment_size &&
+            m_segments.load(std::memory_order_relaxed) >= m_max_segments);
+}
+
+template <typename Tp, size_t SegmentBytes>
+bool
+spsc_queue<Tp, SegmentBytes>::empty() const
+{
+    if(m_read < m_head->size.load(std::memory_order_acquire)) return false;
+    auto* _next = m_head->next.load(std::memory_order_acquire);
+    return (_next == nullptr || _next->size.load(std::memory_order_acquire) == 0);
+}
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
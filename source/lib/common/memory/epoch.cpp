@@ -0,0 +1,161 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/memory/epoch.hpp"
+#include "lib/common/defines.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace memory
+{
+/// @brief announces the epoch (possibly) being read by a thread. An epoch of zero means the
+/// thread does not hold an epoch_guard.
+struct epoch_reader
+{
+    std::atomic<uint64_t> epoch  = {0};
+    std::atomic<bool>     in_use = {false};
+    uint32_t              depth  = 0;  // only accessed by the thread using the reader
+    epoch_reader*         next   = nullptr;
+};
+
+namespace
+{
+// starts at one since an epoch of zero is reserved for readers which are not in a guard
+auto&
+get_global_epoch()
+{
+    static auto _v = std::atomic<uint64_t>{1};
+    return _v;
+}
+
+// list of all the readers. Readers are never deleted: when a thread exits, its reader is marked
+// as unused and adopted by the next thread which needs one
+auto&
+get_epoch_readers()
+{
+    static auto _v = std::atomic<epoch_reader*>{nullptr};
+    return _v;
+}
+
+epoch_reader*
+acquire_epoch_reader()
+{
+    auto& _readers = get_epoch_readers();
+    for(auto* itr = _readers.load(std::memory_order_acquire); itr; itr = itr->next)
+    {
+        auto _expected = false;
+        if(!itr->in_use.load(std::memory_order_relaxed) &&
+           itr->in_use.compare_exchange_strong(_expected, true, std::memory_order_acquire))
+            return itr;
+    }
+
+    auto* _reader = new epoch_reader{};
+    _reader->in_use.store(true, std::memory_order_relaxed);
+    _reader->next = _readers.load(std::memory_order_relaxed);
+    while(!_readers.compare_exchange_weak(
+        _reader->next, _reader, std::memory_order_release, std::memory_order_relaxed))
+    {}
+    return _reader;
+}
+
+void
+release_epoch_reader(epoch_reader* _reader)
+{
+    _reader->in_use.store(false, std::memory_order_release);
+}
+
+// set when the thread-local reader has been released during thread-local teardown
+thread_local bool epoch_reader_released = false;
+
+struct epoch_reader_owner
+{
+    epoch_reader_owner()
+    : reader{acquire_epoch_reader()}
+    {}
+
+    ~epoch_reader_owner()
+    {
+        epoch_reader_released = true;
+        release_epoch_reader(reader);
+    }
+
+    epoch_reader* reader = nullptr;
+};
+
+// returns nullptr once the thread-local reader has been destroyed
+epoch_reader*
+get_epoch_reader()
+{
+    if(epoch_reader_released) return nullptr;
+
+    static thread_local auto _v = epoch_reader_owner{};
+    return _v.reader;
+}
+}  // namespace
+
+epoch_guard::epoch_guard()
+: m_reader{get_epoch_reader()}
+{
+    // during thread-local teardown, use a reader which is only held by this guard
+    if(ROCPROFILER_UNLIKELY(!m_reader))
+    {
+        m_reader    = acquire_epoch_reader();
+        m_transient = true;
+    }
+
+    // nested guards are covered by the epoch announced by the outermost guard
+    if(m_reader->depth++ == 0) m_reader->epoch.store(get_global_epoch().load());
+}
+
+epoch_guard::~epoch_guard()
+{
+    if(--m_reader->depth == 0) m_reader->epoch.store(0, std::memory_order_release);
+    if(m_transient) release_epoch_reader(m_reader);
+}
+
+uint64_t
+advance_epoch()
+{
+    return get_global_epoch().fetch_add(1) + 1;
+}
+
+uint64_t
+get_min_reader_epoch()
+{
+    auto _min_epoch = std::numeric_limits<uint64_t>::max();
+    for(auto* itr = get_epoch_readers().load(std::memory_order_acquire); itr; itr = itr->next)
+    {
+        auto _epoch = itr->epoch.load();
+        if(_epoch > 0) _min_epoch = std::min(_min_epoch, _epoch);
+    }
+    return _min_epoch;
+}
+}  // namespace memory
+}  // namespace common
+}  // namespace rocprofiler
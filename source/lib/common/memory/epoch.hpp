@@ -0,0 +1,128 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace memory
+{
+struct epoch_reader;
+
+/// @brief pins the calling thread to the current epoch for the lifetime of the guard. Objects
+/// retired (see epoch_ptr) while a guard exists are not released until the guard is destroyed so
+/// a guard should only be held for a short operation. Guards may be nested.
+struct epoch_guard
+{
+    epoch_guard();
+    ~epoch_guard();
+
+    epoch_guard(const epoch_guard&)     = delete;
+    epoch_guard(epoch_guard&&) noexcept = delete;
+    epoch_guard& operator=(const epoch_guard&) = delete;
+    epoch_guard& operator=(epoch_guard&&) noexcept = delete;
+
+private:
+    epoch_reader* m_reader    = nullptr;
+    bool          m_transient = false;
+};
+
+/// advances the global epoch and returns the new epoch
+uint64_t
+advance_epoch();
+
+/// returns the oldest epoch announced by a thread holding an epoch_guard (or the max value of
+/// uint64_t if no thread holds a guard)
+uint64_t
+get_min_reader_epoch();
+
+/// @brief atomic pointer to an immutable object which is read without locks. Readers must hold
+/// an epoch_guard while using the loaded pointer. Publishing a new object retires the previous
+/// one, which is released once no reader can still reference it. Reclamation never blocks:
+/// objects still in use are released by a later publish. Publishing must be serialized by the
+/// caller.
+template <typename Tp>
+struct epoch_ptr
+{
+    using value_type = Tp;
+
+    epoch_ptr() = default;
+    ~epoch_ptr() { delete m_value.load(); }
+
+    epoch_ptr(const epoch_ptr&)     = delete;
+    epoch_ptr(epoch_ptr&&) noexcept = delete;
+    epoch_ptr& operator=(const epoch_ptr&) = delete;
+    epoch_ptr& operator=(epoch_ptr&&) noexcept = delete;
+
+    const Tp* load() const { return m_value.load(); }
+    void      publish(std::unique_ptr<const Tp>&& _value);
+    size_t    retired_size() const { return m_retired.size(); }
+
+private:
+    using retired_t = std::pair<uint64_t, std::unique_ptr<const Tp>>;
+
+    void reclaim();
+
+    std::atomic<const Tp*> m_value   = {nullptr};
+    std::vector<retired_t> m_retired = {};
+};
+
+template <typename Tp>
+void
+epoch_ptr<Tp>::publish(std::unique_ptr<const Tp>&& _value)
+{
+    // publish the object before advancing the epoch: a reader which announces the new epoch is
+    // guaranteed to load the new (or a newer) object
+    const auto* _prev  = m_value.exchange(_value.release());
+    auto        _epoch = advance_epoch();
+
+    if(_prev) m_retired.emplace_back(_epoch, std::unique_ptr<const Tp>{_prev});
+
+    reclaim();
+}
+
+template <typename Tp>
+void
+epoch_ptr<Tp>::reclaim()
+{
+    if(m_retired.empty()) return;
+
+    // a retired object is tagged with the epoch which replaced it so it is unreachable once
+    // every reader has announced that epoch (or a newer one)
+    auto _min_epoch = get_min_reader_epoch();
+    auto _itr       = m_retired.begin();
+    while(_itr != m_retired.end() && _itr->first <= _min_epoch)
+        ++_itr;
+    m_retired.erase(m_retired.begin(), _itr);
+}
+}  // namespace memory
+}  // namespace common
+}  // namespace rocprofiler
@@ -0,0 +1,177 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compares instruction lookups of CodeobjAddressTranslate with on-demand disassembly (one comgr
+// call per lookup, serialized by a lock) against lookups into the predecoded instruction table.
+
+#include <gtest/gtest.h>
+#include <rocprofiler-sdk/cxx/codeobj/code_printing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef CODEOBJ_BINARY_DIR
+static_assert(false && "Please define CODEOBJ_BINARY_DIR to codeobj tests binary, "
+                       "e.g. ../source/lib/rocprofiler-sdk-codeobj/tests/");
+#endif
+
+namespace
+{
+namespace disassembly = rocprofiler::sdk::codeobj::disassembly;
+
+using marker_id_t = rocprofiler::sdk::codeobj::segment::marker_id_t;
+using clock_type  = std::chrono::steady_clock;
+
+constexpr uint64_t load_addr      = 0x7f0000000000;
+constexpr size_t   num_iterations = 200;
+constexpr size_t   num_lookups    = 1 << 16;
+
+std::vector<char>
+read_codeobj()
+{
+    std::ifstream file(CODEOBJ_BINARY_DIR "smallkernel.bin", std::ios::binary);
+
+    using iterator_t = std::istreambuf_iterator<char>;
+    return std::vector<char>(iterator_t(file), iterator_t());
+}
+
+// load addresses of every instruction of every symbol, repeated to emulate the unique PCs of
+// a large trace
+std::vector<uint64_t>
+get_pcs(const std::vector<char>& objdata)
+{
+    auto component = disassembly::CodeobjDecoderComponent(objdata.data(), objdata.size());
+    auto table     = component.decode_all();
+    auto pcs       = std::vector<uint64_t>{};
+
+    for(auto& [kaddr, symbol] : component.m_symbol_map)
+    {
+        for(uint64_t vaddr = kaddr; vaddr < kaddr + symbol.mem_size;)
+        {
+            auto view = table->find(vaddr);
+            if(!view) break;
+            pcs.emplace_back(load_addr + vaddr);
+            vaddr += view->size;
+        }
+    }
+
+    auto _v = std::vector<uint64_t>{};
+    while(!pcs.empty() && _v.size() < num_lookups)
+        _v.insert(_v.end(), pcs.begin(), pcs.end());
+    return _v;
+}
+
+template <typename FuncT>
+double
+measure(FuncT&& func)
+{
+    auto _beg = clock_type::now();
+    func();
+    return std::chrono::duration<double>(clock_type::now() - _beg).count();
+}
+}  // namespace
+
+TEST(codeobj_library, decode_benchmark)
+{
+    const auto objdata     = read_codeobj();
+    const auto pcs         = get_pcs(objdata);
+    const auto num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    ASSERT_FALSE(pcs.empty());
+
+    auto _component = disassembly::CodeobjDecoderComponent(objdata.data(), objdata.size());
+    auto _serial    = measure([&]() {
+        for(size_t i = 0; i < num_iterations; ++i)
+            _component.decode_all(1);
+    });
+    auto _parallel  = measure([&]() {
+        for(size_t i = 0; i < num_iterations; ++i)
+            _component.decode_all(num_threads);
+    });
+
+    std::cout << std::fixed << std::setprecision(3) << "decode code object (1 thread):   "
+              << (_serial / num_iterations * 1.0e3) << " msec\n"
+              << "decode code object (" << num_threads
+              << " threads):  " << (_parallel / num_iterations * 1.0e3) << " msec\n";
+
+    auto lazy       = disassembly::CodeobjAddressTranslate{};
+    auto predecoded = disassembly::CodeobjAddressTranslate{};
+    predecoded.enablePredecode(num_threads);
+
+    lazy.addDecoder(objdata.data(), objdata.size(), marker_id_t{1}, load_addr, objdata.size());
+    predecoded.addDecoder(
+        objdata.data(), objdata.size(), marker_id_t{1}, load_addr, objdata.size());
+
+    auto   _mutex = std::shared_mutex{};
+    size_t _nchar = 0;
+
+    // on-demand disassembly mutates the decoder so every lookup takes the exclusive lock
+    auto _lazy = measure([&]() {
+        for(auto pc : pcs)
+        {
+            std::unique_lock<std::shared_mutex> lk(_mutex);
+            _nchar += lazy.get(pc)->inst.size();
+        }
+    });
+
+    auto _view = measure([&]() {
+        for(auto pc : pcs)
+        {
+            std::shared_lock<std::shared_mutex> lk(_mutex);
+            _nchar += predecoded.get_view(pc)->inst.size();
+        }
+    });
+
+    // concurrent lookups only need to be serialized against adding/removing code objects
+    auto _concurrent = measure([&]() {
+        auto _threads = std::vector<std::thread>{};
+        for(size_t t = 0; t < num_threads; ++t)
+        {
+            _threads.emplace_back([&, t]() {
+                for(size_t i = t; i < pcs.size(); i += num_threads)
+                {
+                    std::shared_lock<std::shared_mutex> lk(_mutex);
+                    EXPECT_TRUE(predecoded.get_view(pcs.at(i)).has_value());
+                }
+            });
+        }
+        for(auto& itr : _threads)
+            itr.join();
+    });
+
+    auto _per_lookup = [&](double _sec) { return _sec / pcs.size() * 1.0e9; };
+    std::cout << "on-demand get():                 " << _per_lookup(_lazy) << " nsec/lookup\n"
+              << "predecoded get_view():           " << _per_lookup(_view) << " nsec/lookup\n"
+              << "predecoded get_view() (" << num_threads
+              << " threads): " << _per_lookup(_concurrent) << " nsec/lookup" << std::endl;
+
+    EXPECT_GT(_nchar, 0);
+}
@@ -262,3 +262,84 @@ TEST(codeobj_library, codeobj_table_test)
     ASSERT_EQ(map.removeDecoderbyId(3), true);
     ASSERT_EQ(map.removeDecoderbyId(1), false);
 }
+
+TEST(codeobj_library, predecoded_table_test)
+{
+    using marker_id_t = rocprofiler::sdk::codeobj::segment::marker_id_t;
+
+    const std::vector<char>& objdata = codeobjhelper::GetCodeobjContents();
+    constexpr size_t         laddr1  = 0x1000;
+
+    CodeobjDecoderComponent component(objdata.data(), objdata.size());
+
+    auto serial   = component.decode_all(1);
+    auto parallel = component.decode_all(4);
+    ASSERT_NE(serial->size(), 0);
+    ASSERT_EQ(serial->size(), parallel->size());
+
+    disassembly::CodeobjAddressTranslate lazy;
+    disassembly::CodeobjAddressTranslate predecoded;
+    predecoded.enablePredecode(2);
+
+    lazy.addDecoder((const void*) objdata.data(), objdata.size(), marker_id_t{1}, laddr1, 0x2000);
+    predecoded.addDecoder(
+        (const void*) objdata.data(), objdata.size(), marker_id_t{1}, laddr1, 0x2000);
+
+    // views are only available from predecoded code objects
+    EXPECT_FALSE(lazy.get_view(marker_id_t{1}, 0).has_value());
+
+    size_t num_instructions = 0;
+    for(auto& [kaddr, symbol] : component.m_symbol_map)
+    {
+        size_t vaddr = kaddr;
+        while(vaddr < kaddr + symbol.mem_size)
+        {
+            auto instruction = lazy.get(laddr1 + vaddr);
+            auto copy        = predecoded.get(laddr1 + vaddr);
+            auto view        = predecoded.get_view(laddr1 + vaddr);
+            auto by_id       = predecoded.get_view(marker_id_t{1}, vaddr);
+
+            ASSERT_NE(instruction.get(), nullptr);
+            ASSERT_NE(copy.get(), nullptr);
+            ASSERT_TRUE(view.has_value());
+            ASSERT_TRUE(by_id.has_value());
+
+            EXPECT_EQ(instruction->inst, copy->inst);
+            EXPECT_EQ(instruction->inst, view->inst);
+            EXPECT_EQ(instruction->comment, view->comment);
+            EXPECT_EQ(instruction->size, view->size);
+            EXPECT_EQ(instruction->faddr, view->faddr);
+            EXPECT_EQ(view->ld_addr, laddr1 + vaddr);
+            EXPECT_EQ(by_id->codeobj_id, 1);
+            EXPECT_EQ(serial->find(vaddr)->inst, parallel->find(vaddr)->inst);
+
+            vaddr += instruction->size;
+            num_instructions++;
+        }
+    }
+    EXPECT_EQ(num_instructions, serial->size());
+
+    // addresses missing from the table are decoded on demand, like without predecoding
+    auto decode = [](disassembly::CodeobjAddressTranslate& map, uint64_t addr) {
+        try
+        {
+            auto instruction = map.get(addr);
+            return instruction ? instruction->inst : std::string{"<none>"};
+        } catch(std::exception&)
+        {
+            return std::string{"<error>"};
+        }
+    };
+
+    size_t num_misses = 0;
+    for(auto& [kaddr, symbol] : component.m_symbol_map)
+    {
+        for(size_t vaddr = kaddr + 2; vaddr < kaddr + symbol.mem_size; vaddr += 4)
+        {
+            ASSERT_FALSE(predecoded.get_view(laddr1 + vaddr).has_value());
+            EXPECT_EQ(decode(lazy, laddr1 + vaddr), decode(predecoded, laddr1 + vaddr));
+            num_misses++;
+        }
+    }
+    EXPECT_NE(num_misses, 0);
+}
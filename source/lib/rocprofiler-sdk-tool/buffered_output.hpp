@@ -41,7 +41,8 @@ using stats_data_t = statistics<uint64_t, float_type>;
 template <typename Tp, domain_type DomainT>
 struct buffered_output
 {
-    using ring_buffer_type              = rocprofiler::common::container::ring_buffer<Tp>;
+    using value_type                    = Tp;
+    using ring_buffer_type              = tmp_ring_buffer_t<Tp>;
     static constexpr auto buffer_type_v = DomainT;
 
     explicit buffered_output(bool _enabled);
@@ -58,8 +59,8 @@ struct buffered_output
 
     operator bool() const { return enabled; }
 
-    std::deque<Tp> element_data = {};
-    stats_data_t   stats        = {};
+    tmp_file_view<Tp> element_data = {};
+    stats_data_t      stats        = {};
 
 private:
     bool enabled = false;
@@ -76,7 +77,7 @@ buffered_output<Tp, DomainT>::flush()
 {
     if(!enabled) return;
 
-    flush_tmp_buffer<ring_buffer_type>(buffer_type_v);
+    flush_tmp_buffer<Tp>(buffer_type_v);
 }
 
 template <typename Tp, domain_type DomainT>
@@ -87,7 +88,7 @@ buffered_output<Tp, DomainT>::read()
 
     flush();
 
-    element_data = get_buffer_elements(read_tmp_file<ring_buffer_type>(buffer_type_v));
+    element_data = read_tmp_file<Tp>(buffer_type_v);
 }
 
 template <typename Tp, domain_type DomainT>
@@ -106,6 +107,7 @@ buffered_output<Tp, DomainT>::destroy()
     if(!enabled) return;
 
     clear();
+    get_tmp_file_drainer().remove(buffer_type_v);
     auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<ring_buffer_type>(buffer_type_v);
     _tmp_buf->destroy();
     delete _tmp_buf;
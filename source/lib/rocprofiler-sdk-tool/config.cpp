@@ -44,6 +44,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace rocprofiler
@@ -276,6 +277,13 @@ config::config()
     }
     if(kernel_filter_include.empty()) kernel_filter_include = std::string(".*");
 
+    // the output tasks are bound by the formatting of the records: more threads than the number
+    // of independent outputs (domains and formats) would mostly be idle
+    constexpr size_t max_default_output_threads = 16;
+    if(output_threads == 0)
+        output_threads = std::clamp<size_t>(
+            std::thread::hardware_concurrency(), 1, max_default_output_threads);
+
     const auto supported_perfetto_backends = std::set<std::string_view>{"inprocess", "system"};
     LOG_IF(FATAL, supported_perfetto_backends.count(perfetto_backend) == 0)
         << "Unsupported perfetto backend type: " << perfetto_backend;
@@ -79,10 +79,12 @@ struct config
     bool        pftrace_output              = false;
     bool        otf2_output                 = false;
     bool        kernel_rename               = get_env("ROCPROF_KERNEL_RENAME", false);
+    bool        streaming_output            = get_env("ROCPROF_STREAMING_OUTPUT", false);
     int         mpi_size                    = get_mpi_size();
     int         mpi_rank                    = get_mpi_rank();
     size_t      perfetto_shmem_size_hint    = get_env("ROCPROF_PERFETTO_SHMEM_SIZE_HINT_KB", 64);
     size_t      perfetto_buffer_size        = get_env("ROCPROF_PERFETTO_BUFFER_SIZE_KB", 1024000);
+    size_t      output_threads              = get_env("ROCPROF_OUTPUT_THREADS", 0);
     std::string output_path   = get_env("ROCPROF_OUTPUT_PATH", fs::current_path().string());
     std::string output_file   = get_env("ROCPROF_OUTPUT_FILE_NAME", std::to_string(getpid()));
     std::string tmp_directory = get_env("ROCPROF_TMPDIR", output_path);
@@ -24,12 +24,16 @@
 
 #include "lib/common/mpl.hpp"
 
+#include <fmt/format.h>
+
 #include <array>
 #include <cstddef>
 #include <iomanip>
 #include <ios>
+#include <iterator>
 #include <ostream>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 
 namespace rocprofiler
@@ -58,6 +62,54 @@ struct numerical_formatter
     }
 };
 
+using csv_buffer_t = fmt::memory_buffer;
+
+// formats the value into the buffer the same way numerical_formatter formats it into a stream
+template <typename Tp>
+void
+write_csv_value(csv_buffer_t& buf, const Tp& _val)
+{
+    using value_type = common::mpl::unqualified_type_t<Tp>;
+
+    if constexpr(common::mpl::is_string_type<value_type>::value)
+    {
+        auto _str = std::string_view{_val};
+        buf.push_back('"');
+        buf.append(_str.data(), _str.data() + _str.size());
+        buf.push_back('"');
+    }
+    else if constexpr(std::is_floating_point<value_type>::value)
+    {
+        constexpr value_type one = 1;
+        if(_val >= one)
+            fmt::format_to(std::back_inserter(buf), "{:.6f}", _val);
+        else
+            fmt::format_to(std::back_inserter(buf), "{:.8e}", _val);
+    }
+    else if constexpr(std::is_integral<value_type>::value && !std::is_same<value_type, bool>::value)
+    {
+        auto _str = fmt::format_int{_val};
+        buf.append(_str.data(), _str.data() + _str.size());
+    }
+    else
+    {
+        fmt::format_to(std::back_inserter(buf), "{}", _val);
+    }
+}
+
+template <typename TupleT, size_t... Idx>
+void
+write_csv_entry(csv_buffer_t& buf, TupleT&& _data, std::index_sequence<Idx...>)
+{
+    auto _write = [&buf](size_t idx, auto&& _val) {
+        if(idx > 0) buf.push_back(',');
+        write_csv_value(buf, _val);
+    };
+
+    (_write(Idx, std::get<Idx>(_data)), ...);
+    buf.push_back('\n');
+}
+
 template <typename FmtT = numerical_formatter, typename TupleT, size_t... Idx>
 std::ostream&
 write_csv_entry(std::ostream& ofs, TupleT&& _data, std::index_sequence<Idx...>)
@@ -90,6 +142,16 @@ struct csv_encoder
         return csv_encoder<columns>{};
     }
 
+    // formats the row directly into the buffer, e.g. the buffer of an output_file
+    template <typename... Args, std::enable_if_t<sizeof...(Args) == columns, int> = 0>
+    static auto write_row(csv_buffer_t& buf, Args&&... args)
+    {
+        write_csv_entry(buf,
+                        std::forward_as_tuple(std::forward<Args>(args)...),
+                        std::make_index_sequence<columns>{});
+        return csv_encoder<columns>{};
+    }
+
     template <typename FmtT = numerical_formatter, typename Tp, size_t N>
     static auto write_row(std::ostream& ofs, const std::array<Tp, N>& arr)
     {
@@ -23,6 +23,7 @@
 #include "generateCSV.hpp"
 #include "csv.hpp"
 #include "helper.hpp"
+#include "lib/common/container/small_vector.hpp"
 #include "lib/rocprofiler-sdk-tool/config.hpp"
 #include "statistics.hpp"
 
@@ -30,8 +31,12 @@
 #include <rocprofiler-sdk/marker/api_id.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iomanip>
+#include <iterator>
+#include <memory>
 #include <string_view>
 #include <utility>
 
@@ -41,9 +46,6 @@ namespace tool
 {
 namespace
 {
-using stats_data_t = statistics<uint64_t, float_type>;
-using stats_map_t  = std::map<std::string_view, stats_data_t>;
-
 struct percentage
 {
     float_type value = {};
@@ -134,7 +136,7 @@ write_stats(output_file&& ofs, const stats_map_t& data_v)
                                                                               value.get_min(),
                                                                               value.get_max(),
                                                                               value.get_stddev());
-        ofs << _row.str() << std::flush;
+        ofs << _row.str();
     }
 
     return _duration;
@@ -275,385 +277,515 @@ generate_csv(tool_table* /*tool_functions*/, std::vector<rocprofiler_agent_v0_t>
     }
 }
 
-stats_data_t
-generate_csv(tool_table*                                                            tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_kernel_dispatch_record_t>& data)
+namespace
 {
-    if(data.empty()) return stats_data_t{};
+using kernel_dispatch_record_t = rocprofiler_buffer_tracing_kernel_dispatch_record_t;
+using hip_api_record_t         = rocprofiler_buffer_tracing_hip_api_record_t;
+using hsa_api_record_t         = rocprofiler_buffer_tracing_hsa_api_record_t;
+using memory_copy_record_t     = rocprofiler_buffer_tracing_memory_copy_record_t;
+using marker_api_record_t      = rocprofiler_buffer_tracing_marker_api_record_t;
+using counter_record_t         = rocprofiler_tool_counter_collection_record_t;
+using scratch_memory_record_t  = rocprofiler_buffer_tracing_scratch_memory_record_t;
+
+template <typename Tp>
+struct type_identity
+{
+    using type = Tp;
+};
 
-    auto kernel_stats = stats_map_t{};
-    auto ofs          = tool::output_file{"kernel_trace",
-                                 tool::csv::kernel_trace_csv_encoder{},
-                                 {"Kind",
-                                  "Agent_Id",
-                                  "Queue_Id",
-                                  "Thread_Id",
-                                  "Dispatch_Id",
-                                  "Kernel_Id",
-                                  "Kernel_Name",
-                                  "Correlation_Id",
-                                  "Start_Timestamp",
-                                  "End_Timestamp",
-                                  "Private_Segment_Size",
-                                  "Group_Segment_Size",
-                                  "Workgroup_Size_X",
-                                  "Workgroup_Size_Y",
-                                  "Workgroup_Size_Z",
-                                  "Grid_Size_X",
-                                  "Grid_Size_Y",
-                                  "Grid_Size_Z"}};
+auto
+make_output_file(type_identity<kernel_dispatch_record_t>)
+{
+    return std::make_unique<tool::output_file>("kernel_trace",
+                                               tool::csv::kernel_trace_csv_encoder{},
+                                               std::array<std::string_view, 18>{
+                                                   "Kind",
+                                                   "Agent_Id",
+                                                   "Queue_Id",
+                                                   "Thread_Id",
+                                                   "Dispatch_Id",
+                                                   "Kernel_Id",
+                                                   "Kernel_Name",
+                                                   "Correlation_Id",
+                                                   "Start_Timestamp",
+                                                   "End_Timestamp",
+                                                   "Private_Segment_Size",
+                                                   "Group_Segment_Size",
+                                                   "Workgroup_Size_X",
+                                                   "Workgroup_Size_Y",
+                                                   "Workgroup_Size_Z",
+                                                   "Grid_Size_X",
+                                                   "Grid_Size_Y",
+                                                   "Grid_Size_Z",
+                                               });
+}
 
-    for(const auto& record : data)
-    {
-        auto row_ss      = std::stringstream{};
-        auto kernel_name = tool_functions->tool_get_kernel_name_fn(
-            record.dispatch_info.kernel_id, record.correlation_id.external.value);
-        rocprofiler::tool::csv::kernel_trace_csv_encoder::write_row(
-            row_ss,
-            tool_functions->tool_get_domain_name_fn(record.kind),
-            tool_functions->tool_get_agent_node_id_fn(record.dispatch_info.agent_id),
-            record.dispatch_info.queue_id.handle,
-            record.thread_id,
-            record.dispatch_info.dispatch_id,
-            record.dispatch_info.kernel_id,
-            kernel_name,
-            record.correlation_id.internal,
-            record.start_timestamp,
-            record.end_timestamp,
-            record.dispatch_info.private_segment_size,
-            record.dispatch_info.group_segment_size,
-            record.dispatch_info.workgroup_size.x,
-            record.dispatch_info.workgroup_size.y,
-            record.dispatch_info.workgroup_size.z,
-            record.dispatch_info.grid_size.x,
-            record.dispatch_info.grid_size.y,
-            record.dispatch_info.grid_size.z);
-
-        if(tool::get_config().stats)
-            kernel_stats[kernel_name] += (record.end_timestamp - record.start_timestamp);
+auto
+make_output_file(type_identity<hip_api_record_t>)
+{
+    return std::make_unique<tool::output_file>("hip_api_trace",
+                                               tool::csv::api_csv_encoder{},
+                                               std::array<std::string_view, 7>{
+                                                   "Domain",
+                                                   "Function",
+                                                   "Process_Id",
+                                                   "Thread_Id",
+                                                   "Correlation_Id",
+                                                   "Start_Timestamp",
+                                                   "End_Timestamp",
+                                               });
+}
 
-        ofs << row_ss.str();
-    }
+auto
+make_output_file(type_identity<hsa_api_record_t>)
+{
+    return std::make_unique<tool::output_file>("hsa_api_trace",
+                                               tool::csv::api_csv_encoder{},
+                                               std::array<std::string_view, 7>{
+                                                   "Domain",
+                                                   "Function",
+                                                   "Process_Id",
+                                                   "Thread_Id",
+                                                   "Correlation_Id",
+                                                   "Start_Timestamp",
+                                                   "End_Timestamp",
+                                               });
+}
 
-    auto _duration = stats_data_t{};
-    if(tool::get_config().stats)
-        _duration = write_stats(get_stats_output_file("kernel_stats"), kernel_stats);
+auto
+make_output_file(type_identity<memory_copy_record_t>)
+{
+    return std::make_unique<tool::output_file>("memory_copy_trace",
+                                               tool::csv::memory_copy_csv_encoder{},
+                                               std::array<std::string_view, 7>{
+                                                   "Kind",
+                                                   "Direction",
+                                                   "Source_Agent_Id",
+                                                   "Destination_Agent_Id",
+                                                   "Correlation_Id",
+                                                   "Start_Timestamp",
+                                                   "End_Timestamp",
+                                               });
+}
 
-    return _duration;
+auto
+make_output_file(type_identity<marker_api_record_t>)
+{
+    return std::make_unique<tool::output_file>("marker_api_trace",
+                                               tool::csv::marker_csv_encoder{},
+                                               std::array<std::string_view, 7>{
+                                                   "Domain",
+                                                   "Function",
+                                                   "Process_Id",
+                                                   "Thread_Id",
+                                                   "Correlation_Id",
+                                                   "Start_Timestamp",
+                                                   "End_Timestamp",
+                                               });
 }
 
-stats_data_t
-generate_csv(tool_table*                                                    tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_hip_api_record_t>& data)
+auto
+make_output_file(type_identity<counter_record_t>)
 {
-    if(data.empty()) return stats_data_t{};
+    return std::make_unique<tool::output_file>("counter_collection",
+                                               tool::csv::counter_collection_csv_encoder{},
+                                               std::array<std::string_view, 16>{
+                                                   "Correlation_Id",
+                                                   "Dispatch_Id",
+                                                   "Agent_Id",
+                                                   "Queue_Id",
+                                                   "Process_Id",
+                                                   "Thread_Id",
+                                                   "Grid_Size",
+                                                   "Kernel_Id",
+                                                   "Kernel_Name",
+                                                   "Workgroup_Size",
+                                                   "LDS_Block_Size",
+                                                   "Scratch_Size",
+                                                   "VGPR_Count",
+                                                   "SGPR_Count",
+                                                   "Counter_Name",
+                                                   "Counter_Value",
+                                               });
+}
 
-    auto hip_stats = stats_map_t{};
-    auto ofs       = tool::output_file{"hip_api_trace",
-                                 tool::csv::api_csv_encoder{},
-                                 {"Domain",
-                                  "Function",
-                                  "Process_Id",
-                                  "Thread_Id",
-                                  "Correlation_Id",
-                                  "Start_Timestamp",
-                                  "End_Timestamp"}};
-    for(const auto& record : data)
-    {
-        auto row_ss   = std::stringstream{};
-        auto api_name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
-        rocprofiler::tool::csv::api_csv_encoder::write_row(
-            row_ss,
-            tool_functions->tool_get_domain_name_fn(record.kind),
-            api_name,
-            getpid(),
-            record.thread_id,
-            record.correlation_id.internal,
-            record.start_timestamp,
-            record.end_timestamp);
+auto
+make_output_file(type_identity<scratch_memory_record_t>)
+{
+    return std::make_unique<tool::output_file>("scratch_memory_trace",
+                                               tool::csv::scratch_memory_encoder{},
+                                               std::array<std::string_view, 8>{
+                                                   "Kind",
+                                                   "Operation",
+                                                   "Agent_Id",
+                                                   "Queue_Id",
+                                                   "Thread_Id",
+                                                   "Alloc_flags",
+                                                   "Start_Timestamp",
+                                                   "End_Timestamp",
+                                               });
+}
 
-        if(tool::get_config().stats)
-            hip_stats[api_name] += (record.end_timestamp - record.start_timestamp);
+// name of the statistics output file for each record type. Empty if the record type does not
+// contribute statistics
+constexpr std::string_view
+get_stats_name(type_identity<kernel_dispatch_record_t>)
+{
+    return "kernel_stats";
+}
 
-        ofs << row_ss.str();
-    }
+constexpr std::string_view
+get_stats_name(type_identity<hip_api_record_t>)
+{
+    return "hip_stats";
+}
 
-    auto _duration = stats_data_t{};
-    if(tool::get_config().stats)
-    {
-        _duration = write_stats(get_stats_output_file("hip_stats"), hip_stats);
-    }
-    return _duration;
+constexpr std::string_view
+get_stats_name(type_identity<hsa_api_record_t>)
+{
+    return "hsa_stats";
 }
 
-stats_data_t
-generate_csv(tool_table*                                                    tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>& data)
+constexpr std::string_view
+get_stats_name(type_identity<memory_copy_record_t>)
 {
-    if(data.empty()) return stats_data_t{};
+    return "memory_copy_stats";
+}
 
-    auto hsa_stats = stats_map_t{};
-    auto ofs       = tool::output_file{"hsa_api_trace",
-                                 tool::csv::api_csv_encoder{},
-                                 {"Domain",
-                                  "Function",
-                                  "Process_Id",
-                                  "Thread_Id",
-                                  "Correlation_Id",
-                                  "Start_Timestamp",
-                                  "End_Timestamp"}};
+constexpr std::string_view
+get_stats_name(type_identity<marker_api_record_t>)
+{
+    return "marker_stats";
+}
 
-    for(const auto& record : data)
-    {
-        auto row_ss   = std::stringstream{};
-        auto api_name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
-        rocprofiler::tool::csv::api_csv_encoder::write_row(
-            row_ss,
-            tool_functions->tool_get_domain_name_fn(record.kind),
-            api_name,
-            getpid(),
-            record.thread_id,
-            record.correlation_id.internal,
-            record.start_timestamp,
-            record.end_timestamp);
+constexpr std::string_view
+get_stats_name(type_identity<counter_record_t>)
+{
+    return std::string_view{};
+}
 
-        if(tool::get_config().stats)
-            hsa_stats[api_name] += (record.end_timestamp - record.start_timestamp);
+constexpr std::string_view
+get_stats_name(type_identity<scratch_memory_record_t>)
+{
+    return "scratch_memory_stats";
+}
 
-        ofs << row_ss.str();
-    }
+void
+write_row(tool_table*                     tool_functions,
+          tool::output_file&              ofs,
+          stats_map_t*                    stats,
+          const kernel_dispatch_record_t& record)
+{
+    auto kernel_name = tool_functions->tool_get_kernel_name_fn(
+        record.dispatch_info.kernel_id, record.correlation_id.external.value);
+    ofs.write_row<tool::csv::kernel_trace_csv_encoder>(
+        tool_functions->tool_get_domain_name_fn(record.kind),
+        tool_functions->tool_get_agent_node_id_fn(record.dispatch_info.agent_id),
+        record.dispatch_info.queue_id.handle,
+        record.thread_id,
+        record.dispatch_info.dispatch_id,
+        record.dispatch_info.kernel_id,
+        kernel_name,
+        record.correlation_id.internal,
+        record.start_timestamp,
+        record.end_timestamp,
+        record.dispatch_info.private_segment_size,
+        record.dispatch_info.group_segment_size,
+        record.dispatch_info.workgroup_size.x,
+        record.dispatch_info.workgroup_size.y,
+        record.dispatch_info.workgroup_size.z,
+        record.dispatch_info.grid_size.x,
+        record.dispatch_info.grid_size.y,
+        record.dispatch_info.grid_size.z);
+
+    if(stats) (*stats)[kernel_name] += (record.end_timestamp - record.start_timestamp);
+}
 
-    auto _duration = stats_data_t{};
-    if(tool::get_config().stats)
+template <typename RecordT>
+void
+write_api_row(tool_table*        tool_functions,
+              tool::output_file& ofs,
+              stats_map_t*       stats,
+              const RecordT&     record)
+{
+    auto api_name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
+    ofs.write_row<tool::csv::api_csv_encoder>(
+        tool_functions->tool_get_domain_name_fn(record.kind),
+        api_name,
+        getpid(),
+        record.thread_id,
+        record.correlation_id.internal,
+        record.start_timestamp,
+        record.end_timestamp);
+
+    if(stats) (*stats)[api_name] += (record.end_timestamp - record.start_timestamp);
+}
+
+void
+write_row(tool_table*             tool_functions,
+          tool::output_file&      ofs,
+          stats_map_t*            stats,
+          const hip_api_record_t& record)
+{
+    write_api_row(tool_functions, ofs, stats, record);
+}
+
+void
+write_row(tool_table*             tool_functions,
+          tool::output_file&      ofs,
+          stats_map_t*            stats,
+          const hsa_api_record_t& record)
+{
+    write_api_row(tool_functions, ofs, stats, record);
+}
+
+void
+write_row(tool_table*                 tool_functions,
+          tool::output_file&          ofs,
+          stats_map_t*                stats,
+          const memory_copy_record_t& record)
+{
+    auto api_name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
+    ofs.write_row<tool::csv::memory_copy_csv_encoder>(
+        tool_functions->tool_get_domain_name_fn(record.kind),
+        api_name,
+        tool_functions->tool_get_agent_node_id_fn(record.src_agent_id),
+        tool_functions->tool_get_agent_node_id_fn(record.dst_agent_id),
+        record.correlation_id.internal,
+        record.start_timestamp,
+        record.end_timestamp);
+
+    if(stats) (*stats)[api_name] += (record.end_timestamp - record.start_timestamp);
+}
+
+void
+write_row(tool_table*                tool_functions,
+          tool::output_file&         ofs,
+          stats_map_t*               stats,
+          const marker_api_record_t& record)
+{
+    auto _name = std::string_view{};
+
+    if(record.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_API &&
+       (record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxMarkA ||
+        record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangePushA ||
+        record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangeStartA))
     {
-        _duration = write_stats(get_stats_output_file("hsa_stats"), hsa_stats);
+        _name = tool_functions->tool_get_roctx_msg_fn(record.correlation_id.internal);
     }
-    return _duration;
+    else
+    {
+        _name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
+    }
+
+    ofs.write_row<tool::csv::marker_csv_encoder>(
+        tool_functions->tool_get_domain_name_fn(record.kind),
+        _name,
+        getpid(),
+        record.thread_id,
+        record.correlation_id.internal,
+        record.start_timestamp,
+        record.end_timestamp);
+
+    if(stats) (*stats)[_name] += (record.end_timestamp - record.start_timestamp);
 }
 
-stats_data_t
-generate_csv(tool_table*                                                        tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_memory_copy_record_t>& data)
+void
+write_row(tool_table*        tool_functions,
+          tool::output_file& ofs,
+          stats_map_t*,
+          const counter_record_t& record)
 {
-    if(data.empty()) return stats_data_t{};
+    auto kernel_id = record.dispatch_data.dispatch_info.kernel_id;
 
-    auto memory_copy_stats = stats_map_t{};
-    auto ofs               = tool::output_file{"memory_copy_trace",
-                                 tool::csv::memory_copy_csv_encoder{},
-                                 {"Kind",
-                                  "Direction",
-                                  "Source_Agent_Id",
-                                  "Destination_Agent_Id",
-                                  "Correlation_Id",
-                                  "Start_Timestamp",
-                                  "End_Timestamp"}};
-    for(const auto& record : data)
+    // sum the values of the instances of each counter. The counter name is only looked up once per
+    // counter (from the id of its first instance) and the rows are ordered by counter name
+    struct counter_value
     {
-        auto row_ss   = std::stringstream{};
-        auto api_name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
-        rocprofiler::tool::csv::memory_copy_csv_encoder::write_row(
-            row_ss,
-            tool_functions->tool_get_domain_name_fn(record.kind),
-            api_name,
-            tool_functions->tool_get_agent_node_id_fn(record.src_agent_id),
-            tool_functions->tool_get_agent_node_id_fn(record.dst_agent_id),
-            record.correlation_id.internal,
-            record.start_timestamp,
-            record.end_timestamp);
-
-        if(tool::get_config().stats)
-            memory_copy_stats[api_name] += (record.end_timestamp - record.start_timestamp);
+        uint64_t counter_id = 0;
+        uint64_t record_id  = 0;
+        uint64_t value      = 0;
+    };
 
-        ofs << row_ss.str();
+    auto counter_values = common::container::small_vector<counter_value, 16>{};
+    for(const auto& count : record.records)
+    {
+        auto _id  = count.counter_id.handle;
+        auto _itr = std::find_if(counter_values.begin(),
+                                 counter_values.end(),
+                                 [_id](const auto& itr) { return itr.counter_id == _id; });
+        if(_itr == counter_values.end())
+        {
+            counter_values.emplace_back(counter_value{_id, count.record_counter.id, 0});
+            _itr = std::prev(counter_values.end());
+        }
+        _itr->value = _itr->value + count.record_counter.counter_value;
     }
 
-    auto _duration = stats_data_t{};
-    if(tool::get_config().stats)
+    auto counter_name_value = std::vector<std::pair<std::string, uint64_t>>{};
+    counter_name_value.reserve(counter_values.size());
+    for(const auto& itr : counter_values)
+        counter_name_value.emplace_back(
+            tool_functions->tool_get_counter_info_name_fn(itr.record_id), itr.value);
+    std::sort(counter_name_value.begin(),
+              counter_name_value.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    const auto& correlation_id = record.dispatch_data.correlation_id;
+
+    auto magnitude = [](rocprofiler_dim3_t dims) { return (dims.x * dims.y * dims.z); };
+    auto kernel_name =
+        tool_functions->tool_get_kernel_name_fn(kernel_id, correlation_id.external.value);
+    for(auto& itr : counter_name_value)
     {
-        _duration = write_stats(get_stats_output_file("memory_copy_stats"), memory_copy_stats);
+        ofs.write_row<tool::csv::counter_collection_csv_encoder>(
+            correlation_id.internal,
+            record.dispatch_data.dispatch_info.dispatch_id,
+            tool_functions->tool_get_agent_node_id_fn(record.dispatch_data.dispatch_info.agent_id),
+            record.dispatch_data.dispatch_info.queue_id.handle,
+            getpid(),
+            record.thread_id,
+            magnitude(record.dispatch_data.dispatch_info.grid_size),
+            record.dispatch_data.dispatch_info.kernel_id,
+            kernel_name,
+            magnitude(record.dispatch_data.dispatch_info.workgroup_size),
+            record.lds_block_size_v,
+            record.dispatch_data.dispatch_info.private_segment_size,
+            record.arch_vgpr_count,
+            record.sgpr_count,
+            itr.first,
+            itr.second);
     }
-    return _duration;
 }
 
+void
+write_row(tool_table*                    tool_functions,
+          tool::output_file&             ofs,
+          stats_map_t*                   stats,
+          const scratch_memory_record_t& record)
+{
+    auto kind_name = tool_functions->tool_get_domain_name_fn(record.kind);
+    auto op_name   = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
+
+    ofs.write_row<tool::csv::scratch_memory_encoder>(
+        kind_name,
+        op_name,
+        tool_functions->tool_get_agent_node_id_fn(record.agent_id),
+        record.queue_id.handle,
+        record.thread_id,
+        record.flags,
+        record.start_timestamp,
+        record.end_timestamp);
+
+    if(stats) (*stats)[op_name] += (record.end_timestamp - record.start_timestamp);
+}
+
+template <typename Tp>
 stats_data_t
-generate_csv(tool_table*                                                       tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_marker_api_record_t>& data)
+generate_csv_impl(tool_table* tool_functions, const tmp_file_view<Tp>& data)
 {
     if(data.empty()) return stats_data_t{};
 
-    auto marker_stats = stats_map_t{};
-    auto ofs          = tool::output_file{"marker_api_trace",
-                                 tool::csv::marker_csv_encoder{},
-                                 {"Domain",
-                                  "Function",
-                                  "Process_Id",
-                                  "Thread_Id",
-                                  "Correlation_Id",
-                                  "Start_Timestamp",
-                                  "End_Timestamp"}};
+    auto _writer = csv_writer<Tp>{tool_functions};
     for(const auto& record : data)
-    {
-        auto row_ss = std::stringstream{};
-        auto _name  = std::string_view{};
+        _writer.write(record);
+    return _writer.finalize();
+}
+}  // namespace
 
-        if(record.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_API &&
-           (record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxMarkA ||
-            record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangePushA ||
-            record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangeStartA))
-        {
-            _name = tool_functions->tool_get_roctx_msg_fn(record.correlation_id.internal);
-        }
-        else
-        {
-            _name = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
-        }
+template <typename Tp>
+csv_writer<Tp>::csv_writer(tool_table* tool_functions)
+: m_tool_functions{tool_functions}
+{}
 
-        tool::csv::marker_csv_encoder::write_row(
-            row_ss,
-            tool_functions->tool_get_domain_name_fn(record.kind),
-            _name,
-            getpid(),
-            record.thread_id,
-            record.correlation_id.internal,
-            record.start_timestamp,
-            record.end_timestamp);
+template <typename Tp>
+csv_writer<Tp>::~csv_writer() = default;
 
-        if(tool::get_config().stats)
-            marker_stats[_name] += (record.end_timestamp - record.start_timestamp);
+template <typename Tp>
+void
+csv_writer<Tp>::write(const Tp& record)
+{
+    // the output file is only created once there is a record to write
+    if(!m_ofs) m_ofs = make_output_file(type_identity<Tp>{});
 
-        ofs << row_ss.str();
-    }
+    constexpr auto stats_name = get_stats_name(type_identity<Tp>{});
+    auto*          _stats = (!stats_name.empty() && tool::get_config().stats) ? &m_stats : nullptr;
+
+    write_row(m_tool_functions, *m_ofs, _stats, record);
+}
+
+template <typename Tp>
+stats_data_t
+csv_writer<Tp>::finalize()
+{
+    constexpr auto stats_name = get_stats_name(type_identity<Tp>{});
 
     auto _duration = stats_data_t{};
-    if(tool::get_config().stats)
-    {
-        _duration = write_stats(get_stats_output_file("marker_stats"), marker_stats);
-    }
+    if(m_ofs && !stats_name.empty() && tool::get_config().stats)
+        _duration = write_stats(get_stats_output_file(std::string{stats_name}), m_stats);
+
+    m_ofs.reset();
+    m_stats.clear();
     return _duration;
 }
 
+template class csv_writer<rocprofiler_buffer_tracing_kernel_dispatch_record_t>;
+template class csv_writer<rocprofiler_buffer_tracing_hip_api_record_t>;
+template class csv_writer<rocprofiler_buffer_tracing_hsa_api_record_t>;
+template class csv_writer<rocprofiler_buffer_tracing_memory_copy_record_t>;
+template class csv_writer<rocprofiler_buffer_tracing_marker_api_record_t>;
+template class csv_writer<rocprofiler_tool_counter_collection_record_t>;
+template class csv_writer<rocprofiler_buffer_tracing_scratch_memory_record_t>;
+
 stats_data_t
-generate_csv(tool_table*                                                     tool_functions,
-             const std::deque<rocprofiler_tool_counter_collection_record_t>& data)
+generate_csv(
+    tool_table*                                                               tool_functions,
+    const tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>& data)
 {
-    if(data.empty()) return stats_data_t{};
-
-    auto ofs = tool::output_file{"counter_collection",
-                                 tool::csv::counter_collection_csv_encoder{},
-                                 {"Correlation_Id",
-                                  "Dispatch_Id",
-                                  "Agent_Id",
-                                  "Queue_Id",
-                                  "Process_Id",
-                                  "Thread_Id",
-                                  "Grid_Size",
-                                  "Kernel_Id",
-                                  "Kernel_Name",
-                                  "Workgroup_Size",
-                                  "LDS_Block_Size",
-                                  "Scratch_Size",
-                                  "VGPR_Count",
-                                  "SGPR_Count",
-                                  "Counter_Name",
-                                  "Counter_Value"}};
-    for(const auto& record : data)
-    {
-        auto kernel_id          = record.dispatch_data.dispatch_info.kernel_id;
-        auto counter_name_value = std::map<std::string, uint64_t>{};
-        for(uint64_t i = 0; i < record.counter_count; i++)
-        {
-            const auto& count        = record.records.at(i);
-            auto        rec          = count.record_counter;
-            std::string counter_name = tool_functions->tool_get_counter_info_name_fn(rec.id);
-            auto        search       = counter_name_value.find(counter_name);
-            if(search == counter_name_value.end())
-                counter_name_value.emplace(
-                    std::pair<std::string, uint64_t>{counter_name, rec.counter_value});
-            else
-                search->second = search->second + rec.counter_value;
-        }
+    return generate_csv_impl(tool_functions, data);
+}
 
-        const auto& correlation_id = record.dispatch_data.correlation_id;
+stats_data_t
+generate_csv(tool_table*                                                       tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>& data)
+{
+    return generate_csv_impl(tool_functions, data);
+}
 
-        auto magnitude = [](rocprofiler_dim3_t dims) { return (dims.x * dims.y * dims.z); };
-        auto row_ss    = std::stringstream{};
-        for(auto& itr : counter_name_value)
-        {
-            tool::csv::counter_collection_csv_encoder::write_row(
-                row_ss,
-                correlation_id.internal,
-                record.dispatch_data.dispatch_info.dispatch_id,
-                tool_functions->tool_get_agent_node_id_fn(
-                    record.dispatch_data.dispatch_info.agent_id),
-                record.dispatch_data.dispatch_info.queue_id.handle,
-                getpid(),
-                record.thread_id,
-                magnitude(record.dispatch_data.dispatch_info.grid_size),
-                record.dispatch_data.dispatch_info.kernel_id,
-                tool_functions->tool_get_kernel_name_fn(kernel_id, correlation_id.external.value),
-                magnitude(record.dispatch_data.dispatch_info.workgroup_size),
-                record.lds_block_size_v,
-                record.dispatch_data.dispatch_info.private_segment_size,
-                record.arch_vgpr_count,
-                record.sgpr_count,
-                itr.first,
-                itr.second);
-        }
-        ofs << row_ss.str();
-    }
-    return stats_data_t{};
+stats_data_t
+generate_csv(tool_table*                                                       tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>& data)
+{
+    return generate_csv_impl(tool_functions, data);
 }
 
 stats_data_t
 generate_csv(tool_table*                                                           tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>& data)
+             const tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>& data)
 {
-    if(data.empty()) return stats_data_t{};
-
-    auto ofs = tool::output_file{"scratch_memory_trace",
-                                 tool::csv::scratch_memory_encoder{},
-                                 {
-                                     "Kind",
-                                     "Operation",
-                                     "Agent_Id",
-                                     "Queue_Id",
-                                     "Thread_Id",
-                                     "Alloc_flags",
-                                     "Start_Timestamp",
-                                     "End_Timestamp",
-                                 }};
-
-    auto scratch_memory_stats = stats_map_t{};
-    for(const auto& record : data)
-    {
-        auto row_ss    = std::stringstream{};
-        auto kind_name = tool_functions->tool_get_domain_name_fn(record.kind);
-        auto op_name   = tool_functions->tool_get_operation_name_fn(record.kind, record.operation);
-
-        tool::csv::scratch_memory_encoder::write_row(
-            row_ss,
-            kind_name,
-            op_name,
-            tool_functions->tool_get_agent_node_id_fn(record.agent_id),
-            record.queue_id.handle,
-            record.thread_id,
-            record.flags,
-            record.start_timestamp,
-            record.end_timestamp);
+    return generate_csv_impl(tool_functions, data);
+}
 
-        if(tool::get_config().stats)
-            scratch_memory_stats[op_name] += (record.end_timestamp - record.start_timestamp);
+stats_data_t
+generate_csv(tool_table*                                                          tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>& data)
+{
+    return generate_csv_impl(tool_functions, data);
+}
 
-        ofs << row_ss.str();
-    }
+stats_data_t
+generate_csv(tool_table*                                                        tool_functions,
+             const tmp_file_view<rocprofiler_tool_counter_collection_record_t>& data)
+{
+    return generate_csv_impl(tool_functions, data);
+}
 
-    auto _duration = stats_data_t{};
-    if(tool::get_config().stats)
-    {
-        _duration =
-            write_stats(get_stats_output_file("scratch_memory_stats"), scratch_memory_stats);
-    }
-    return _duration;
+stats_data_t
+generate_csv(
+    tool_table*                                                              tool_functions,
+    const tmp_file_view<rocprofiler_buffer_tracing_scratch_memory_record_t>& data)
+{
+    return generate_csv_impl(tool_functions, data);
 }
 
 void
@@ -691,7 +823,7 @@ generate_csv(tool_table* /*tool_functions*/, std::unordered_map<domain_type, sta
                                                   value.get_min(),
                                                   value.get_max(),
                                                   value.get_stddev());
-        ofs << _row.str() << std::flush;
+        ofs << _row.str();
     }
 }
 }  // namespace tool
@@ -23,47 +23,80 @@
 #pragma once
 
 #include "helper.hpp"
+#include "output_file.hpp"
 #include "statistics.hpp"
+#include "tmp_file_view.hpp"
 
 #include <rocprofiler-sdk/agent.h>
 
+#include <map>
+#include <memory>
+#include <string_view>
+
 namespace rocprofiler
 {
 namespace tool
 {
 using float_type   = double;
 using stats_data_t = statistics<uint64_t, float_type>;
+using stats_map_t  = std::map<std::string_view, stats_data_t>;
+
+/// incrementally writes the CSV rows for one record type and accumulates the statistics of the
+/// records written. The output file is created when the first record is written and the
+/// statistics file is written by finalize(). Instantiated for each buffered record type.
+template <typename Tp>
+class csv_writer
+{
+public:
+    explicit csv_writer(tool_table* tool_functions);
+    ~csv_writer();
+
+    csv_writer(const csv_writer&)     = delete;
+    csv_writer(csv_writer&&) noexcept = delete;
+    csv_writer& operator=(const csv_writer&) = delete;
+    csv_writer& operator=(csv_writer&&) noexcept = delete;
+
+    void         write(const Tp& record);
+    stats_data_t finalize();
+
+private:
+    tool_table*                  m_tool_functions = nullptr;
+    std::unique_ptr<output_file> m_ofs            = {};
+    stats_map_t                  m_stats          = {};
+};
 
 void
 generate_csv(tool_table* tool_functions, std::vector<rocprofiler_agent_v0_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                            tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_kernel_dispatch_record_t>& data);
+generate_csv(
+    tool_table*                                                               tool_functions,
+    const tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                    tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_hip_api_record_t>& data);
+generate_csv(tool_table*                                                       tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                    tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>& data);
+generate_csv(tool_table*                                                       tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                        tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_memory_copy_record_t>& data);
+generate_csv(tool_table*                                                           tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                       tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_marker_api_record_t>& data);
+generate_csv(tool_table*                                                          tool_functions,
+             const tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                     tool_functions,
-             const std::deque<rocprofiler_tool_counter_collection_record_t>& data);
+generate_csv(tool_table*                                                        tool_functions,
+             const tmp_file_view<rocprofiler_tool_counter_collection_record_t>& data);
 
 stats_data_t
-generate_csv(tool_table*                                                           tool_functions,
-             const std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>& data);
+generate_csv(
+    tool_table*                                                              tool_functions,
+    const tmp_file_view<rocprofiler_buffer_tracing_scratch_memory_record_t>& data);
 
 void
 generate_csv(tool_table* tool_functions, std::unordered_map<domain_type, stats_data_t>& data);
@@ -23,23 +23,27 @@
 #pragma once
 
 #include "helper.hpp"
+#include "output_index.hpp"
+#include "tmp_file_view.hpp"
 
 namespace rocprofiler
 {
 namespace tool
 {
 void
-write_json(tool_table*                                                      tool_functions,
-           uint64_t                                                         pid,
-           std::vector<rocprofiler_agent_v0_t>                              agent_data,
-           std::vector<rocprofiler_tool_counter_info_t>                     counter_data,
-           std::deque<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_deque,
-           std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_deque,
-           std::deque<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_deque,
-           std::deque<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_deque,
-           std::deque<rocprofiler_tool_counter_collection_record_t>*       counter_collection_deque,
-           std::deque<rocprofiler_buffer_tracing_marker_api_record_t>*     marker_api_deque,
-           std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>* scratch_memory_deque);
+write_json(
+    tool_table*                                                         tool_functions,
+    uint64_t                                                            pid,
+    std::vector<rocprofiler_agent_v0_t>                                 agent_data,
+    std::vector<rocprofiler_tool_counter_info_t>                        counter_data,
+    const output_index&                                                 index,
+    tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_deque,
+    tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_deque,
+    tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_deque,
+    tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_deque,
+    tmp_file_view<rocprofiler_tool_counter_collection_record_t>*        counter_collection_deque,
+    tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_deque,
+    tmp_file_view<rocprofiler_buffer_tracing_scratch_memory_record_t>*  scratch_memory_deque);
 
 }  // namespace tool
 }  // namespace rocprofiler
@@ -28,6 +28,7 @@
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk-tool/config.hpp"
 #include "output_file.hpp"
+#include "output_index.hpp"
 
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/marker/api_id.h>
@@ -343,32 +344,27 @@ create_attribute_list()
 }  // namespace
 
 void
-write_otf2(tool_table*                                                      tool_functions,
-           uint64_t                                                         pid,
-           const std::vector<rocprofiler_agent_v0_t>&                       agent_data,
-           std::deque<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
-           std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
-           std::deque<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
-           std::deque<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
-           std::deque<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data,
-           std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>* /*scratch_memory_data*/)
+write_otf2(
+    tool_table*                                                         tool_functions,
+    uint64_t                                                            pid,
+    const std::vector<rocprofiler_agent_v0_t>&                          agent_data,
+    const output_index&                                                 index,
+    tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
+    tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
+    tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_scratch_memory_record_t>* /*scratch_memory_data*/)
 {
     namespace sdk = ::rocprofiler::sdk;
 
     setup();
 
-    auto _app_ts    = *tool_functions->tool_get_app_timestamps_fn();
-    auto agents_map = std::unordered_map<rocprofiler_agent_id_t, rocprofiler_agent_t>{};
-    for(auto itr : agent_data)
-        agents_map.emplace(itr.id, itr);
-
-    const auto kernel_sym_data = get_kernel_symbol_data();
-    const auto buffer_names    = sdk::get_buffer_tracing_names();
-    auto       tids            = std::set<rocprofiler_thread_id_t>{};
-    auto agent_thread_ids = std::map<rocprofiler_thread_id_t, std::set<rocprofiler_agent_id_t>>{};
-    auto agent_queue_ids =
-        std::map<rocprofiler_thread_id_t,
-                 std::map<rocprofiler_agent_id_t, std::unordered_set<rocprofiler_queue_id_t>>>{};
+    auto        _app_ts          = *tool_functions->tool_get_app_timestamps_fn();
+    const auto  buffer_names     = sdk::get_buffer_tracing_names();
+    const auto& tids             = index.api_threads;
+    const auto& agent_thread_ids = index.memory_copy_threads;
+    const auto& agent_queue_ids  = index.dispatch_queues;
 
     auto thread_event_info = std::map<rocprofiler_thread_id_t, event_info>{};
     auto agent_memcpy_info =
@@ -377,36 +373,10 @@ write_otf2(tool_table*                                                      tool
         std::map<rocprofiler_thread_id_t,
                  std::map<rocprofiler_agent_id_t, std::map<rocprofiler_queue_id_t, event_info>>>{};
 
-    auto _get_agent = [&agent_data](rocprofiler_agent_id_t _id) -> const rocprofiler_agent_t* {
-        for(const auto& itr : agent_data)
-            if(_id == itr.id) return &itr;
-        return CHECK_NOTNULL(nullptr);
-    };
-
-    auto _get_kernel_sym_data =
-        [&kernel_sym_data](
-            const rocprofiler_kernel_dispatch_info_t& _info) -> const kernel_symbol_data* {
-        for(const auto& kitr : kernel_sym_data)
-            if(kitr.kernel_id == _info.kernel_id) return &kitr;
-        return CHECK_NOTNULL(nullptr);
+    auto _get_agent = [&index](rocprofiler_agent_id_t _id) -> const rocprofiler_agent_t* {
+        return CHECK_NOTNULL(index.get_agent(_id));
     };
 
-    {
-        for(auto itr : *hsa_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *hip_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *marker_api_data)
-            tids.emplace(itr.thread_id);
-
-        for(auto itr : *memory_copy_data)
-            agent_thread_ids[itr.thread_id].emplace(itr.dst_agent_id);
-
-        for(auto itr : *kernel_dispatch_data)
-            agent_queue_ids[itr.thread_id][itr.dispatch_info.agent_id].emplace(
-                itr.dispatch_info.queue_id);
-    }
-
     {
         for(auto itr : tids)
             thread_event_info.emplace(itr, location_base{pid, itr});
@@ -573,11 +543,13 @@ write_otf2(tool_table*                                                      tool
     for(auto itr : *kernel_dispatch_data)
     {
         const auto& info = itr.dispatch_info;
-        const auto* sym  = _get_kernel_sym_data(info);
-        CHECK(sym != nullptr);
+        const auto* sym  = CHECK_NOTNULL(index.get_kernel_symbol(info.kernel_id));
 
-        auto name = tool_functions->tool_get_kernel_name_fn(info.kernel_id,
-                                                            itr.correlation_id.external.value);
+        // only a renamed kernel requires the name to be looked up
+        auto name = (itr.correlation_id.external.value > 0)
+                        ? tool_functions->tool_get_kernel_name_fn(info.kernel_id,
+                                                                  itr.correlation_id.external.value)
+                        : std::string_view{sym->formatted_kernel_name};
         _hash_data.emplace(
             get_hash_id(name),
             region_info{std::string{name}, OTF2_REGION_ROLE_FUNCTION, OTF2_PARADIGM_HIP});
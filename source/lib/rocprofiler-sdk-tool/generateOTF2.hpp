@@ -23,6 +23,8 @@
 #pragma once
 
 #include "helper.hpp"
+#include "output_index.hpp"
+#include "tmp_file_view.hpp"
 
 #include <deque>
 
@@ -31,14 +33,15 @@ namespace rocprofiler
 namespace tool
 {
 void
-write_otf2(tool_table*                                                      tool_functions,
-           uint64_t                                                         pid,
-           const std::vector<rocprofiler_agent_v0_t>&                       agent_data,
-           std::deque<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
-           std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
-           std::deque<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
-           std::deque<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
-           std::deque<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data,
-           std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>*  scratch_memory_data);
+write_otf2(tool_table*                                                         tool_functions,
+           uint64_t                                                            pid,
+           const std::vector<rocprofiler_agent_v0_t>&                          agent_data,
+           const output_index&                                                 index,
+           tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
+           tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
+           tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
+           tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
+           tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data,
+           tmp_file_view<rocprofiler_buffer_tracing_scratch_memory_record_t>*  scratch_memory_data);
 }  // namespace tool
 }  // namespace rocprofiler
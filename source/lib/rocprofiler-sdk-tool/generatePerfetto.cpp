@@ -23,6 +23,7 @@
 #include "generatePerfetto.hpp"
 #include "helper.hpp"
 #include "output_file.hpp"
+#include "output_index.hpp"
 
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk-tool/config.hpp"
@@ -65,19 +66,17 @@ void
 write_perfetto(
     tool_table* tool_functions,
     uint64_t /*pid*/,
-    std::vector<rocprofiler_agent_v0_t>                              agent_data,
-    std::deque<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
-    std::deque<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
-    std::deque<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
-    std::deque<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
-    std::deque<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data,
-    std::deque<rocprofiler_buffer_tracing_scratch_memory_record_t>* /*scratch_memory_data*/)
+    const output_index&                                                 index,
+    tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
+    tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
+    tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_scratch_memory_record_t>* /*scratch_memory_data*/)
 {
     namespace sdk = ::rocprofiler::sdk;
 
-    auto agents_map = std::unordered_map<rocprofiler_agent_id_t, rocprofiler_agent_t>{};
-    for(auto itr : agent_data)
-        agents_map.emplace(itr.id, itr);
+    const auto& agents_map = index.agents;
 
     auto args            = ::perfetto::TracingInitArgs{};
     auto track_event_cfg = ::perfetto::protos::gen::TrackEventConfig{};
@@ -124,13 +123,12 @@ write_perfetto(
     tracing_session->Setup(cfg);
     tracing_session->StartBlocking();
 
-    auto tids             = std::set<rocprofiler_thread_id_t>{};
-    auto demangled        = std::unordered_map<std::string_view, std::string>{};
-    auto agent_thread_ids = std::unordered_map<rocprofiler_agent_id_t, std::set<uint64_t>>{};
-    auto agent_queue_ids =
-        std::unordered_map<rocprofiler_agent_id_t, std::unordered_set<rocprofiler_queue_id_t>>{};
-    auto thread_indexes  = std::unordered_map<rocprofiler_thread_id_t, uint64_t>{};
-    auto kernel_sym_data = get_kernel_symbol_data();
+    using agent_queue_ids_t = std::map<rocprofiler_agent_id_t, std::set<rocprofiler_queue_id_t>>;
+
+    const auto& tids             = index.api_threads;
+    auto        thread_indexes   = std::unordered_map<rocprofiler_thread_id_t, uint64_t>{};
+    auto        agent_thread_ids = std::map<rocprofiler_agent_id_t, std::set<uint64_t>>{};
+    auto        agent_queue_ids  = agent_queue_ids_t{};
 
     auto thread_tracks = std::unordered_map<rocprofiler_thread_id_t, ::perfetto::Track>{};
     auto agent_thread_tracks =
@@ -140,28 +138,17 @@ write_perfetto(
         std::unordered_map<rocprofiler_agent_id_t,
                            std::unordered_map<rocprofiler_queue_id_t, ::perfetto::Track>>{};
 
-    auto _get_agent = [&agent_data](rocprofiler_agent_id_t _id) -> const rocprofiler_agent_t* {
-        for(const auto& itr : agent_data)
-        {
-            if(_id == itr.id) return &itr;
-        }
-        return CHECK_NOTNULL(nullptr);
+    auto _get_agent = [&index](rocprofiler_agent_id_t _id) -> const rocprofiler_agent_t* {
+        return CHECK_NOTNULL(index.get_agent(_id));
     };
 
-    {
-        for(auto itr : *hsa_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *hip_api_data)
-            tids.emplace(itr.thread_id);
-        for(auto itr : *marker_api_data)
-            tids.emplace(itr.thread_id);
-
-        for(auto itr : *memory_copy_data)
-            agent_thread_ids[itr.dst_agent_id].emplace(itr.thread_id);
+    for(const auto& [tid, agents] : index.memory_copy_threads)
+        for(auto agent : agents)
+            agent_thread_ids[agent].emplace(tid);
 
-        for(auto itr : *kernel_dispatch_data)
-            agent_queue_ids[itr.dispatch_info.agent_id].emplace(itr.dispatch_info.queue_id);
-    }
+    for(const auto& [tid, agents] : index.dispatch_queues)
+        for(const auto& [agent, queues] : agents)
+            agent_queue_ids[agent].insert(queues.begin(), queues.end());
 
     uint64_t nthrn = 0;
     for(auto itr : tids)
@@ -369,29 +356,12 @@ write_perfetto(
 
         for(auto itr : *kernel_dispatch_data)
         {
-            const auto&               info = itr.dispatch_info;
-            const kernel_symbol_data* sym  = nullptr;
-            for(const auto& kitr : kernel_sym_data)
-            {
-                if(kitr.kernel_id == info.kernel_id)
-                {
-                    sym = &kitr;
-                    break;
-                }
-            }
-
-            CHECK(sym != nullptr);
-
-            auto  name  = std::string_view{sym->kernel_name};
-            auto& track = agent_queue_tracks.at(info.agent_id).at(info.queue_id);
-
-            if(demangled.find(name) == demangled.end())
-            {
-                demangled.emplace(name, common::cxx_demangle(name));
-            }
+            const auto& info  = itr.dispatch_info;
+            const auto* sym   = CHECK_NOTNULL(index.get_kernel_symbol(info.kernel_id));
+            auto&       track = agent_queue_tracks.at(info.agent_id).at(info.queue_id);
 
             TRACE_EVENT_BEGIN(sdk::perfetto_category<sdk::category::kernel_dispatch>::name,
-                              ::perfetto::StaticString(demangled.at(name).c_str()),
+                              ::perfetto::StaticString(sym->demangled_kernel_name.c_str()),
                               track,
                               itr.start_timestamp,
                               ::perfetto::Flow::ProcessScoped(itr.correlation_id.internal),
@@ -29,6 +29,7 @@
 #include "lib/common/demangle.hpp"
 #include "lib/common/filesystem.hpp"
 #include "output_file.hpp"
+#include "tmp_file_view.hpp"
 
 #include <rocprofiler-sdk/agent.h>
 #include <rocprofiler-sdk/callback_tracing.h>
@@ -53,6 +54,7 @@
 #include <sys/syscall.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -271,22 +273,18 @@ struct rocprofiler_tool_record_counter_t
 
 struct rocprofiler_tool_counter_collection_record_t
 {
-    rocprofiler_profile_counting_dispatch_data_t       dispatch_data    = {};
-    std::array<rocprofiler_tool_record_counter_t, 256> records          = {};
-    uint64_t                                           thread_id        = 0;
-    uint64_t                                           arch_vgpr_count  = 0;
-    uint64_t                                           sgpr_count       = 0;
-    uint64_t                                           lds_block_size_v = 0;
-    uint64_t                                           counter_count    = 0;
+    rocprofiler_profile_counting_dispatch_data_t   dispatch_data    = {};
+    std::vector<rocprofiler_tool_record_counter_t> records          = {};
+    uint64_t                                       thread_id        = 0;
+    uint64_t                                       arch_vgpr_count  = 0;
+    uint64_t                                       sgpr_count       = 0;
+    uint64_t                                       lds_block_size_v = 0;
 
     template <typename ArchiveT>
     void save(ArchiveT& ar) const
     {
         ar(cereal::make_nvp("dispatch_data", dispatch_data));
-        // should be removed when moving to buffered tracing
-        std::vector<rocprofiler_tool_record_counter_t> tmp{records.begin(),
-                                                           records.begin() + counter_count};
-        ar(cereal::make_nvp("records", tmp));
+        ar(cereal::make_nvp("records", records));
         ar(cereal::make_nvp("thread_id", thread_id));
         ar(cereal::make_nvp("arch_vgpr_count", arch_vgpr_count));
         ar(cereal::make_nvp("sgpr_count", sgpr_count));
@@ -294,6 +292,108 @@ struct rocprofiler_tool_counter_collection_record_t
     }
 };
 
+// storage element of the encoded counter collection records
+struct rocprofiler_tool_counter_collection_block_t
+{
+    uint64_t data[8] = {};
+};
+
+/// the counter collection records are encoded as a fixed-size header followed by exactly
+/// counter_count values, padded to a whole number of blocks. The size of the temporary file
+/// therefore scales with the number of counters actually collected.
+template <>
+struct tmp_file_record_traits<rocprofiler_tool_counter_collection_record_t>
+{
+    using record_type  = rocprofiler_tool_counter_collection_record_t;
+    using value_type   = rocprofiler_tool_record_counter_t;
+    using storage_type = rocprofiler_tool_counter_collection_block_t;
+
+    // trivial so that it can be copied in and out of the blocks
+    struct header_type
+    {
+        rocprofiler_profile_counting_dispatch_data_t dispatch_data;
+        uint64_t                                     thread_id;
+        uint64_t                                     arch_vgpr_count;
+        uint64_t                                     sgpr_count;
+        uint64_t                                     lds_block_size_v;
+        uint64_t                                     counter_count;
+    };
+
+    static_assert(std::is_trivially_copyable<value_type>::value,
+                  "counter values are copied into the blocks");
+    static_assert(sizeof(header_type) % alignof(value_type) == 0,
+                  "counter values following the header must be aligned");
+
+    static size_t encoded_size(const record_type& _v) { return get_num_blocks(_v.records.size()); }
+
+    static size_t stored_size(const storage_type* _src)
+    {
+        auto _count = uint64_t{0};
+        std::memcpy(&_count,
+                    reinterpret_cast<const char*>(_src) + offsetof(header_type, counter_count),
+                    sizeof(_count));
+        return get_num_blocks(_count);
+    }
+
+    // the values of the record are released once encoded
+    static void encode(record_type&& _v, storage_type* _dst)
+    {
+        auto _header             = header_type{};
+        _header.dispatch_data    = _v.dispatch_data;
+        _header.thread_id        = _v.thread_id;
+        _header.arch_vgpr_count  = _v.arch_vgpr_count;
+        _header.sgpr_count       = _v.sgpr_count;
+        _header.lds_block_size_v = _v.lds_block_size_v;
+        _header.counter_count    = _v.records.size();
+
+        auto* _bytes = reinterpret_cast<char*>(_dst);
+        std::memcpy(_bytes, &_header, sizeof(header_type));
+        if(!_v.records.empty())
+            std::memcpy(_bytes + sizeof(header_type),
+                        _v.records.data(),
+                        _v.records.size() * sizeof(value_type));
+
+        _v.records.clear();
+        _v.records.shrink_to_fit();
+    }
+
+    static const record_type& decode(const storage_type* _src, record_type& _tmp)
+    {
+        auto _header           = get_header(_src);
+        _tmp.dispatch_data    = _header.dispatch_data;
+        _tmp.thread_id        = _header.thread_id;
+        _tmp.arch_vgpr_count  = _header.arch_vgpr_count;
+        _tmp.sgpr_count       = _header.sgpr_count;
+        _tmp.lds_block_size_v = _header.lds_block_size_v;
+        _tmp.records.resize(_header.counter_count);
+        if(_header.counter_count > 0)
+            std::memcpy(_tmp.records.data(),
+                        reinterpret_cast<const char*>(_src) + sizeof(header_type),
+                        _header.counter_count * sizeof(value_type));
+        return _tmp;
+    }
+
+    static std::pair<uint64_t, uint64_t> timestamps(const storage_type* _src)
+    {
+        auto _header = get_header(_src);
+        return {_header.dispatch_data.start_timestamp, _header.dispatch_data.end_timestamp};
+    }
+
+private:
+    static header_type get_header(const storage_type* _src)
+    {
+        auto _header = header_type{};
+        std::memcpy(&_header, _src, sizeof(header_type));
+        return _header;
+    }
+
+    static size_t get_num_blocks(size_t _count)
+    {
+        auto _bytes = sizeof(header_type) + (_count * sizeof(value_type));
+        return (_bytes + sizeof(storage_type) - 1) / sizeof(storage_type);
+    }
+};
+
 struct timestamps_t
 {
     rocprofiler_timestamp_t app_start_time;
@@ -359,25 +459,6 @@ struct tool_table
     tool_get_roctx_msg_fn_t          tool_get_roctx_msg_fn         = nullptr;
 };
 
-/// converts a container of ring buffers of element Tp into a single container of elements
-template <typename Tp, template <typename, typename...> class ContainerT, typename... ParamsT>
-ContainerT<Tp>
-get_buffer_elements(ContainerT<rocprofiler::common::container::ring_buffer<Tp>, ParamsT...>&& data)
-{
-    auto ret = ContainerT<Tp>{};
-    for(auto& buf : data)
-    {
-        Tp* record = nullptr;
-        do
-        {
-            record = buf.retrieve();
-            if(record) ret.emplace_back(*record);
-        } while(record != nullptr);
-    }
-
-    return ret;
-}
-
 namespace cereal
 {
 #define SAVE_DATA_FIELD(FIELD) ar(make_nvp(#FIELD, data.FIELD))
@@ -27,6 +27,8 @@
 #include <fmt/core.h>
 #include <fmt/format.h>
 
+#include <mutex>
+
 namespace rocprofiler
 {
 namespace tool
@@ -47,6 +49,9 @@ get_output_filename(std::string_view fname, std::string_view ext)
     auto output_path   = fs::path{cfg_output_path};
     auto output_prefix = tool::format(tool::get_config().output_file);
 
+    // the output files are opened concurrently at finalization
+    static auto _mkdir_mutex = std::mutex{};
+    auto        _mkdir_lk    = std::lock_guard<std::mutex>{_mkdir_mutex};
     if(fs::exists(output_path) && !fs::is_directory(fs::status(output_path)))
         throw std::runtime_error{
             fmt::format("ROCPROFILER_OUTPUT_PATH ({}) already exists and is not a directory",
@@ -80,8 +85,28 @@ get_output_stream(std::string_view fname, std::string_view ext)
             }};
 }
 
+void
+output_file::flush()
+{
+    check_writer();
+    write_buffer();
+}
+
+void
+output_file::write_buffer()
+{
+    if(m_buffer.size() == 0) return;
+
+    auto& _stream = (m_stream) ? *m_stream : std::cerr;
+    _stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    _stream.flush();
+    m_buffer.clear();
+}
+
 output_file::~output_file()
 {
+    write_buffer();
+
     if(m_stream)
         ROCP_INFO << "Closing result file: " << m_name;
     else
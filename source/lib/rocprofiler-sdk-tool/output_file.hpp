@@ -28,13 +28,16 @@
 #include "lib/common/filesystem.hpp"
 #include "lib/rocprofiler-sdk-tool/csv.hpp"
 
+#include <fmt/format.h>
+
 #include <array>
 #include <iostream>
-#include <mutex>
+#include <iterator>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace rocprofiler
@@ -49,8 +52,16 @@ get_output_filename(std::string_view fname, std::string_view ext);
 std::pair<std::ostream*, output_stream_dtor_t>
 get_output_stream(std::string_view fname, std::string_view ext);
 
+/// CSV output file. The rows are formatted into a large in-memory buffer which is written to the
+/// stream in chunks, i.e. the stream is not flushed for every row. The buffer is not synchronized:
+/// an output file must only be written by the thread which created it (e.g. the stream worker or
+/// the task generating the file), which is checked in debug builds. Another thread may destroy the
+/// output file once the writes are complete.
 struct output_file
 {
+    // size of the buffered output which triggers a write to the stream
+    static constexpr size_t flush_size = (4UL * 1024 * 1024);
+
     template <size_t N>
     output_file(std::string name, csv::csv_encoder<N>, std::array<std::string_view, N>&& header);
 
@@ -62,19 +73,46 @@ struct output_file
     std::string name() const { return m_name; }
 
     template <typename T>
-    std::ostream& operator<<(T&& value)
+    output_file& operator<<(T&& value)
+    {
+        check_writer();
+        fmt::format_to(std::back_inserter(m_buffer), "{}", std::forward<T>(value));
+        if(m_buffer.size() >= flush_size) write_buffer();
+        return *this;
+    }
+
+    /// formats the row with the CSV encoder directly into the output buffer
+    template <typename EncoderT, typename... Args>
+    void write_row(Args&&... args)
     {
-        auto _lk = std::unique_lock<std::mutex>{m_mutex};
-        return ((m_stream) ? *m_stream : std::cerr) << std::forward<T>(value) << std::flush;
+        check_writer();
+        EncoderT::write_row(m_buffer, std::forward<Args>(args)...);
+        if(m_buffer.size() >= flush_size) write_buffer();
     }
 
+    /// writes the buffered output to the stream
+    void flush();
+
     operator bool() const { return m_stream != nullptr; }
 
 private:
+    void write_buffer();
+
+    void check_writer() const
+    {
+#if !defined(NDEBUG)
+        ROCP_FATAL_IF(std::this_thread::get_id() != m_writer)
+            << "output file " << m_name << " is written by a thread which did not create it";
+#endif
+    }
+
     const std::string    m_name   = {};
-    std::mutex           m_mutex  = {};
+    csv::csv_buffer_t    m_buffer = {};
     std::ostream*        m_stream = nullptr;
     output_stream_dtor_t m_dtor   = [](std::ostream*&) {};
+#if !defined(NDEBUG)
+    const std::thread::id m_writer = std::this_thread::get_id();
+#endif
 };
 
 template <size_t N>
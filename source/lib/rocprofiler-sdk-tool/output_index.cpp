@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "output_index.hpp"
+
+#include "lib/common/logging.hpp"
+
+namespace rocprofiler
+{
+namespace tool
+{
+const kernel_symbol_data*
+output_index::get_kernel_symbol(rocprofiler_kernel_id_t _id) const
+{
+    if(_id >= kernel_symbols.size()) return nullptr;
+    const auto* _sym = &kernel_symbols.at(_id);
+    // the unused entries of the table are default constructed
+    return (_sym->kernel_id == _id) ? _sym : nullptr;
+}
+
+const rocprofiler_agent_t*
+output_index::get_agent(rocprofiler_agent_id_t _id) const
+{
+    auto itr = agents.find(_id);
+    return (itr != agents.end()) ? &itr->second : nullptr;
+}
+
+output_index
+build_output_index(
+    const std::vector<rocprofiler_agent_v0_t>&                          agent_data,
+    tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
+    tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
+    tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data)
+{
+    auto _index = output_index{};
+
+    _index.kernel_symbols = get_kernel_symbol_data();
+
+    for(const auto& itr : agent_data)
+        _index.agents.emplace(itr.id, itr);
+
+    auto add_api_threads = [&_index](const auto* _data) {
+        if(!_data) return;
+        for(const auto& itr : *_data)
+            _index.api_threads.emplace(itr.thread_id);
+    };
+
+    add_api_threads(hsa_api_data);
+    add_api_threads(hip_api_data);
+    add_api_threads(marker_api_data);
+
+    if(memory_copy_data)
+    {
+        for(const auto& itr : *memory_copy_data)
+            _index.memory_copy_threads[itr.thread_id].emplace(itr.dst_agent_id);
+    }
+
+    if(kernel_dispatch_data)
+    {
+        for(const auto& itr : *kernel_dispatch_data)
+        {
+            const auto& info = itr.dispatch_info;
+            _index.dispatch_queues[itr.thread_id][info.agent_id].emplace(info.queue_id);
+            ROCP_FATAL_IF(_index.get_kernel_symbol(info.kernel_id) == nullptr)
+                << "kernel dispatch " << info.dispatch_id << " has an unknown kernel id "
+                << info.kernel_id;
+        }
+    }
+
+    return _index;
+}
+}  // namespace tool
+}  // namespace rocprofiler
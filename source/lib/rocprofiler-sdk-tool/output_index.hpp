@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "helper.hpp"
+#include "tmp_file_view.hpp"
+
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/cxx/hash.hpp>
+#include <rocprofiler-sdk/cxx/operators.hpp>
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+/// symbols, agents, and track locations shared by the JSON, perfetto, and OTF2 outputs. The index
+/// is built in a single pass over the records once they have been read back instead of each
+/// output scanning the records and searching the kernel symbols for every dispatch.
+struct output_index
+{
+    using agent_map_t = std::unordered_map<rocprofiler_agent_id_t, rocprofiler_agent_t>;
+    using memory_copy_threads_t =
+        std::map<rocprofiler_thread_id_t, std::set<rocprofiler_agent_id_t>>;
+    using dispatch_queues_t =
+        std::map<rocprofiler_thread_id_t,
+                 std::map<rocprofiler_agent_id_t, std::set<rocprofiler_queue_id_t>>>;
+
+    const kernel_symbol_data*  get_kernel_symbol(rocprofiler_kernel_id_t _id) const;
+    const rocprofiler_agent_t* get_agent(rocprofiler_agent_id_t _id) const;
+
+    // kernel symbols (with the demangled and formatted names) indexed by the kernel id
+    std::vector<kernel_symbol_data> kernel_symbols = {};
+    agent_map_t                     agents         = {};
+    // threads with HSA, HIP, or marker API records
+    std::set<rocprofiler_thread_id_t> api_threads = {};
+    // thread -> destination agents of the memory copies
+    memory_copy_threads_t memory_copy_threads = {};
+    // thread -> agent -> queues of the kernel dispatches
+    dispatch_queues_t dispatch_queues = {};
+};
+
+output_index
+build_output_index(
+    const std::vector<rocprofiler_agent_v0_t>&                          agent_data,
+    tmp_file_view<rocprofiler_buffer_tracing_hip_api_record_t>*         hip_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_hsa_api_record_t>*         hsa_api_data,
+    tmp_file_view<rocprofiler_buffer_tracing_kernel_dispatch_record_t>* kernel_dispatch_data,
+    tmp_file_view<rocprofiler_buffer_tracing_memory_copy_record_t>*     memory_copy_data,
+    tmp_file_view<rocprofiler_buffer_tracing_marker_api_record_t>*      marker_api_data);
+}  // namespace tool
+}  // namespace rocprofiler
@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "streaming_output.hpp"
+
+#include <utility>
+
+namespace rocprofiler
+{
+namespace tool
+{
+stream_worker::stream_worker()
+: m_thread{[this]() { run(); }}
+{}
+
+stream_worker::~stream_worker()
+{
+    {
+        auto _lk = std::unique_lock<std::mutex>{m_mutex};
+        m_exit   = true;
+    }
+    m_cv.notify_all();
+    if(m_thread.joinable()) m_thread.join();
+}
+
+void
+stream_worker::submit(task_t&& _task)
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    m_cv.wait(_lk, [this]() { return m_tasks.size() < max_pending_tasks; });
+    m_tasks.emplace_back(std::move(_task));
+    _lk.unlock();
+    m_cv.notify_all();
+}
+
+void
+stream_worker::wait()
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    m_cv.wait(_lk, [this]() { return m_tasks.empty() && m_running == 0; });
+}
+
+void
+stream_worker::run()
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    while(true)
+    {
+        m_cv.wait(_lk, [this]() { return m_exit || !m_tasks.empty(); });
+        if(m_tasks.empty()) break;
+
+        auto _task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        ++m_running;
+        _lk.unlock();
+        m_cv.notify_all();
+
+        _task();
+
+        _lk.lock();
+        --m_running;
+        m_cv.notify_all();
+    }
+}
+
+stream_worker&
+get_stream_worker()
+{
+    // intentionally leaked: the thread is idle once the outputs have been finalized
+    static auto* _v = new stream_worker{};
+    return *_v;
+}
+}  // namespace tool
+}  // namespace rocprofiler
@@ -0,0 +1,165 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "generateCSV.hpp"
+#include "helper.hpp"
+#include "tmp_file_buffer.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace rocprofiler
+{
+namespace tool
+{
+/// background thread which processes the ring buffers handed off by the streaming outputs. At
+/// most max_pending_tasks are queued: submit() blocks when the thread falls behind so that the
+/// memory held by the pending ring buffers stays bounded.
+class stream_worker
+{
+public:
+    using task_t = std::function<void()>;
+
+    static constexpr size_t max_pending_tasks = 8;
+
+    stream_worker();
+    ~stream_worker();
+
+    stream_worker(const stream_worker&)     = delete;
+    stream_worker(stream_worker&&) noexcept = delete;
+    stream_worker& operator=(const stream_worker&) = delete;
+    stream_worker& operator=(stream_worker&&) noexcept = delete;
+
+    void submit(task_t&& _task);
+    void wait();
+
+private:
+    void run();
+
+    bool                    m_exit    = false;
+    size_t                  m_running = 0;
+    std::mutex              m_mutex   = {};
+    std::condition_variable m_cv      = {};
+    std::deque<task_t>      m_tasks   = {};
+    std::thread             m_thread  = {};
+};
+
+stream_worker&
+get_stream_worker();
+
+/// converts the records of one domain into CSV rows as the ring buffer of the domain is offloaded
+/// instead of reading the records back from the temporary file at finalization. The records are
+/// only written to the temporary file if another output format requires them.
+template <typename Tp, domain_type DomainT>
+class streaming_output
+{
+public:
+    using ring_buffer_type              = tmp_ring_buffer_t<Tp>;
+    using traits_type                   = tmp_file_record_traits<Tp>;
+    static constexpr auto buffer_type_v = DomainT;
+
+    streaming_output(tool_table* tool_functions, bool keep_tmp_file);
+    ~streaming_output();
+
+    streaming_output(const streaming_output&)     = delete;
+    streaming_output(streaming_output&&) noexcept = delete;
+    streaming_output& operator=(const streaming_output&) = delete;
+    streaming_output& operator=(streaming_output&&) noexcept = delete;
+
+    stats_data_t finalize();
+
+private:
+    void offload(std::shared_ptr<ring_buffer_type> _buffer);
+    void consume(ring_buffer_type& _buffer);
+
+    bool           m_keep_tmp_file = false;
+    csv_writer<Tp> m_writer;
+};
+
+template <typename Tp, domain_type DomainT>
+streaming_output<Tp, DomainT>::streaming_output(tool_table* tool_functions, bool keep_tmp_file)
+: m_keep_tmp_file{keep_tmp_file}
+, m_writer{tool_functions}
+{
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<ring_buffer_type>(buffer_type_v);
+    auto _lk                   = std::lock_guard<std::mutex>{_tmp_file->file_mutex};
+    get_offload_handler<ring_buffer_type>(buffer_type_v) =
+        [this](std::shared_ptr<ring_buffer_type> _buffer) { offload(std::move(_buffer)); };
+}
+
+template <typename Tp, domain_type DomainT>
+streaming_output<Tp, DomainT>::~streaming_output()
+{
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<ring_buffer_type>(buffer_type_v);
+    auto _lk                   = std::lock_guard<std::mutex>{_tmp_file->file_mutex};
+    get_offload_handler<ring_buffer_type>(buffer_type_v) = nullptr;
+}
+
+// invoked without the file mutex of the domain held so blocking in submit() while the stream
+// worker falls behind does not stall other users of the temporary file. The records are
+// processed on the stream worker. While the handler is installed, the stream worker is the only
+// thread which writes to the temporary file.
+template <typename Tp, domain_type DomainT>
+void
+streaming_output<Tp, DomainT>::offload(std::shared_ptr<ring_buffer_type> _buffer)
+{
+    get_stream_worker().submit([this, _buffer]() { consume(*_buffer); });
+}
+
+template <typename Tp, domain_type DomainT>
+void
+streaming_output<Tp, DomainT>::consume(ring_buffer_type& _buffer)
+{
+    if(m_keep_tmp_file)
+    {
+        auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<ring_buffer_type>(buffer_type_v);
+        save_tmp_buffer<Tp>(_buffer, _tmp_file, buffer_type_v);
+    }
+
+    // the buffer was written without wrapping so the encoded records are contiguous from the head
+    const auto* _data  = _buffer.peek();
+    auto        _count = (_data) ? _buffer.count() : 0;
+    auto        _tmp   = Tp{};
+    for(size_t i = 0; i < _count; i += traits_type::stored_size(_data + i))
+        m_writer.write(traits_type::decode(_data + i, _tmp));
+
+    _buffer.destroy();
+}
+
+/// waits for the offloaded buffers to be processed and writes the statistics. The tail of the
+/// ring buffer must be flushed beforehand.
+template <typename Tp, domain_type DomainT>
+stats_data_t
+streaming_output<Tp, DomainT>::finalize()
+{
+    get_stream_worker().wait();
+    return m_writer.finalize();
+}
+}  // namespace tool
+}  // namespace rocprofiler
@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "task_pool.hpp"
+
+#include <algorithm>
+
+namespace rocprofiler
+{
+namespace tool
+{
+task_pool::task_pool(size_t nthreads)
+: m_nthreads{std::max<size_t>(nthreads, 1)}
+{}
+
+task_pool::~task_pool()
+{
+    {
+        auto _lk = std::unique_lock<std::mutex>{m_mutex};
+        m_exit   = true;
+    }
+    m_cv.notify_all();
+    for(auto& itr : m_threads)
+        if(itr.joinable()) itr.join();
+}
+
+std::shared_future<void>
+task_pool::enqueue(task_t&& _task)
+{
+    auto _future = _task.get_future().share();
+
+    if(m_nthreads == 1)
+    {
+        _task();
+        return _future;
+    }
+
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    m_tasks.emplace_back(std::move(_task));
+    if(m_threads.size() < m_nthreads) m_threads.emplace_back([this]() { run(); });
+    _lk.unlock();
+    m_cv.notify_one();
+
+    return _future;
+}
+
+void
+task_pool::run()
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    while(true)
+    {
+        m_cv.wait(_lk, [this]() { return m_exit || !m_tasks.empty(); });
+        if(m_tasks.empty()) break;
+
+        auto _task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        _lk.unlock();
+
+        // exceptions are stored in the future of the task
+        _task();
+
+        _lk.lock();
+    }
+}
+}  // namespace tool
+}  // namespace rocprofiler
@@ -0,0 +1,79 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+/// fixed-size pool of threads which generates the output files at finalization. The tasks are
+/// started in the order they were submitted so a task may wait on the future of a task submitted
+/// before it. The threads are only created once there are tasks and a pool of size one (or zero)
+/// executes the tasks in the submitting thread.
+class task_pool
+{
+public:
+    using task_t = std::packaged_task<void()>;
+
+    explicit task_pool(size_t nthreads);
+    ~task_pool();
+
+    task_pool(const task_pool&)     = delete;
+    task_pool(task_pool&&) noexcept = delete;
+    task_pool& operator=(const task_pool&) = delete;
+    task_pool& operator=(task_pool&&) noexcept = delete;
+
+    template <typename FuncT>
+    std::shared_future<void> submit(FuncT&& _func);
+
+    size_t size() const { return m_nthreads; }
+
+private:
+    std::shared_future<void> enqueue(task_t&& _task);
+    void                     run();
+
+    bool                     m_exit     = false;
+    size_t                   m_nthreads = 1;
+    std::mutex               m_mutex    = {};
+    std::condition_variable  m_cv       = {};
+    std::deque<task_t>       m_tasks    = {};
+    std::vector<std::thread> m_threads  = {};
+};
+
+template <typename FuncT>
+std::shared_future<void>
+task_pool::submit(FuncT&& _func)
+{
+    return enqueue(task_t{std::forward<FuncT>(_func)});
+}
+}  // namespace tool
+}  // namespace rocprofiler
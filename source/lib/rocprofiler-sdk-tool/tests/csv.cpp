@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk-tool/csv.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace csv = ::rocprofiler::tool::csv;
+
+namespace
+{
+using test_encoder = csv::csv_encoder<8>;
+
+template <typename... Args>
+void
+expect_same_row(Args&&... args)
+{
+    auto _ss = std::stringstream{};
+    test_encoder::write_row(_ss, args...);
+
+    auto _buf = csv::csv_buffer_t{};
+    test_encoder::write_row(_buf, args...);
+
+    EXPECT_EQ(std::string(_buf.data(), _buf.size()), _ss.str());
+}
+}  // namespace
+
+TEST(csv, buffer_encoder)
+{
+    const char* _cstr = "hipMemcpy";
+    auto        _str  = std::string{"kernel<int>(int*, float)"};
+
+    expect_same_row(std::string_view{"HIP_RUNTIME_API"},
+                    _cstr,
+                    _str,
+                    uint64_t{0},
+                    int64_t{-42},
+                    uint32_t{4294967295},
+                    uint64_t{18446744073709551615UL},
+                    12);
+
+    expect_same_row(1.0, 1234.5678901, 0.5, 1.0e-12, 0.0, 3.0f, 0.25f, size_t{7});
+}
+
+TEST(csv, buffer_header)
+{
+    auto _buf = csv::csv_buffer_t{};
+    csv::csv_encoder<3>::write_row(_buf, "Kind", "Agent_Id", "Queue_Id");
+    EXPECT_EQ(std::string(_buf.data(), _buf.size()), "\"Kind\",\"Agent_Id\",\"Queue_Id\"\n");
+}
@@ -0,0 +1,194 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Benchmark of the rocprofv3 CSV output. Synthetic kernel trace records are written with the
+// per-row stringstream + flushed stream insertion and with the buffered encoder which formats
+// the rows in place and writes them to the file in large chunks. Reports rows per second.
+//
+//  usage: rocprofv3-csv-benchmark [<number of rows> [<output file>]]
+
+#include "lib/rocprofiler-sdk-tool/csv.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace csv = ::rocprofiler::tool::csv;
+
+namespace
+{
+constexpr size_t flush_size = (4UL * 1024 * 1024);
+
+struct synthetic_record
+{
+    uint64_t agent_id        = 0;
+    uint64_t queue_id        = 0;
+    uint64_t thread_id       = 0;
+    uint64_t dispatch_id     = 0;
+    uint64_t kernel_id       = 0;
+    uint64_t correlation_id  = 0;
+    uint64_t start_timestamp = 0;
+    uint64_t end_timestamp   = 0;
+    uint32_t private_segment = 0;
+    uint32_t group_segment   = 0;
+    uint32_t workgroup[3]    = {};
+    uint32_t grid[3]         = {};
+};
+
+const std::vector<std::string>&
+get_kernel_names()
+{
+    static auto _v = std::vector<std::string>{
+        "void transpose_kernel<float, 64u>(float*, float const*, int, int)",
+        "reduce_kernel(double*, double const*, unsigned long)",
+        "__amd_rocclr_fillBufferAligned.kd",
+        "Cijk_Ailk_Bljk_SB_MT128x128x16_MI32x32x2x1_SN_1LDSB0_APM1_ABV0_ACED0_AF0EM1"};
+    return _v;
+}
+
+synthetic_record
+make_record(uint64_t idx)
+{
+    auto _v            = synthetic_record{};
+    _v.agent_id        = 1 + (idx % 8);
+    _v.queue_id        = 0x7f0000001000 + (idx % 4) * 0x1000;
+    _v.thread_id       = 120000 + (idx % 16);
+    _v.dispatch_id     = idx + 1;
+    _v.kernel_id       = 1 + (idx % get_kernel_names().size());
+    _v.correlation_id  = idx + 1;
+    _v.start_timestamp = 1718000000000000000 + (idx * 1500);
+    _v.end_timestamp   = _v.start_timestamp + 1000 + (idx % 977);
+    _v.private_segment = 0;
+    _v.group_segment   = 4096;
+    _v.workgroup[0]    = 256;
+    _v.workgroup[1]    = 1;
+    _v.workgroup[2]    = 1;
+    _v.grid[0]         = 1048576;
+    _v.grid[1]         = 1;
+    _v.grid[2]         = 1;
+    return _v;
+}
+
+template <typename EncodeT>
+void
+encode_row(EncodeT&& _out, const synthetic_record& _v)
+{
+    csv::kernel_trace_csv_encoder::write_row(
+        _out,
+        std::string_view{"KERNEL_DISPATCH"},
+        _v.agent_id,
+        _v.queue_id,
+        _v.thread_id,
+        _v.dispatch_id,
+        _v.kernel_id,
+        std::string_view{get_kernel_names().at(_v.kernel_id - 1)},
+        _v.correlation_id,
+        _v.start_timestamp,
+        _v.end_timestamp,
+        _v.private_segment,
+        _v.group_segment,
+        _v.workgroup[0],
+        _v.workgroup[1],
+        _v.workgroup[2],
+        _v.grid[0],
+        _v.grid[1],
+        _v.grid[2]);
+}
+
+// formats each row into a stringstream and flushes the stream after each row
+void
+write_stream(std::ostream& _ofs, size_t _nrows)
+{
+    for(size_t i = 0; i < _nrows; ++i)
+    {
+        auto _row = std::stringstream{};
+        encode_row(_row, make_record(i));
+        _ofs << _row.str() << std::flush;
+    }
+}
+
+// formats the rows into a reusable buffer which is written in chunks
+void
+write_buffered(std::ostream& _ofs, size_t _nrows)
+{
+    auto _buffer = csv::csv_buffer_t{};
+    _buffer.reserve(flush_size + 4096);
+    for(size_t i = 0; i < _nrows; ++i)
+    {
+        encode_row(_buffer, make_record(i));
+        if(_buffer.size() >= flush_size)
+        {
+            _ofs.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+            _buffer.clear();
+        }
+    }
+    _ofs.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _ofs.flush();
+}
+
+template <typename FuncT>
+void
+measure(std::string_view _label, const std::string& _fname, size_t _nrows, FuncT&& _func)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    auto _ofs = std::ofstream{_fname, std::ios::binary | std::ios::trunc};
+    if(!_ofs)
+    {
+        std::cerr << "failed to open " << _fname << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    auto _beg = clock_type::now();
+    _func(_ofs, _nrows);
+    _ofs.close();
+    auto _end     = clock_type::now();
+    auto _elapsed = std::chrono::duration<double>(_end - _beg).count();
+
+    std::cout << std::setw(10) << _label << std::fixed << std::setprecision(3) << std::setw(12)
+              << (_nrows / _elapsed / 1.0e6) << " M rows/sec" << std::setw(12) << _elapsed
+              << " sec" << std::endl;
+}
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    size_t _nrows = 10000000;
+    auto   _fname = std::string{"rocprofv3-csv-benchmark.csv"};
+    if(argc > 1) _nrows = std::stoull(argv[1]);
+    if(argc > 2) _fname = argv[2];
+
+    std::cout << "writing " << _nrows << " kernel trace rows to " << _fname << std::endl;
+
+    measure("stream", _fname, _nrows, write_stream);
+    measure("buffered", _fname, _nrows, write_buffered);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk-tool/task_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace tool = ::rocprofiler::tool;
+
+TEST(task_pool, sequential)
+{
+    auto _pool = tool::task_pool{1};
+    EXPECT_EQ(_pool.size(), 1);
+
+    // a pool of size one executes the tasks in the submitting thread
+    auto _tid     = std::this_thread::get_id();
+    auto _order   = std::vector<size_t>{};
+    auto _futures = std::vector<std::shared_future<void>>{};
+    for(size_t i = 0; i < 8; ++i)
+    {
+        _futures.emplace_back(_pool.submit([&_order, _tid, i]() {
+            EXPECT_EQ(std::this_thread::get_id(), _tid);
+            _order.emplace_back(i);
+        }));
+        EXPECT_EQ(_futures.back().wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    }
+
+    ASSERT_EQ(_order.size(), 8);
+    for(size_t i = 0; i < _order.size(); ++i)
+        EXPECT_EQ(_order.at(i), i);
+}
+
+TEST(task_pool, wait_on_previous_task)
+{
+    constexpr size_t num_tasks = 64;
+
+    auto _pool     = tool::task_pool{4};
+    auto _mutex    = std::mutex{};
+    auto _finished = std::vector<size_t>{};
+    auto _futures  = std::vector<std::shared_future<void>>{};
+
+    // the tasks are started in submission order so each task may wait on the previous one without
+    // deadlocking, even when there are more tasks than threads
+    for(size_t i = 0; i < num_tasks; ++i)
+    {
+        auto _prev = (i > 0) ? _futures.back() : std::shared_future<void>{};
+        _futures.emplace_back(_pool.submit([&_mutex, &_finished, _prev, i]() {
+            if(_prev.valid()) _prev.wait();
+            auto _lk = std::lock_guard<std::mutex>{_mutex};
+            _finished.emplace_back(i);
+        }));
+    }
+
+    for(auto& itr : _futures)
+        itr.wait();
+
+    ASSERT_EQ(_finished.size(), num_tasks);
+    for(size_t i = 0; i < _finished.size(); ++i)
+        EXPECT_EQ(_finished.at(i), i);
+}
+
+TEST(task_pool, exception)
+{
+    for(size_t nthreads : {1, 4})
+    {
+        auto _pool  = tool::task_pool{nthreads};
+        auto _count = std::atomic<size_t>{0};
+
+        auto _fail = _pool.submit([]() { throw std::runtime_error{"task failure"}; });
+        auto _pass = _pool.submit([&_count]() { ++_count; });
+
+        // the exception is propagated through the future of the failed task only
+        EXPECT_THROW(_fail.get(), std::runtime_error);
+        EXPECT_NO_THROW(_pass.get());
+        EXPECT_EQ(_count.load(), 1);
+    }
+}
@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk-tool/helper.hpp"
+#include "lib/rocprofiler-sdk-tool/tmp_file.hpp"
+#include "lib/rocprofiler-sdk-tool/tmp_file_buffer.hpp"
+#include "lib/rocprofiler-sdk-tool/tmp_file_view.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct test_record
+{
+    uint64_t value           = 0;
+    uint64_t start_timestamp = 0;
+    uint64_t end_timestamp   = 0;
+};
+
+constexpr uint64_t test_record_type = 7;
+
+using counter_record_t = rocprofiler_tool_counter_collection_record_t;
+using counter_traits_t = tmp_file_record_traits<counter_record_t>;
+
+std::string
+get_tmp_filename()
+{
+    auto _name = std::string{"rocprofv3-tool-tests-"} + std::to_string(getpid()) + ".tmp";
+    return (std::filesystem::current_path() / _name).string();
+}
+
+std::vector<test_record>
+make_records(uint64_t _begin, uint64_t _count)
+{
+    auto _records = std::vector<test_record>{};
+    for(uint64_t i = _begin; i < _begin + _count; ++i)
+        _records.emplace_back(test_record{i, i, i + 1});
+    return _records;
+}
+
+bool
+write_records(tmp_file& _file, const std::vector<test_record>& _records, size_t _chunk_size)
+{
+    auto _header          = tmp_file_chunk_header{};
+    _header.record_type   = test_record_type;
+    _header.record_size   = sizeof(test_record);
+    _header.count         = _records.size();
+    _header.min_timestamp = _records.front().start_timestamp;
+    _header.max_timestamp = _records.back().end_timestamp;
+    return _file.write_chunk(
+        _header, _records.data(), _records.size() * sizeof(test_record), _chunk_size);
+}
+
+counter_record_t
+make_counter_record(uint64_t _idx, size_t _num_counters)
+{
+    auto _v                                    = counter_record_t{};
+    _v.dispatch_data.size                      = sizeof(_v.dispatch_data);
+    _v.dispatch_data.correlation_id.internal   = _idx;
+    _v.dispatch_data.start_timestamp           = (10 * _idx);
+    _v.dispatch_data.end_timestamp             = (10 * _idx) + 5;
+    _v.dispatch_data.dispatch_info.kernel_id   = _idx + 1;
+    _v.dispatch_data.dispatch_info.dispatch_id = _idx + 2;
+    _v.dispatch_data.dispatch_info.grid_size.x = _idx + 3;
+    _v.dispatch_data.dispatch_info.agent_id    = {.handle = _idx + 4};
+    _v.thread_id                               = _idx + 5;
+    _v.arch_vgpr_count                         = _idx + 6;
+    _v.sgpr_count                              = _idx + 7;
+    _v.lds_block_size_v                        = _idx + 8;
+    for(size_t i = 0; i < _num_counters; ++i)
+    {
+        auto _counter                           = rocprofiler_tool_record_counter_t{};
+        _counter.counter_id                     = {.handle = i};
+        _counter.record_counter.id              = (_idx << 32) | i;
+        _counter.record_counter.counter_value   = static_cast<double>(_idx) + (0.5 * i);
+        _counter.record_counter.dispatch_id     = _idx + 2;
+        _counter.record_counter.user_data.value = i;
+        _v.records.emplace_back(_counter);
+    }
+    return _v;
+}
+
+void
+expect_equal(const counter_record_t& lhs, const counter_record_t& rhs)
+{
+    const auto& _lhs_data = lhs.dispatch_data;
+    const auto& _rhs_data = rhs.dispatch_data;
+    EXPECT_EQ(_lhs_data.size, _rhs_data.size);
+    EXPECT_EQ(_lhs_data.correlation_id.internal, _rhs_data.correlation_id.internal);
+    EXPECT_EQ(_lhs_data.start_timestamp, _rhs_data.start_timestamp);
+    EXPECT_EQ(_lhs_data.end_timestamp, _rhs_data.end_timestamp);
+    EXPECT_EQ(_lhs_data.dispatch_info.kernel_id, _rhs_data.dispatch_info.kernel_id);
+    EXPECT_EQ(_lhs_data.dispatch_info.dispatch_id, _rhs_data.dispatch_info.dispatch_id);
+    EXPECT_EQ(_lhs_data.dispatch_info.grid_size.x, _rhs_data.dispatch_info.grid_size.x);
+    EXPECT_EQ(_lhs_data.dispatch_info.agent_id.handle, _rhs_data.dispatch_info.agent_id.handle);
+    EXPECT_EQ(lhs.thread_id, rhs.thread_id);
+    EXPECT_EQ(lhs.arch_vgpr_count, rhs.arch_vgpr_count);
+    EXPECT_EQ(lhs.sgpr_count, rhs.sgpr_count);
+    EXPECT_EQ(lhs.lds_block_size_v, rhs.lds_block_size_v);
+    ASSERT_EQ(lhs.records.size(), rhs.records.size());
+    for(size_t i = 0; i < lhs.records.size(); ++i)
+    {
+        const auto& _lhs = lhs.records.at(i);
+        const auto& _rhs = rhs.records.at(i);
+        EXPECT_EQ(_lhs.counter_id.handle, _rhs.counter_id.handle);
+        EXPECT_EQ(_lhs.record_counter.id, _rhs.record_counter.id);
+        EXPECT_EQ(_lhs.record_counter.counter_value, _rhs.record_counter.counter_value);
+        EXPECT_EQ(_lhs.record_counter.dispatch_id, _rhs.record_counter.dispatch_id);
+        EXPECT_EQ(_lhs.record_counter.user_data.value, _rhs.record_counter.user_data.value);
+    }
+}
+}  // namespace
+
+TEST(tmp_file, oversized_chunk)
+{
+    constexpr size_t normal_count  = 16;
+    constexpr size_t oversized_cnt = 1000;
+    constexpr size_t normal_size   = sizeof(tmp_file_chunk_header) + (32 * sizeof(test_record));
+    constexpr size_t oversized_size =
+        sizeof(tmp_file_chunk_header) + (oversized_cnt * sizeof(test_record));
+
+    auto _file = tmp_file{get_tmp_filename()};
+
+    // a partially filled chunk, a record larger than the ring buffer written as its own chunk,
+    // then another partially filled chunk
+    ASSERT_TRUE(write_records(_file, make_records(0, normal_count), normal_size));
+    ASSERT_TRUE(write_records(_file, make_records(normal_count, oversized_cnt), oversized_size));
+    ASSERT_TRUE(write_records(
+        _file, make_records(normal_count + oversized_cnt, normal_count), normal_size));
+
+    auto _view = make_tmp_file_view<test_record>(_file, test_record_type);
+
+    ASSERT_EQ(_view.chunks().size(), 3);
+    EXPECT_EQ(_view.chunks().at(0).count, normal_count);
+    EXPECT_EQ(_view.chunks().at(1).count, oversized_cnt);
+    EXPECT_EQ(_view.chunks().at(2).count, normal_count);
+    ASSERT_EQ(_view.size(), (2 * normal_count) + oversized_cnt);
+
+    uint64_t _expected = 0;
+    for(const auto& itr : _view)
+    {
+        EXPECT_EQ(itr.value, _expected);
+        EXPECT_EQ(itr.start_timestamp, _expected);
+        ++_expected;
+    }
+    EXPECT_EQ(_expected, _view.size());
+
+    _view.clear();
+    EXPECT_TRUE(_file.remove());
+}
+
+TEST(tmp_file, counter_collection_records)
+{
+    constexpr auto   type     = domain_type::COUNTER_COLLECTION;
+    constexpr size_t capacity = 256;  // blocks in the ring buffer
+
+    // no counter value, one value, a few values, more than 256 values and more values than the
+    // ring buffer can hold
+    auto _num_counters = std::vector<size_t>{0, 1, 0, 3, 300, 1, 1000, 17, 0, 257, 2};
+    auto _expected     = std::vector<counter_record_t>{};
+    for(size_t i = 0; i < 4 * _num_counters.size(); ++i)
+        _expected.emplace_back(make_counter_record(i, _num_counters.at(i % _num_counters.size())));
+
+    auto _file    = tmp_file{get_tmp_filename()};
+    auto _buffer  = tmp_ring_buffer_t<counter_record_t>{capacity};
+    auto _offload = [&_file](tmp_ring_buffer_t<counter_record_t>& _v) {
+        save_tmp_buffer<counter_record_t>(_v, &_file, type);
+        _v.clear();
+    };
+
+    size_t _num_blocks    = 0;
+    size_t _num_oversized = 0;
+    for(const auto& itr : _expected)
+    {
+        auto _record = itr;
+        auto _n      = counter_traits_t::encoded_size(_record);
+        _num_blocks += _n;
+        if(_n > capacity) ++_num_oversized;
+        encode_record(std::move(_record), _buffer, _offload);
+    }
+    _offload(_buffer);
+    ASSERT_GT(_num_oversized, 0);
+
+    auto _view = make_tmp_file_view<counter_record_t>(_file, static_cast<uint64_t>(type));
+
+    ASSERT_EQ(_view.size(), _expected.size());
+
+    // every record larger than the ring buffer is written as its own chunk
+    size_t _num_stored = 0;
+    EXPECT_EQ(std::count_if(_view.chunks().begin(),
+                            _view.chunks().end(),
+                            [](const auto& itr) { return itr.count > capacity; }),
+              _num_oversized);
+    for(const auto& itr : _view.chunks())
+        _num_stored += itr.count;
+    EXPECT_EQ(_num_stored, _num_blocks);
+
+    size_t _idx = 0;
+    for(const auto& itr : _view)
+    {
+        ASSERT_LT(_idx, _expected.size());
+        expect_equal(itr, _expected.at(_idx++));
+    }
+    EXPECT_EQ(_idx, _expected.size());
+
+    _view.clear();
+    EXPECT_TRUE(_file.remove());
+}
@@ -24,24 +24,62 @@
 #include "config.hpp"
 
 #include "lib/common/filesystem.hpp"
+#include "lib/common/logging.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 
 namespace fs = ::rocprofiler::common::filesystem;
 
+namespace
+{
 bool
-tmp_file::fopen(const char* _mode)
+pwrite_all(int _fd, const void* _data, size_t _size, size_t _offset)
 {
-    auto fpath = fs::path{filename}.parent_path();
-    if(!fs::exists(fpath)) fs::create_directories(fpath);
+    const auto* _ptr = static_cast<const char*>(_data);
+    while(_size > 0)
+    {
+        auto _ret = ::pwrite(_fd, _ptr, _size, _offset);
+        if(_ret < 0)
+        {
+            if(errno == EINTR || errno == EAGAIN) continue;
+            return false;
+        }
+        _ptr += _ret;
+        _size -= _ret;
+        _offset += _ret;
+    }
+    return true;
+}
+}  // namespace
+
+tmp_file_mapping::tmp_file_mapping(int _fd, size_t _size)
+{
+    if(_fd < 0 || _size == 0) return;
 
-    if(!fs::exists(filename))
+    auto* _addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if(_addr == MAP_FAILED)
     {
-        // if the filepath does not exist, open in out mode to create it
-        std::ofstream _ofs{filename};
+        ROCP_ERROR << "failed to map temporary file: " << strerror(errno);
+        return;
     }
-    file = std::fopen(filename.c_str(), _mode);
-    if(file) fd = ::fileno(file);
 
-    return (file != nullptr && fd > 0);
+    // the chunks are consumed front to back once
+    ::madvise(_addr, _size, MADV_SEQUENTIAL);
+    ::madvise(_addr, _size, MADV_WILLNEED);
+
+    m_addr = _addr;
+    m_size = _size;
+}
+
+tmp_file_mapping::~tmp_file_mapping()
+{
+    if(m_addr) ::munmap(m_addr, m_size);
 }
 
 tmp_file::tmp_file(std::string _filename)
@@ -55,67 +93,66 @@ tmp_file::~tmp_file()
 }
 
 bool
-tmp_file::flush()
+tmp_file::open()
 {
-    if(stream.is_open())
-    {
-        stream.flush();
-    }
-    else if(file != nullptr)
-    {
-        int _ret = fflush(file);
-        int _cnt = 0;
-        while(_ret == EAGAIN || _ret == EINTR)
-        {
-            // std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
-            _ret = fflush(file);
-            if(++_cnt > 10) break;
-        }
-        return (_ret == 0);
-    }
+    if(fd >= 0) return true;
 
-    return true;
+    auto fpath = fs::path{filename}.parent_path();
+    if(!fs::exists(fpath)) fs::create_directories(fpath);
+
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if(fd < 0)
+        ROCP_ERROR << "failed to open temporary file " << filename << ": " << strerror(errno);
+
+    return (fd >= 0);
 }
 
 bool
 tmp_file::close()
 {
-    flush();
-
-    if(stream.is_open())
-    {
-        stream.close();
-        return !stream.is_open();
-    }
-    else if(file != nullptr)
-    {
-        auto _ret = fclose(file);
-        if(_ret == 0)
-        {
-            file = nullptr;
-            fd   = -1;
-        }
-        return (_ret == 0);
-    }
+    if(fd < 0) return true;
 
-    return true;
+    auto _ret = ::close(fd);
+    fd        = -1;
+    return (_ret == 0);
 }
 
 bool
-tmp_file::open(std::ios::openmode _mode)
+tmp_file::write_chunk(const tmp_file_chunk_header& _header,
+                      const void*                  _records,
+                      size_t                       _records_size,
+                      size_t                       _chunk_size)
 {
-    auto fpath = fs::path{filename}.parent_path();
-    if(!fs::exists(fpath)) fs::create_directories(fpath);
+    ROCP_FATAL_IF(sizeof(_header) + _records_size > _chunk_size)
+        << "temporary file chunk of " << _chunk_size << " bytes cannot hold " << _records_size
+        << " bytes of records";
 
-    if(!fs::exists(filename))
+    if(fd < 0 && !open()) return false;
+
+    auto _offset             = end_offset;
+    auto _chunk_header       = _header;
+    _chunk_header.chunk_size = _chunk_size;
+    if(!pwrite_all(fd, &_chunk_header, sizeof(_chunk_header), _offset) ||
+       !pwrite_all(fd, _records, _records_size, _offset + sizeof(_header)))
     {
-        // if the filepath does not exist, open in out mode to create it
-        std::ofstream _ofs{};
-        _ofs.open(filename, std::ofstream::binary | std::ofstream::out);
+        ROCP_ERROR << "failed to write chunk to temporary file " << filename << ": "
+                   << strerror(errno);
+        return false;
     }
 
-    stream.open(filename, _mode);
-    return (stream.is_open() && stream.good());
+    // the padding to the chunk size is never written so it does not occupy any disk space
+    end_offset += _chunk_size;
+    file_size = _offset + sizeof(_header) + _records_size;
+    return true;
+}
+
+std::shared_ptr<const tmp_file_mapping>
+tmp_file::map() const
+{
+    if(fd < 0 || file_size == 0) return nullptr;
+
+    auto _mapping = std::make_shared<const tmp_file_mapping>(fd, file_size);
+    return (*_mapping) ? _mapping : nullptr;
 }
 
 bool
@@ -131,7 +168,4 @@ tmp_file::remove()
     return true;
 }
 
-tmp_file::operator bool() const
-{
-    return (stream.is_open() && stream.good()) || (file != nullptr && fd > 0);
-}
+tmp_file::operator bool() const { return (fd >= 0); }
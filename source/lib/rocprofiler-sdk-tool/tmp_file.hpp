@@ -22,30 +22,77 @@
 
 #pragma once
 
-#include <fstream>
-#include <ios>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <set>
 #include <string>
 
+/// header at the start of each chunk of a temporary file. The records of the chunk immediately
+/// follow the header.
+struct tmp_file_chunk_header
+{
+    static constexpr uint64_t magic_value = 0x6b6e6863666f7270;  // "profchnk"
+
+    uint64_t magic         = magic_value;
+    uint64_t record_type   = 0;  ///< domain_type of the records
+    uint64_t record_size   = 0;  ///< sizeof the record type
+    uint64_t count         = 0;  ///< number of records in the chunk
+    uint64_t min_timestamp = 0;
+    uint64_t max_timestamp = 0;
+    uint64_t chunk_size    = 0;  ///< offset of the next chunk relative to this header
+    uint64_t reserved      = 0;
+};
+
+static_assert(sizeof(tmp_file_chunk_header) == 64, "chunk header should be 64 bytes");
+
+/// read-only memory mapping of an entire temporary file
+struct tmp_file_mapping
+{
+    tmp_file_mapping(int _fd, size_t _size);
+    ~tmp_file_mapping();
+
+    tmp_file_mapping(const tmp_file_mapping&) = delete;
+    tmp_file_mapping& operator=(const tmp_file_mapping&) = delete;
+
+    const char* data() const { return static_cast<const char*>(m_addr); }
+    size_t      size() const { return m_size; }
+
+    explicit operator bool() const { return m_addr != nullptr; }
+
+private:
+    void*  m_addr = nullptr;
+    size_t m_size = 0;
+};
+
+/// temporary file consisting of a sequence of chunks. Each chunk is written with positional
+/// writes at the end of the previous chunk so the records can be read back in place through a
+/// memory mapping of the file. Chunks may differ in size (e.g. a chunk holding a record which is
+/// larger than the ring buffer): readers walk the file using the chunk_size of each header.
 struct tmp_file
 {
     tmp_file(std::string _filename);
     ~tmp_file();
 
-    bool open(std::ios::openmode = std::ios::binary | std::ios::in | std::ios::out);
-    bool fopen(const char* = "r+");
-    bool flush();
+    bool open();
     bool close();
     bool remove();
 
+    /// writes the header followed by the records at the next chunk offset. The chunk_size is the
+    /// space reserved for this chunk (header + records + padding) and is stored in the header
+    bool write_chunk(const tmp_file_chunk_header& _header,
+                     const void*                  _records,
+                     size_t                       _records_size,
+                     size_t                       _chunk_size);
+
+    /// maps the chunks written so far. Returns nullptr if nothing has been written
+    std::shared_ptr<const tmp_file_mapping> map() const;
+
     explicit operator bool() const;
 
-    std::string              filename     = {};
-    std::string              subdirectory = {};
-    std::fstream             stream       = {};
-    FILE*                    file         = nullptr;
-    int                      fd           = -1;
-    std::set<std::streampos> file_pos     = {};
-    std::mutex               file_mutex   = {};
+    std::string filename   = {};
+    int         fd         = -1;
+    size_t      file_size  = 0;  ///< end of the data of the last chunk
+    size_t      end_offset = 0;  ///< offset of the next chunk
+    std::mutex  file_mutex = {};
 };
@@ -24,6 +24,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <utility>
 
 std::string
@@ -34,3 +35,90 @@ compose_tmp_file_name(domain_type buffer_type)
                                                  "%ppid%-%pid%",
                                                  get_domain_file_name(buffer_type)));
 }
+
+tmp_file_drainer::tmp_file_drainer()
+: m_thread{[this]() { run(); }}
+{}
+
+tmp_file_drainer::~tmp_file_drainer()
+{
+    {
+        auto _lk = std::unique_lock<std::mutex>{m_mutex};
+        m_exit   = true;
+    }
+    m_cv.notify_all();
+    if(m_thread.joinable()) m_thread.join();
+}
+
+// a domain is only registered once: a domain which was removed (i.e. its ring buffer and
+// temporary file were destroyed) keeps an empty entry so that it is never drained again
+void
+tmp_file_drainer::add(domain_type type, drain_func_t func)
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    if(std::any_of(m_funcs.begin(), m_funcs.end(), [type](const auto& itr) {
+           return itr.first == type;
+       }))
+        return;
+    m_funcs.emplace_back(type, func);
+}
+
+void
+tmp_file_drainer::remove(domain_type type)
+{
+    auto _drain_lk = std::unique_lock<std::mutex>{m_drain_mutex};
+    auto _lk       = std::unique_lock<std::mutex>{m_mutex};
+    for(auto& itr : m_funcs)
+    {
+        if(itr.first == type)
+        {
+            itr.second = nullptr;
+            return;
+        }
+    }
+    m_funcs.emplace_back(type, nullptr);
+}
+
+// invoked by the application threads: the mutex is not acquired so a wake-up may be missed, in
+// which case the records are drained once the interval expires
+void
+tmp_file_drainer::notify()
+{
+    m_pending.store(true, std::memory_order_relaxed);
+    m_cv.notify_one();
+}
+
+void
+tmp_file_drainer::run()
+{
+    auto _funcs = std::vector<std::pair<domain_type, drain_func_t>>{};
+    while(true)
+    {
+        {
+            auto _lk = std::unique_lock<std::mutex>{m_mutex};
+            m_cv.wait_for(_lk, drain_interval, [this]() { return m_exit || m_pending.load(); });
+            if(m_exit) break;
+            m_pending.store(false);
+        }
+
+        // acquired before the drain functions are copied so that a domain which is removed
+        // concurrently is never drained afterwards
+        auto _drain_lk = std::unique_lock<std::mutex>{m_drain_mutex};
+        {
+            auto _lk = std::unique_lock<std::mutex>{m_mutex};
+            _funcs   = m_funcs;
+        }
+        for(auto [type, func] : _funcs)
+        {
+            if(func) func(type);
+        }
+    }
+}
+
+tmp_file_drainer&
+get_tmp_file_drainer()
+{
+    // intentionally leaked: the thread must be available until the process exits
+    static auto* _v = new tmp_file_drainer{};
+    return *_v;
+}
@@ -24,22 +24,36 @@
 
 #include "helper.hpp"
 #include "tmp_file.hpp"
+#include "tmp_file_view.hpp"
 
 #include "lib/common/container/ring_buffer.hpp"
+#include "lib/common/container/spsc_queue.hpp"
 #include "lib/common/logging.hpp"
 #include "lib/common/units.hpp"
 
 #include <fmt/format.h>
 
-#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 template <typename Tp>
 using ring_buffer_t = rocprofiler::common::container::ring_buffer<Tp>;
 
+// ring buffer holding the encoded records of type Tp
+template <typename Tp>
+using tmp_ring_buffer_t = ring_buffer_t<tmp_file_storage_t<Tp>>;
+
 std::string
 compose_tmp_file_name(domain_type buffer_type);
 
@@ -52,63 +66,293 @@ get_tmp_file_buffer(domain_type type)
     return std::tuple(_buffer, _tmp_file);
 }
 
+// when set, a full ring buffer is passed to this handler instead of being written to the
+// temporary file. The handler takes ownership of the records and is invoked without the file
+// mutex held so it may block (e.g. on a bounded work queue).
+template <typename Tp>
+using offload_handler_t = std::function<void(std::shared_ptr<Tp>)>;
+
+template <typename Tp>
+offload_handler_t<Tp>&
+get_offload_handler(domain_type)
+{
+    static auto _v = offload_handler_t<Tp>{};
+    return _v;
+}
+
+// every chunk of a temporary file can hold a full ring buffer and starts on a page boundary
+template <typename Tp>
+size_t
+get_tmp_file_chunk_size(const Tp& _tmp_buf)
+{
+    auto _page_size = rocprofiler::common::units::get_page_size();
+    auto _size      = sizeof(tmp_file_chunk_header) + (_tmp_buf.capacity() * _tmp_buf.data_size());
+    return ((_size + _page_size - 1) / _page_size) * _page_size;
+}
+
+// appends the contents of the ring buffer holding the records of type Tp to the temporary file as
+// one chunk. The contents of the ring buffer are not consumed. The caller is responsible for
+// serializing the writes to the temporary file
 template <typename Tp>
 void
-offload_buffer(domain_type type)
+save_tmp_buffer(const tmp_ring_buffer_t<Tp>& _tmp_buf, tmp_file* _tmp_file, domain_type type)
 {
-    auto [_tmp_buf, _tmp_file]            = get_tmp_file_buffer<Tp>(type);
-    auto                         _lk      = std::lock_guard<std::mutex>(_tmp_file->file_mutex);
-    [[maybe_unused]] static auto _success = _tmp_file->open();
-    auto&                        _fs      = _tmp_file->stream;
-    _tmp_file->file_pos.emplace(_fs.tellg());
-    _tmp_buf->save(_fs);
-    _tmp_buf->clear();
-    CHECK(_tmp_buf->is_empty() == true);
+    using traits_type  = tmp_file_record_traits<Tp>;
+    using storage_type = typename traits_type::storage_type;
+
+    // the ring buffers are written without wrapping so the records are contiguous from the head
+    const auto* _data  = _tmp_buf.peek();
+    auto        _count = _tmp_buf.count();
+    if(_data == nullptr || _count == 0) return;
+
+    auto _header        = tmp_file_chunk_header{};
+    _header.record_type = static_cast<uint64_t>(type);
+    _header.record_size = sizeof(storage_type);
+    _header.count       = _count;
+
+    auto [_min, _max] = traits_type::timestamps(_data);
+    for(size_t i = traits_type::stored_size(_data); i < _count;
+        i += traits_type::stored_size(_data + i))
+    {
+        auto [_beg, _end] = traits_type::timestamps(_data + i);
+        _min              = std::min(_min, _beg);
+        _max              = std::max(_max, _end);
+    }
+    _header.min_timestamp = _min;
+    _header.max_timestamp = _max;
+
+    _tmp_file->write_chunk(
+        _header, _data, _count * sizeof(storage_type), get_tmp_file_chunk_size(_tmp_buf));
 }
 
+// passes the ring buffer to the offload handler of the domain or writes it to the temporary file
 template <typename Tp>
 void
-write_ring_buffer(Tp _v, domain_type type)
+offload_buffer(tmp_ring_buffer_t<Tp>& _buffer, domain_type type)
 {
-    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<ring_buffer_t<Tp>>(type);
-    if(_tmp_buf->capacity() == 0) return;
-    auto* ptr = _tmp_buf->request(false);
-    if(ptr == nullptr)
+    using ring_buffer_type = tmp_ring_buffer_t<Tp>;
+
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<ring_buffer_type>(type);
+    auto _lk                   = std::unique_lock<std::mutex>(_tmp_file->file_mutex);
+    auto _handler              = get_offload_handler<ring_buffer_type>(type);
+    if(!_handler)
     {
-        offload_buffer<ring_buffer_t<Tp>>(type);
-        ptr = _tmp_buf->request(false);
+        save_tmp_buffer<Tp>(_buffer, _tmp_file, type);
+        _buffer.clear();
+        return;
+    }
+
+    // swap the full buffer for an empty one and hand it off after releasing the file mutex
+    auto _full = std::make_shared<ring_buffer_type>(_buffer.capacity());
+    std::swap(*_full, _buffer);
+    _lk.unlock();
+
+    CHECK(_buffer.is_empty() == true);
+    _handler(std::move(_full));
+}
+
+template <typename Tp>
+void
+offload_buffer(domain_type type)
+{
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<tmp_ring_buffer_t<Tp>>(type);
+    offload_buffer<Tp>(*_tmp_buf, type);
+}
+
+// encodes the record at the tail of the ring buffer. An encoded record is kept contiguous: the
+// ring buffer is offloaded when the record does not fit in the remaining space and a record larger
+// than the ring buffer is offloaded on its own. The offload function must leave the ring buffer it
+// is given empty
+template <typename Tp, typename FuncT>
+void
+encode_record(Tp&& _v, tmp_ring_buffer_t<Tp>& _tmp_buf, FuncT&& _offload)
+{
+    using traits_type      = tmp_file_record_traits<Tp>;
+    using ring_buffer_type = tmp_ring_buffer_t<Tp>;
+
+    auto _n = traits_type::encoded_size(_v);
+
+    if(_n > _tmp_buf.free()) _offload(_tmp_buf);
+
+    if(_n > _tmp_buf.capacity())
+    {
+        auto _buffer = ring_buffer_type{_n};
+        auto* ptr    = _buffer.request(_n, false);
         CHECK(ptr != nullptr);
+        traits_type::encode(std::move(_v), ptr);
+        _offload(_buffer);
+        return;
     }
-    *ptr = std::move(_v);
+
+    auto* ptr = _tmp_buf.request(_n, false);
+    CHECK(ptr != nullptr);
+    traits_type::encode(std::move(_v), ptr);
 }
 
 template <typename Tp>
 void
-flush_tmp_buffer(domain_type type)
+encode_record(Tp&& _v, domain_type type)
 {
-    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<Tp>(type);
-    if(!_tmp_buf->is_empty()) offload_buffer<Tp>(type);
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<tmp_ring_buffer_t<Tp>>(type);
+    encode_record(std::move(_v), *_tmp_buf, [type](tmp_ring_buffer_t<Tp>& _buffer) {
+        offload_buffer<Tp>(_buffer, type);
+    });
 }
 
+/// background thread which periodically moves the records staged by the application threads
+/// into the ring buffer of their domain. The application threads only access the ring buffers and
+/// the temporary files when their staging buffer is full (see write_ring_buffer) or when flushing.
+class tmp_file_drainer
+{
+public:
+    using drain_func_t = void (*)(domain_type);
+
+    static constexpr auto drain_interval = std::chrono::milliseconds{10};
+
+    tmp_file_drainer();
+    ~tmp_file_drainer();
+
+    tmp_file_drainer(const tmp_file_drainer&)     = delete;
+    tmp_file_drainer(tmp_file_drainer&&) noexcept = delete;
+    tmp_file_drainer& operator=(const tmp_file_drainer&) = delete;
+    tmp_file_drainer& operator=(tmp_file_drainer&&) noexcept = delete;
+
+    void add(domain_type type, drain_func_t func);
+    // waits for a drain in progress to complete
+    void remove(domain_type type);
+    // requests a drain before the interval expires
+    void notify();
+
+private:
+    void run();
+
+    bool                                              m_exit        = false;
+    std::atomic<bool>                                 m_pending     = {false};
+    std::mutex                                        m_mutex       = {};
+    std::mutex                                        m_drain_mutex = {};
+    std::condition_variable                           m_cv          = {};
+    std::vector<std::pair<domain_type, drain_func_t>> m_funcs       = {};
+    std::thread                                       m_thread      = {};
+};
+
+tmp_file_drainer&
+get_tmp_file_drainer();
+
+// per-thread staging buffers of a record type. The buffers are owned by the registry so that the
+// records of a thread which exited are still drained. A buffer referenced only by the registry
+// belongs to a thread which exited and is released once it is empty.
 template <typename Tp>
-std::deque<Tp>
-read_tmp_file(domain_type type)
+struct thread_buffer_registry
+{
+    using queue_type = rocprofiler::common::container::spsc_queue<Tp>;
+
+    // maximum number of 64 KiB segments staged by a thread before it drains the buffers itself
+    static constexpr size_t max_segments = 16;
+
+    std::mutex                               queue_mutex = {};  // guards queues
+    std::mutex                               drain_mutex = {};  // serializes the consumers
+    std::vector<std::shared_ptr<queue_type>> queues      = {};
+};
+
+template <typename Tp>
+thread_buffer_registry<Tp>&
+get_thread_buffer_registry()
 {
-    auto _data = std::deque<Tp>{};
+    static auto* _v = new thread_buffer_registry<Tp>{};
+    return *_v;
+}
 
-    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<Tp>(type);
-    auto  _lk                  = std::lock_guard<std::mutex>{_tmp_file->file_mutex};
-    auto& _fs                  = _tmp_file->stream;
-    if(_fs.is_open()) _fs.close();
-    _tmp_file->open(std::ios::binary | std::ios::in);
-    for(auto itr : _tmp_file->file_pos)
+// moves the records staged by all the threads into the ring buffer, offloading the ring buffer
+// when it is full. When flushing, the remaining records of the ring buffer are offloaded as well.
+// The records of a thread keep their order but the buffers are drained one thread after the
+// other: records of different threads are not ordered relative to each other within a domain and
+// consumers which need a global order sort the records by timestamp
+template <typename Tp>
+void
+drain_thread_buffers(domain_type type, bool flush)
+{
+    using queue_type = typename thread_buffer_registry<Tp>::queue_type;
+
+    auto& _registry = get_thread_buffer_registry<Tp>();
+    auto  _drain_lk = std::lock_guard<std::mutex>{_registry.drain_mutex};
+    auto  _queues   = std::vector<std::shared_ptr<queue_type>>{};
     {
-        _fs.seekg(itr);  // set to the absolute position
-        if(_fs.eof()) break;
-        Tp _buffer;
-        _buffer.load(_fs);
-        _data.emplace_back(std::move(_buffer));
+        auto _lk = std::lock_guard<std::mutex>{_registry.queue_mutex};
+        _queues  = _registry.queues;
     }
 
-    return _data;
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<tmp_ring_buffer_t<Tp>>(type);
+    if(_tmp_buf->capacity() == 0) return;
+
+    for(auto& itr : _queues)
+        itr->consume([type](Tp& _v) { encode_record(std::move(_v), type); });
+    _queues.clear();
+
+    {
+        auto _lk = std::lock_guard<std::mutex>{_registry.queue_mutex};
+        _registry.queues.erase(std::remove_if(_registry.queues.begin(),
+                                              _registry.queues.end(),
+                                              [](const auto& itr) {
+                                                  return itr.use_count() == 1 && itr->empty();
+                                              }),
+                               _registry.queues.end());
+    }
+
+    if(flush && !_tmp_buf->is_empty()) offload_buffer<Tp>(type);
+}
+
+template <typename Tp>
+void
+drain_thread_buffers(domain_type type)
+{
+    drain_thread_buffers<Tp>(type, false);
+}
+
+template <typename Tp>
+auto&
+get_thread_buffer(domain_type type)
+{
+    static thread_local auto _v = [type]() {
+        auto& _registry = get_thread_buffer_registry<Tp>();
+        auto  _queue    = std::make_shared<typename thread_buffer_registry<Tp>::queue_type>(
+            thread_buffer_registry<Tp>::max_segments);
+        {
+            auto _lk = std::lock_guard<std::mutex>{_registry.queue_mutex};
+            _registry.queues.emplace_back(_queue);
+        }
+        static auto _once = (get_tmp_file_drainer().add(type, &drain_thread_buffers<Tp>), true);
+        (void) _once;
+        return _queue;
+    }();
+    return *_v;
+}
+
+// stages the record in the buffer of the calling thread. The record is moved into the ring buffer
+// by the drainer. When the drainer falls behind and the buffer of the calling thread is full, the
+// calling thread drains the buffers itself instead of growing its buffer without bound
+template <typename Tp>
+void
+write_ring_buffer(Tp _v, domain_type type)
+{
+    auto& _queue = get_thread_buffer<Tp>(type);
+    if(ROCPROFILER_UNLIKELY(_queue.full())) drain_thread_buffers<Tp>(type);
+    if(_queue.push(std::move(_v))) get_tmp_file_drainer().notify();
+}
+
+template <typename Tp>
+void
+flush_tmp_buffer(domain_type type)
+{
+    drain_thread_buffers<Tp>(type, true);
+}
+
+// maps the temporary file and returns a view of the records in the chunks. The ring buffer must
+// be flushed beforehand
+template <typename Tp>
+tmp_file_view<Tp>
+read_tmp_file(domain_type type)
+{
+    auto [_tmp_buf, _tmp_file] = get_tmp_file_buffer<tmp_ring_buffer_t<Tp>>(type);
+    auto _lk                   = std::lock_guard<std::mutex>{_tmp_file->file_mutex};
+    return make_tmp_file_view<Tp>(*_tmp_file, static_cast<uint64_t>(type));
 }
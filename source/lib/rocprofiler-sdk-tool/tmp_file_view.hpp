@@ -0,0 +1,271 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "tmp_file.hpp"
+
+#include "lib/common/logging.hpp"
+
+#include <cereal/cereal.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// describes how the records of type Tp are stored in the ring buffers and the temporary files.
+/// By default, a record is stored as is in one storage element. Variable-length records
+/// specialize the traits to be encoded in a sequence of storage elements. An encoded record is
+/// always contiguous: it never straddles two chunks of a temporary file.
+template <typename Tp>
+struct tmp_file_record_traits
+{
+    using storage_type = Tp;
+
+    // number of storage elements required to encode the record
+    static size_t encoded_size(const Tp&) { return 1; }
+
+    // number of storage elements of the record encoded at the address
+    static size_t stored_size(const storage_type*) { return 1; }
+
+    static void encode(Tp&& _v, storage_type* _dst) { *_dst = std::move(_v); }
+
+    // returns the record encoded at the address. The second argument is the storage for records
+    // which have to be decoded
+    static const Tp& decode(const storage_type* _src, Tp&) { return *_src; }
+
+    static std::pair<uint64_t, uint64_t> timestamps(const storage_type* _src)
+    {
+        return {_src->start_timestamp, _src->end_timestamp};
+    }
+};
+
+template <typename Tp>
+using tmp_file_storage_t = typename tmp_file_record_traits<Tp>::storage_type;
+
+/// read-only view of the records of one type in a temporary file. The records are accessed in
+/// place through the memory mapping of the file, i.e. they are never copied out of the chunks
+/// unless they have to be decoded (see tmp_file_record_traits).
+template <typename Tp>
+class tmp_file_view
+{
+public:
+    using value_type      = Tp;
+    using size_type       = size_t;
+    using reference       = const Tp&;
+    using const_reference = const Tp&;
+    using traits_type     = tmp_file_record_traits<Tp>;
+    using storage_type    = typename traits_type::storage_type;
+    using mapping_ptr_t   = std::shared_ptr<const tmp_file_mapping>;
+
+    static constexpr bool is_encoded_v = !std::is_same<storage_type, Tp>::value;
+
+    // count is the number of storage elements in the chunk
+    struct chunk
+    {
+        const storage_type* data          = nullptr;
+        size_t              count         = 0;
+        uint64_t            min_timestamp = 0;
+        uint64_t            max_timestamp = 0;
+    };
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Tp;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Tp*;
+        using reference         = const Tp&;
+
+        const_iterator() = default;
+        const_iterator(const chunk* _chunk, const chunk* _end)
+        : m_chunk{_chunk}
+        , m_end{_end}
+        {
+            skip_empty();
+        }
+
+        reference operator*() const
+        {
+            return traits_type::decode(m_chunk->data + m_index, m_value);
+        }
+        pointer operator->() const { return &(**this); }
+
+        const_iterator& operator++()
+        {
+            m_index += traits_type::stored_size(m_chunk->data + m_index);
+            if(m_index >= m_chunk->count)
+            {
+                ++m_chunk;
+                m_index = 0;
+                skip_empty();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto _v = *this;
+            ++(*this);
+            return _v;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return (lhs.m_chunk == rhs.m_chunk && lhs.m_index == rhs.m_index);
+        }
+
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        void skip_empty()
+        {
+            while(m_chunk != m_end && m_chunk->count == 0)
+                ++m_chunk;
+        }
+
+        const chunk* m_chunk = nullptr;
+        const chunk* m_end   = nullptr;
+        size_t       m_index = 0;
+        mutable Tp   m_value = {};  // decoded record
+    };
+
+    using iterator = const_iterator;
+
+    tmp_file_view() = default;
+    tmp_file_view(mapping_ptr_t _mapping, std::vector<chunk>&& _chunks);
+
+    const_iterator begin() const { return const_iterator{m_chunks.data(), chunks_end()}; }
+    const_iterator end() const { return const_iterator{chunks_end(), chunks_end()}; }
+
+    size_t size() const { return m_size; }
+    bool   empty() const { return (m_size == 0); }
+    void   clear();
+
+    const std::vector<chunk>& chunks() const { return m_chunks; }
+
+private:
+    const chunk* chunks_end() const { return m_chunks.data() + m_chunks.size(); }
+
+    mapping_ptr_t      m_mapping = {};
+    std::vector<chunk> m_chunks  = {};
+    size_t             m_size    = 0;
+};
+
+template <typename Tp>
+tmp_file_view<Tp>::tmp_file_view(mapping_ptr_t _mapping, std::vector<chunk>&& _chunks)
+: m_mapping{std::move(_mapping)}
+, m_chunks{std::move(_chunks)}
+{
+    for(const auto& itr : m_chunks)
+    {
+        if constexpr(is_encoded_v)
+        {
+            for(size_t i = 0; i < itr.count; i += traits_type::stored_size(itr.data + i))
+                ++m_size;
+        }
+        else
+        {
+            m_size += itr.count;
+        }
+    }
+}
+
+template <typename Tp>
+void
+tmp_file_view<Tp>::clear()
+{
+    m_chunks.clear();
+    m_size = 0;
+    m_mapping.reset();
+}
+
+/// maps the temporary file and returns a view of the records of type Tp in its chunks. The chunks
+/// are located via the chunk_size of each header so chunks of different sizes are supported.
+/// Writes to the temporary file must be serialized with this call
+template <typename Tp>
+tmp_file_view<Tp>
+make_tmp_file_view(const tmp_file& _tmp_file, uint64_t _record_type)
+{
+    using view_type    = tmp_file_view<Tp>;
+    using storage_type = typename view_type::storage_type;
+
+    auto _mapping = _tmp_file.map();
+    if(!_mapping) return view_type{};
+
+    auto _chunks = std::vector<typename view_type::chunk>{};
+    for(size_t _offset = 0; _offset + sizeof(tmp_file_chunk_header) <= _mapping->size();)
+    {
+        const auto* _header =
+            reinterpret_cast<const tmp_file_chunk_header*>(_mapping->data() + _offset);
+        auto _data_size = sizeof(tmp_file_chunk_header) + (_header->count * sizeof(storage_type));
+
+        // the location of the next chunk is unknown when the header is corrupted
+        if(_header->magic != tmp_file_chunk_header::magic_value ||
+           _header->chunk_size < _data_size || _offset + _data_size > _mapping->size())
+        {
+            ROCP_ERROR << "invalid chunk at offset " << _offset << " of temporary file "
+                       << _tmp_file.filename;
+            break;
+        }
+
+        if(_header->record_type == _record_type && _header->record_size == sizeof(storage_type))
+        {
+            _chunks.emplace_back(typename view_type::chunk{
+                reinterpret_cast<const storage_type*>(_mapping->data() + _offset +
+                                                    sizeof(tmp_file_chunk_header)),
+                _header->count,
+                _header->min_timestamp,
+                _header->max_timestamp});
+        }
+        else
+        {
+            ROCP_ERROR << "unexpected record type in chunk at offset " << _offset
+                       << " of temporary file " << _tmp_file.filename;
+        }
+
+        _offset += _header->chunk_size;
+    }
+
+    return view_type{std::move(_mapping), std::move(_chunks)};
+}
+
+namespace cereal
+{
+// serialized identically to a sequence container
+template <typename ArchiveT, typename Tp>
+void
+save(ArchiveT& ar, const tmp_file_view<Tp>& data)
+{
+    ar(make_size_tag(static_cast<size_type>(data.size())));
+    for(const auto& itr : data)
+        ar(itr);
+}
+}  // namespace cereal
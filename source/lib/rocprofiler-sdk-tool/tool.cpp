@@ -30,6 +30,9 @@
 #include "generatePerfetto.hpp"
 #include "helper.hpp"
 #include "output_file.hpp"
+#include "output_index.hpp"
+#include "streaming_output.hpp"
+#include "task_pool.hpp"
 #include "tmp_file.hpp"
 
 #include "lib/common/environment.hpp"
@@ -59,6 +62,7 @@
 #include <csignal>
 #include <cstring>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <mutex>
 #include <optional>
@@ -1043,24 +1047,17 @@ counter_record_callback(rocprofiler_profile_counting_dispatch_data_t dispatch_da
     ROCP_ERROR_IF(record_count == 0) << "zero record count for kernel_id=" << kernel_id
                                      << " (name=" << kernel_info->kernel_name << ")";
 
+    counter_record.records.reserve(record_count);
     for(size_t count = 0; count < record_count; count++)
     {
-        // Unlikely to trigger, temporary until we move to buffered callbacks
-        if(count >= counter_record.records.size())
-        {
-            ROCP_WARNING << "Exceeded maximum counter capacity, skipping remaining";
-            break;
-        }
-
         auto _counter_id = rocprofiler_counter_id_t{};
         ROCPROFILER_CALL(rocprofiler_query_record_counter_id(record_data[count].id, &_counter_id),
                          "query record counter id");
-        counter_record.records[count] =
-            rocprofiler_tool_record_counter_t{_counter_id, record_data[count]};
-        counter_record.counter_count++;
+        counter_record.records.emplace_back(
+            rocprofiler_tool_record_counter_t{_counter_id, record_data[count]});
     }
 
-    write_ring_buffer(counter_record, domain_type::COUNTER_COLLECTION);
+    write_ring_buffer(std::move(counter_record), domain_type::COUNTER_COLLECTION);
 }
 
 rocprofiler_status_t
@@ -1242,6 +1239,50 @@ fini_tool_table()
     *tool_functions = tool_table{};
 }
 
+template <typename Tp, domain_type DomainT>
+rocprofiler::tool::streaming_output<Tp, DomainT>*&
+get_streaming_output()
+{
+    static rocprofiler::tool::streaming_output<Tp, DomainT>* _v = nullptr;
+    return _v;
+}
+
+template <typename OutputT>
+void
+start_streaming_output(bool _enabled)
+{
+    using value_type        = typename OutputT::value_type;
+    constexpr auto domain_v = OutputT::buffer_type_v;
+
+    if(!_enabled) return;
+
+    // the records are only retained in the temporary file when another output format needs them
+    const auto& _cfg  = tool::get_config();
+    auto        _keep = (_cfg.json_output || _cfg.pftrace_output || _cfg.otf2_output);
+
+    using streaming_output_t = rocprofiler::tool::streaming_output<value_type, domain_v>;
+
+    auto*& _v = get_streaming_output<value_type, domain_v>();
+    if(!_v) _v = new streaming_output_t{tool_functions, _keep};
+}
+
+void
+start_streaming_outputs()
+{
+    const auto& _cfg = tool::get_config();
+
+    start_streaming_output<kernel_dispatch_buffered_output_t>(_cfg.kernel_trace);
+    start_streaming_output<hsa_buffered_output_t>(
+        _cfg.hsa_core_api_trace || _cfg.hsa_amd_ext_api_trace || _cfg.hsa_image_ext_api_trace ||
+        _cfg.hsa_finalizer_ext_api_trace);
+    start_streaming_output<hip_buffered_output_t>(_cfg.hip_runtime_api_trace ||
+                                                  _cfg.hip_compiler_api_trace);
+    start_streaming_output<memory_copy_buffered_output_t>(_cfg.memory_copy_trace);
+    start_streaming_output<marker_buffered_output_t>(_cfg.marker_api_trace);
+    start_streaming_output<counter_collection_buffered_output_t>(_cfg.counter_collection);
+    start_streaming_output<scratch_memory_buffered_output_t>(_cfg.scratch_memory);
+}
+
 int
 tool_init(rocprofiler_client_finalize_t fini_func, void* tool_data)
 {
@@ -1254,6 +1295,9 @@ tool_init(rocprofiler_client_finalize_t fini_func, void* tool_data)
 
     init_tool_table();
 
+    if(tool::get_config().streaming_output && tool::get_config().csv_output)
+        start_streaming_outputs();
+
     ROCPROFILER_CALL(rocprofiler_create_context(&get_client_ctx()), "create context failed");
 
     auto code_obj_ctx = rocprofiler_context_id_t{};
@@ -1500,21 +1544,58 @@ api_registration_callback(rocprofiler_intercept_table_t,
                      "Iterate rocporfiler agents")
 }
 
-using stats_data_t = ::rocprofiler::tool::stats_data_t;
+using stats_data_t     = ::rocprofiler::tool::stats_data_t;
+using contributions_t  = common::Synchronized<std::unordered_map<domain_type, stats_data_t>>;
+using output_futures_t = std::vector<std::shared_future<void>>;
 
+// submits the tasks which read the records of the domain back from the temporary file and write
+// the CSV output of the domain. The future of the read is appended to read_v so that the other
+// output formats can wait for the records.
 template <typename Tp, domain_type DomainT>
 void
-generate_output(rocprofiler::tool::buffered_output<Tp, DomainT>& output_v,
-                std::unordered_map<domain_type, stats_data_t>&   contributions_v)
+generate_output(rocprofiler::tool::task_pool&                    pool_v,
+                rocprofiler::tool::buffered_output<Tp, DomainT>& output_v,
+                contributions_t&                                 contributions_v,
+                output_futures_t&                                read_v,
+                output_futures_t&                                tasks_v)
 {
     if(!output_v) return;
 
-    output_v.read();
+    if(auto*& _streaming = get_streaming_output<Tp, DomainT>(); _streaming)
+    {
+        // the CSV rows were written as the ring buffers were offloaded so only the tail of the
+        // ring buffer remains to be processed before the statistics are written
+        auto _read = pool_v.submit([&output_v, &contributions_v, &_streaming]() {
+            output_v.flush();
+            output_v.stats = _streaming->finalize();
+            contributions_v.wlock([&output_v](auto& _data) {
+                _data.emplace(output_v.buffer_type_v, output_v.stats);
+            });
+
+            delete _streaming;
+            _streaming = nullptr;
+
+            const auto& _cfg = tool::get_config();
+            if(_cfg.json_output || _cfg.pftrace_output || _cfg.otf2_output) output_v.read();
+        });
+        read_v.emplace_back(_read);
+        tasks_v.emplace_back(_read);
+        return;
+    }
+
+    auto _read = pool_v.submit([&output_v]() { output_v.read(); });
+    read_v.emplace_back(_read);
+    tasks_v.emplace_back(_read);
 
     if(tool::get_config().csv_output)
     {
-        output_v.stats = rocprofiler::tool::generate_csv(tool_functions, output_v.element_data);
-        contributions_v.emplace(output_v.buffer_type_v, output_v.stats);
+        tasks_v.emplace_back(pool_v.submit([&output_v, &contributions_v, _read]() {
+            _read.get();
+            output_v.stats = rocprofiler::tool::generate_csv(tool_functions, output_v.element_data);
+            contributions_v.wlock([&output_v](auto& _data) {
+                _data.emplace(output_v.buffer_type_v, output_v.stats);
+            });
+        }));
     }
 }
 
@@ -1561,60 +1642,104 @@ tool_fini(void* /*tool_data*/)
         rocprofiler::tool::generate_csv(tool_functions, _agents);
     }
 
-    auto contributions = std::unordered_map<domain_type, stats_data_t>{};
-
-    generate_output(kernel_dispatch_output, contributions);
-    generate_output(hsa_output, contributions);
-    generate_output(hip_output, contributions);
-    generate_output(memory_copy_output, contributions);
-    generate_output(marker_output, contributions);
-    generate_output(counters_output, contributions);
-    generate_output(scratch_memory_output, contributions);
-
-    if(tool::get_config().stats && tool::get_config().csv_output)
+    // the domains are read back and written to the CSV files concurrently. The JSON, perfetto, and
+    // OTF2 outputs wait for all the domains to be read and are then written concurrently with the
+    // remaining CSV outputs. Tasks only wait on tasks submitted before them (see task_pool).
+    auto _pool         = rocprofiler::tool::task_pool{tool::get_config().output_threads};
+    auto contributions = contributions_t{};
+    auto _read         = output_futures_t{};
+    auto _tasks        = output_futures_t{};
+
+    generate_output(_pool, kernel_dispatch_output, contributions, _read, _tasks);
+    generate_output(_pool, hsa_output, contributions, _read, _tasks);
+    generate_output(_pool, hip_output, contributions, _read, _tasks);
+    generate_output(_pool, memory_copy_output, contributions, _read, _tasks);
+    generate_output(_pool, marker_output, contributions, _read, _tasks);
+    generate_output(_pool, counters_output, contributions, _read, _tasks);
+    generate_output(_pool, scratch_memory_output, contributions, _read, _tasks);
+
+    // symbols and track locations shared by the JSON, perfetto, and OTF2 outputs
+    const auto& _cfg         = tool::get_config();
+    auto        _index       = rocprofiler::tool::output_index{};
+    auto        _index_ready = std::shared_future<void>{};
+    if(_cfg.json_output || _cfg.pftrace_output || _cfg.otf2_output)
     {
-        rocprofiler::tool::generate_csv(tool_functions, contributions);
+        _index_ready = _pool.submit([&]() {
+            for(const auto& itr : _read)
+                itr.get();
+            _index = rocprofiler::tool::build_output_index(_agents,
+                                                           &hip_output.element_data,
+                                                           &hsa_output.element_data,
+                                                           &kernel_dispatch_output.element_data,
+                                                           &memory_copy_output.element_data,
+                                                           &marker_output.element_data);
+        });
+        _tasks.emplace_back(_index_ready);
     }
 
     if(tool::get_config().json_output)
     {
-        rocprofiler::tool::write_json(tool_functions,
-                                      getpid(),
-                                      _agents,
-                                      _counters,
-                                      &hip_output.element_data,
-                                      &hsa_output.element_data,
-                                      &kernel_dispatch_output.element_data,
-                                      &memory_copy_output.element_data,
-                                      &counters_output.element_data,
-                                      &marker_output.element_data,
-                                      &scratch_memory_output.element_data);
+        _tasks.emplace_back(_pool.submit([&]() {
+            _index_ready.get();
+            rocprofiler::tool::write_json(tool_functions,
+                                          getpid(),
+                                          _agents,
+                                          _counters,
+                                          _index,
+                                          &hip_output.element_data,
+                                          &hsa_output.element_data,
+                                          &kernel_dispatch_output.element_data,
+                                          &memory_copy_output.element_data,
+                                          &counters_output.element_data,
+                                          &marker_output.element_data,
+                                          &scratch_memory_output.element_data);
+        }));
     }
 
     if(tool::get_config().pftrace_output)
     {
-        rocprofiler::tool::write_perfetto(tool_functions,
+        _tasks.emplace_back(_pool.submit([&]() {
+            _index_ready.get();
+            rocprofiler::tool::write_perfetto(tool_functions,
+                                              getpid(),
+                                              _index,
+                                              &hip_output.element_data,
+                                              &hsa_output.element_data,
+                                              &kernel_dispatch_output.element_data,
+                                              &memory_copy_output.element_data,
+                                              &marker_output.element_data,
+                                              &scratch_memory_output.element_data);
+        }));
+    }
+
+    if(tool::get_config().otf2_output)
+    {
+        _tasks.emplace_back(_pool.submit([&]() {
+            _index_ready.get();
+            rocprofiler::tool::write_otf2(tool_functions,
                                           getpid(),
                                           _agents,
+                                          _index,
                                           &hip_output.element_data,
                                           &hsa_output.element_data,
                                           &kernel_dispatch_output.element_data,
                                           &memory_copy_output.element_data,
                                           &marker_output.element_data,
                                           &scratch_memory_output.element_data);
+        }));
     }
 
-    if(tool::get_config().otf2_output)
+    // all the tasks reference the outputs so every task must complete before an exception of a
+    // task is rethrown
+    for(const auto& itr : _tasks)
+        itr.wait();
+    for(const auto& itr : _tasks)
+        itr.get();
+
+    if(tool::get_config().stats && tool::get_config().csv_output)
     {
-        rocprofiler::tool::write_otf2(tool_functions,
-                                      getpid(),
-                                      _agents,
-                                      &hip_output.element_data,
-                                      &hsa_output.element_data,
-                                      &kernel_dispatch_output.element_data,
-                                      &memory_copy_output.element_data,
-                                      &marker_output.element_data,
-                                      &scratch_memory_output.element_data);
+        contributions.wlock(
+            [](auto& _data) { rocprofiler::tool::generate_csv(tool_functions, _data); });
     }
 
     auto destroy_output = [](auto& _buffered_output_v) { _buffered_output_v.destroy(); };
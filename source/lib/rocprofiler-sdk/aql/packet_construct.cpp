@@ -22,10 +22,14 @@
 
 #include "lib/rocprofiler-sdk/aql/packet_construct.hpp"
 #include "lib/common/logging.hpp"
+#include "lib/rocprofiler-sdk/counters/id_decode.hpp"
 #include "lib/rocprofiler-sdk/hsa/details/fmt.hpp"
 
 #include <fmt/core.h>
 #include <hsa/hsa_ext_amd.h>
+
+#include <algorithm>
+#include <iterator>
 #include "glog/logging.h"
 #include "rocprofiler-sdk/fwd.h"
 
@@ -91,6 +95,68 @@ CounterPacketConstruct::CounterPacketConstruct(rocprofiler_agent_id_t
         }
     }
     _events = get_all_events();
+    build_sample_decode_table();
+}
+
+void
+CounterPacketConstruct::build_sample_decode_table()
+{
+    auto  aql_agent = *CHECK_NOTNULL(rocprofiler::agent::get_aql_agent(_agent));
+    auto& table     = _decode_table;
+
+    table.events.reserve(_events.size());
+    for(const auto& event : _events)
+    {
+        auto& entry  = table.events.emplace_back();
+        entry.event  = event;
+        entry.offset = table.instance_ids.size();
+
+        const auto* metric = event_to_metric(event);
+        if(!metric) continue;
+
+        auto slot = std::find_if(table.slots.begin(), table.slots.end(), [metric](const auto& itr) {
+            return itr.metric_id == metric->id();
+        });
+        entry.slot = std::distance(table.slots.begin(), slot);
+        if(slot == table.slots.end())
+            table.slots.emplace_back(SampleDecodeTable::slot_entry{metric->id(), 0});
+
+        // the number of samples of the event is the product of the extents of its dimensions
+        auto dims   = std::map<int, uint64_t>{};
+        auto nsamp  = size_t{1};
+        auto status = get_dim_info(_agent, event, 0, dims);
+        if(status != ROCPROFILER_STATUS_SUCCESS) continue;
+        for(const auto& [id, extent] : dims)
+            nsamp *= std::max<uint64_t>(extent, 1);
+
+        for(size_t i = 0; i < nsamp; ++i)
+        {
+            auto instance_id = rocprofiler_counter_instance_id_t{0};
+            counters::set_counter_in_rec(instance_id, {.handle = metric->id()});
+            // samples which cannot be precomputed are decoded when they are read
+            if(set_dim_id_from_sample(instance_id, aql_agent, event, i) !=
+               ROCPROFILER_STATUS_SUCCESS)
+                break;
+            table.instance_ids.emplace_back(instance_id);
+            ++entry.count;
+        }
+        table.slots.at(entry.slot).samples += entry.count;
+    }
+}
+
+const SampleDecodeTable::event_entry*
+SampleDecodeTable::find(const aqlprofile_pmc_event_t& event, size_t& cursor) const
+{
+    for(size_t i = 0; i < events.size(); ++i)
+    {
+        auto idx = (cursor + i) % events.size();
+        if(events[idx].event == event)
+        {
+            cursor = idx;
+            return &events[idx];
+        }
+    }
+    return nullptr;
 }
 
 std::unique_ptr<hsa::CounterAQLPacket>
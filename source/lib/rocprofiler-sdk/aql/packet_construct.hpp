@@ -35,6 +35,7 @@
 #include <hsa/hsa_ven_amd_aqlprofile.h>
 
 #include <functional>
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -60,6 +61,38 @@ namespace rocprofiler
 {
 namespace aql
 {
+/**
+ * Maps the (event, sample index) pairs reported by aqlprofile to the output slot (metric) and the
+ * packed instance id of the sample. The mapping only depends on the agent and the metrics so it is
+ * computed once by CounterPacketConstruct instead of for every sample of every packet.
+ */
+struct SampleDecodeTable
+{
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct event_entry
+    {
+        aqlprofile_pmc_event_t event  = {};
+        size_t                 slot   = npos;  // index in slots, npos if the event has no metric
+        size_t                 offset = 0;     // index of the first sample in instance_ids
+        size_t                 count  = 0;     // number of precomputed samples
+    };
+
+    struct slot_entry
+    {
+        uint64_t metric_id = 0;
+        size_t   samples   = 0;  // expected number of samples of the metric
+    };
+
+    // returns the entry of the event. The samples are reported in the order of the events so the
+    // search starts at the event of the previous sample (cursor)
+    const event_entry* find(const aqlprofile_pmc_event_t& event, size_t& cursor) const;
+
+    std::vector<event_entry>                       events       = {};
+    std::vector<slot_entry>                        slots        = {};
+    std::vector<rocprofiler_counter_instance_id_t> instance_ids = {};
+};
+
 /**
  * Class to construct AQL Packets for a specific agent and metric set.
  * Thie class checks that the counters supplied are collectable on the
@@ -82,6 +115,8 @@ public:
 
     rocprofiler_agent_id_t agent() const { return _agent; }
 
+    const SampleDecodeTable& get_sample_decode_table() const { return _decode_table; }
+
     rocprofiler_status_t can_collect();
 
 private:
@@ -89,6 +124,8 @@ private:
     static constexpr size_t MEM_PAGE_MASK  = MEM_PAGE_ALIGN - 1;
     static size_t getPageAligned(size_t p) { return (p + MEM_PAGE_MASK) & ~MEM_PAGE_MASK; }
 
+    void build_sample_decode_table();
+
 protected:
     struct AQLProfileMetric
     {
@@ -101,6 +138,7 @@ protected:
     std::vector<AQLProfileMetric>                      _metrics;
     std::vector<aqlprofile_pmc_event_t>                _events;
     std::map<aqlprofile_pmc_event_t, counters::Metric> _event_to_metric;
+    SampleDecodeTable                                  _decode_table;
 };
 
 class ThreadTraceAQLPacketFactory
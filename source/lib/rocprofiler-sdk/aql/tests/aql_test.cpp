@@ -21,7 +21,9 @@
 // SOFTWARE.
 
 #include "lib/rocprofiler-sdk/agent.hpp"
+#include "lib/rocprofiler-sdk/aql/helpers.hpp"
 #include "lib/rocprofiler-sdk/aql/packet_construct.hpp"
+#include "lib/rocprofiler-sdk/counters/id_decode.hpp"
 #include "lib/rocprofiler-sdk/counters/metrics.hpp"
 #include "lib/rocprofiler-sdk/counters/tests/hsa_tables.hpp"
 #include "lib/rocprofiler-sdk/hsa/agent_cache.hpp"
@@ -183,6 +185,47 @@ TEST(aql_profile, packet_generation_multi)
     hsa_shut_down();
 }
 
+TEST(aql_profile, sample_decode_table)
+{
+    ASSERT_EQ(hsa_init(), HSA_STATUS_SUCCESS);
+    rocprofiler::test_init();
+
+    auto agents = rocprofiler::hsa::get_queue_controller()->get_supported_agents();
+    ASSERT_GT(agents.size(), 0);
+    for(const auto& [_, agent] : agents)
+    {
+        auto metrics =
+            rocprofiler::findDeviceMetrics(agent, {"SQ_WAVES", "TA_FLAT_READ_WAVEFRONTS"});
+        CounterPacketConstruct pkt(agent.get_rocp_agent()->id, metrics);
+        const auto&            table = pkt.get_sample_decode_table();
+        auto aql_agent = *CHECK_NOTNULL(rocprofiler::agent::get_aql_agent(pkt.agent()));
+
+        EXPECT_EQ(table.events.size(), pkt.get_all_events().size());
+        EXPECT_EQ(table.slots.size(), metrics.size());
+
+        // the precomputed instance ids match the ids decoded from aqlprofile
+        for(const auto& entry : table.events)
+        {
+            ASSERT_NE(entry.slot, SampleDecodeTable::npos);
+            EXPECT_GT(entry.count, 0);
+            for(size_t i = 0; i < entry.count; ++i)
+            {
+                auto expected = rocprofiler_counter_instance_id_t{0};
+                rocprofiler::counters::set_counter_in_rec(
+                    expected, {.handle = table.slots.at(entry.slot).metric_id});
+                EXPECT_EQ(set_dim_id_from_sample(expected, aql_agent, entry.event, i),
+                          ROCPROFILER_STATUS_SUCCESS);
+                EXPECT_EQ(table.instance_ids.at(entry.offset + i), expected);
+            }
+
+            size_t cursor = 0;
+            EXPECT_EQ(table.find(entry.event, cursor), &entry);
+        }
+    }
+
+    hsa_shut_down();
+}
+
 /*
 class TestAqlPacket : public rocprofiler::hsa::CounterAQLPacket
 {
@@ -253,6 +253,10 @@ rocprofiler_create_buffer(rocprofiler_context_id_t        context,
     auto& buff = CHECK_NOTNULL(rocprofiler::buffer::get_buffers())
                      ->at(opt_buff_id->handle - rocprofiler::buffer::get_buffer_offset());
 
+    // emplace is invoked from every traced thread so do not serialize writers on a mutex
+    for(auto& itr : buff->buffers)
+        itr.set_sync_mode(rocprofiler::buffer::instance::buffer_t::sync_mode::lock_free);
+
     // allocate the buffers. if it is lossless, we allocate a second buffer to store data while
     // other buffer is being flushed
     buff->buffers.front().allocate(size);
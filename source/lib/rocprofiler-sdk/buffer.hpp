@@ -57,6 +57,12 @@ struct instance
     template <typename Tp>
     bool emplace(uint32_t, uint32_t, Tp&);
 
+    /// emplace the records of the range with one reservation per internal buffer. When the
+    /// buffer fills up in the middle of the range, the remainder of the range is dropped or, for
+    /// lossless buffers, placed after the buffer is flushed. Returns the number of records placed
+    template <typename Tp>
+    size_t emplace_range(uint32_t, uint32_t, const Tp*, size_t);
+
     buffer_t& get_internal_buffer();
     buffer_t& get_internal_buffer(size_t);
 };
@@ -155,3 +161,54 @@ rocprofiler::buffer::instance::emplace(uint32_t category, uint32_t kind, Tp& val
 
     return success;
 }
+
+template <typename Tp>
+inline size_t
+rocprofiler::buffer::instance::emplace_range(uint32_t  category,
+                                             uint32_t  kind,
+                                             const Tp* values,
+                                             size_t    num_values)
+{
+    // get the index of the current buffer
+    auto get_idx = [this]() { return buffer_idx.load(std::memory_order_acquire) % buffers.size(); };
+
+    auto   idx    = get_idx();
+    size_t placed = 0;
+    while(placed < num_values)
+    {
+        auto n =
+            buffers.at(idx).emplace_range(category, kind, values + placed, num_values - placed);
+        placed += n;
+
+        if(n > 0) continue;
+
+        if(buffers.at(idx).capacity() < sizeof(Tp))
+        {
+            auto msg = std::stringstream{};
+            msg << "buffer " << buffer_id << " to small (size=" << buffers.at(idx).capacity()
+                << ") to hold an object of type " << common::cxx_demangle(typeid(Tp).name())
+                << " with size " << sizeof(Tp);
+            throw std::runtime_error(msg.str());
+        }
+
+        if(policy == ROCPROFILER_BUFFER_POLICY_LOSSLESS)
+        {
+            // blocks until buffer is flushed
+            buffer::flush(buffer_id, true);
+            idx = get_idx();
+        }
+        else
+        {
+            drop_count += (num_values - placed);
+            break;
+        }
+    }
+
+    if(buffers.at(idx).count() >= watermark)
+    {
+        // flush without syncing
+        buffer::flush(buffer_id, false);
+    }
+
+    return placed;
+}
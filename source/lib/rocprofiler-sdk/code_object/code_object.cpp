@@ -21,6 +21,7 @@
 // THE SOFTWARE.
 
 #include "lib/rocprofiler-sdk/code_object/code_object.hpp"
+#include "lib/common/memory/epoch.hpp"
 #include "lib/common/scope_destructor.hpp"
 #include "lib/common/static_object.hpp"
 #include "lib/common/string_entry.hpp"
@@ -40,9 +41,11 @@
 #include <hsa/hsa_api_trace.h>
 #include <hsa/hsa_ven_amd_loader.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <regex>
 #include <string_view>
 #include <utility>
@@ -54,9 +57,8 @@ namespace code_object
 {
 namespace
 {
-using context_t              = context::context;
-using context_array_t        = common::container::small_vector<const context_t*>;
-using external_corr_id_map_t = std::unordered_map<const context_t*, rocprofiler_user_data_t>;
+using context_t       = context::context;
+using context_array_t = common::container::small_vector<const context_t*>;
 
 template <size_t OpIdx>
 struct code_object_info;
@@ -357,9 +359,21 @@ get_kernel_symbol_id()
 }
 
 using kernel_object_map_t        = std::unordered_map<uint64_t, uint64_t>;
+using kernel_object_snapshot_t   = std::vector<std::pair<uint64_t, uint64_t>>;
 using executable_array_t         = std::vector<hsa_executable_t>;
 using code_object_unload_array_t = std::vector<hsa::code_object_unload>;
 
+// read-only copy of the kernel object map (sorted by kernel object) which is looked up for every
+// dispatch without taking a lock. A new snapshot is published when executables are frozen or
+// destroyed and the replaced snapshot is released once no dispatch can still be reading it.
+// Leaked so that the snapshot remains valid during finalization
+auto&
+get_kernel_object_snapshot()
+{
+    static auto* _v = new common::memory::epoch_ptr<kernel_object_snapshot_t>{};
+    return *_v;
+}
+
 std::vector<hsa::code_object_unload>
 shutdown(hsa_executable_t executable);
 
@@ -388,6 +402,16 @@ get_kernel_object_map()
     return _v;
 }
 
+void
+publish_kernel_object_snapshot(const kernel_object_map_t& object_map)
+{
+    auto _snapshot =
+        std::make_unique<kernel_object_snapshot_t>(object_map.begin(), object_map.end());
+    std::sort(_snapshot->begin(), _snapshot->end());
+
+    get_kernel_object_snapshot().publish(std::move(_snapshot));
+}
+
 hsa_status_t
 executable_iterate_agent_symbols_load_callback(hsa_executable_t        executable,
                                                hsa_agent_t             agent,
@@ -741,6 +765,12 @@ executable_freeze(hsa_executable_t executable, const char* options)
             executable, code_object_load_callback, &_vec);
     });
 
+    // the kernels of the executable cannot be dispatched before it is frozen so the kernel
+    // symbols are only made visible to get_kernel_id once all of them are registered
+    CHECK_NOTNULL(get_kernel_object_map())->wlock([](kernel_object_map_t& object_map) {
+        publish_kernel_object_snapshot(object_map);
+    });
+
     constexpr auto CODE_OBJECT_KIND = ROCPROFILER_CALLBACK_TRACING_CODE_OBJECT;
     constexpr auto CODE_OBJECT_LOAD = ROCPROFILER_CODE_OBJECT_LOAD;
     constexpr auto CODE_OBJECT_KERNEL_SYMBOL =
@@ -838,14 +868,15 @@ executable_destroy(hsa_executable_t executable)
 
     if(get_kernel_object_map())
     {
-        CHECK_NOTNULL(get_kernel_object_map())->wlock([_unloaded](kernel_object_map_t& data) {
+        CHECK_NOTNULL(get_kernel_object_map())->wlock([&_unloaded](kernel_object_map_t& data) {
             for(const auto& uitr : _unloaded)
             {
                 for(const auto& sitr : uitr.symbols)
                 {
-                    data.erase(sitr->rocp_data.kernel_id);
+                    data.erase(sitr->rocp_data.kernel_object);
                 }
             }
+            publish_kernel_object_snapshot(data);
         });
     }
 
@@ -983,13 +1014,16 @@ initialize(HsaApiTable* table)
 uint64_t
 get_kernel_id(uint64_t kernel_object)
 {
-    return CHECK_NOTNULL(get_kernel_object_map())
-        ->rlock(
-            [](const kernel_object_map_t& object_map, uint64_t _kern_obj) -> uint64_t {
-                auto itr = object_map.find(_kern_obj);
-                return (itr == object_map.end()) ? 0 : itr->second;
-            },
-            kernel_object);
+    // lock-free: the snapshot is immutable once published and the guard keeps it alive
+    auto        _guard    = common::memory::epoch_guard{};
+    const auto* _snapshot = get_kernel_object_snapshot().load();
+    if(!_snapshot) return 0;
+
+    auto itr = std::lower_bound(_snapshot->begin(),
+                                _snapshot->end(),
+                                kernel_object,
+                                [](const auto& lhs, uint64_t rhs) { return lhs.first < rhs; });
+    return (itr == _snapshot->end() || itr->first != kernel_object) ? 0 : itr->second;
 }
 
 void
@@ -26,6 +26,8 @@
 
 #include "lib/common/container/small_vector.hpp"
 #include "lib/common/container/stable_vector.hpp"
+#include "lib/common/defines.hpp"
+#include "lib/common/memory/epoch.hpp"
 #include "lib/common/static_object.hpp"
 #include "lib/common/synchronized.hpp"
 #include "lib/common/utility.hpp"
@@ -38,11 +40,11 @@
 #include <unistd.h>
 #include <atomic>
 #include <cstddef>
-#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <random>
+#include <utility>
 
 namespace rocprofiler
 {
@@ -103,8 +105,80 @@ get_active_contexts_impl()
     static auto* _v = new active_context_vec_t{reserve_size_t{active_context_vec_t::chunk_size}};
     return *_v;
 }
+
+auto&
+get_active_tracing_snapshot_impl()
+{
+    // leaked so that the snapshot remains valid during finalization
+    static auto* _v = new common::memory::epoch_ptr<active_tracing_snapshot>{};
+    return *_v;
+}
+
+template <typename DomainT>
+void
+merge_domains(domain_context<DomainT>& _dst, const domain_context<DomainT>& _src)
+{
+    _dst.domains |= _src.domains;
+    for(size_t i = 0; i < _src.opcodes.size(); ++i)
+    {
+        if((_src.domains & (uint64_t{1} << i)) == 0) continue;
+
+        // no opcodes means all the operations in the domain are enabled
+        if(_src.opcodes.at(i).none())
+            _dst.opcodes.at(i).set();
+        else
+            _dst.opcodes.at(i) |= _src.opcodes.at(i);
+    }
+}
+
+// the contexts mutex must be held when this is invoked
+void
+update_active_tracing_snapshot_impl()
+{
+    static auto _epoch = uint64_t{0};
+
+    auto _snapshot   = std::make_unique<active_tracing_snapshot>();
+    _snapshot->epoch = ++_epoch;
+
+    for(auto& itr : get_active_contexts_impl())
+    {
+        const auto* ctx = itr.load(std::memory_order_acquire);
+        if(!ctx || (!ctx->callback_tracer && !ctx->buffered_tracer)) continue;
+
+        _snapshot->contexts.emplace_back(ctx);
+        if(ctx->callback_tracer)
+            merge_domains(_snapshot->callback_domains, ctx->callback_tracer->domains);
+        if(ctx->buffered_tracer)
+            merge_domains(_snapshot->buffered_domains, ctx->buffered_tracer->domains);
+    }
+
+    get_active_tracing_snapshot_impl().publish(std::move(_snapshot));
+}
 }  // namespace
 
+active_tracing_snapshot_ref::active_tracing_snapshot_ref()
+: m_snapshot{get_active_tracing_snapshot_impl().load()}
+{
+    if(ROCPROFILER_UNLIKELY(!m_snapshot))
+    {
+        update_active_tracing_snapshot();
+        m_snapshot = get_active_tracing_snapshot_impl().load();
+    }
+}
+
+active_tracing_snapshot_ref
+get_active_tracing_snapshot()
+{
+    return active_tracing_snapshot_ref{};
+}
+
+void
+update_active_tracing_snapshot()
+{
+    auto _lk = std::unique_lock<std::mutex>{get_contexts_mutex()};
+    update_active_tracing_snapshot_impl();
+}
+
 context_array_t&
 get_registered_contexts(context_array_t& data, context_filter_t filter)
 {
@@ -318,6 +392,8 @@ start_context(rocprofiler_context_id_t context_id)
         return ROCPROFILER_STATUS_ERROR_CONTEXT_NOT_STARTED;
     }
 
+    update_active_tracing_snapshot();
+
     auto status = ROCPROFILER_STATUS_SUCCESS;
 
     if(cfg->counter_collection) rocprofiler::counters::start_context(cfg);
@@ -351,6 +427,8 @@ stop_context(rocprofiler_context_id_t idx)
                 auto nactive = get_num_active_contexts().load(std::memory_order_acquire);
                 if(nactive > 0) get_num_active_contexts().fetch_sub(1, std::memory_order_release);
 
+                update_active_tracing_snapshot_impl();
+
                 if(_expected->counter_collection)
                 {
                     rocprofiler::counters::stop_context(const_cast<context*>(_expected));
@@ -410,6 +488,8 @@ deactivate_client_contexts(rocprofiler_client_id_t client_id)
             itr.store(nullptr);
         }
     }
+
+    update_active_tracing_snapshot();
 }
 
 void
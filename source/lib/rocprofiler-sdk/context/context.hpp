@@ -27,6 +27,7 @@
 #include <rocprofiler-sdk/rocprofiler.h>
 
 #include "lib/common/container/small_vector.hpp"
+#include "lib/common/memory/epoch.hpp"
 #include "lib/common/synchronized.hpp"
 #include "lib/rocprofiler-sdk/context/correlation_id.hpp"
 #include "lib/rocprofiler-sdk/context/domain.hpp"
@@ -194,6 +195,52 @@ get_active_contexts(context_array_t& data, context_filter_t filter = default_con
 context_array_t
 get_active_contexts(context_filter_t filter = default_context_filter);
 
+/// @brief immutable view of the active contexts which have a callback and/or buffered tracing
+/// service. A new snapshot is published (with an incremented epoch) whenever the set of active
+/// contexts changes so the hot path of the tracing wrappers only requires an atomic load and a
+/// bitset test to determine whether an operation is traced by any active context.
+struct active_tracing_snapshot
+{
+    using callback_domain_t = domain_context<rocprofiler_callback_tracing_kind_t>;
+    using buffered_domain_t = domain_context<rocprofiler_buffer_tracing_kind_t>;
+
+    uint64_t          epoch            = 0;
+    context_array_t   contexts         = {};  // active contexts with callback/buffered tracer
+    callback_domain_t callback_domains = {};  // union of domains + ops of callback tracers
+    buffered_domain_t buffered_domains = {};  // union of domains + ops of buffered tracers
+};
+
+/// @brief reference to the latest published snapshot. Superseded snapshots are released once no
+/// thread holds a reference to them so a reference should only be held for the duration of the
+/// operation being traced. Never references a nullptr
+struct active_tracing_snapshot_ref
+{
+    active_tracing_snapshot_ref();
+    ~active_tracing_snapshot_ref() = default;
+
+    active_tracing_snapshot_ref(const active_tracing_snapshot_ref&)     = delete;
+    active_tracing_snapshot_ref(active_tracing_snapshot_ref&&) noexcept = delete;
+    active_tracing_snapshot_ref& operator=(const active_tracing_snapshot_ref&) = delete;
+    active_tracing_snapshot_ref& operator=(active_tracing_snapshot_ref&&) noexcept = delete;
+
+    const active_tracing_snapshot* get() const { return m_snapshot; }
+    const active_tracing_snapshot* operator->() const { return m_snapshot; }
+    const active_tracing_snapshot& operator*() const { return *m_snapshot; }
+
+private:
+    common::memory::epoch_guard    m_guard    = {};
+    const active_tracing_snapshot* m_snapshot = nullptr;
+};
+
+/// returns a reference to the latest published snapshot
+active_tracing_snapshot_ref
+get_active_tracing_snapshot();
+
+/// regenerates the active tracing snapshot. Invoked when contexts are started/stopped and when
+/// the tracing services are locked after client initialization
+void
+update_active_tracing_snapshot();
+
 /// \brief disable the contexturation.
 rocprofiler_status_t
 stop_client_contexts(rocprofiler_client_id_t id);
@@ -28,20 +28,181 @@
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace rocprofiler
 {
 namespace context
 {
+/// @brief per-thread free-list of correlation ids. The owning thread pops from and pushes to
+/// the local list without synchronization. Correlation ids retired on other threads (e.g. the
+/// kernel completion thread) are pushed onto the lock-free remote list, which the owning thread
+/// reclaims in bulk when the local list is exhausted. When a thread exits, its pool is orphaned
+/// and adopted by the next new thread so memory stays bounded by the peak number of
+/// in-flight correlation ids. Correlation ids constructed after the pool of the thread has been
+/// orphaned (i.e. later in thread-local teardown) are unpooled and deleted when retired.
+struct correlation_id_pool
+{
+    correlation_id* acquire();
+    void            release(correlation_id*);
+
+    static void reset(correlation_id*, uint32_t, rocprofiler_thread_id_t, uint64_t);
+
+private:
+    correlation_id*              m_local  = nullptr;
+    std::atomic<correlation_id*> m_remote = {nullptr};
+};
+
 namespace
 {
+// correlation ids are allocated in slabs which are never released until finalization
+constexpr size_t correlation_id_slab_size = 512;
+
+using correlation_id_slab_t = std::array<correlation_id, correlation_id_slab_size>;
+
+struct correlation_id_allocator
+{
+    std::vector<std::unique_ptr<correlation_id_slab_t>> slabs   = {};
+    std::vector<std::unique_ptr<correlation_id_pool>>   pools   = {};
+    std::vector<correlation_id_pool*>                   orphans = {};
+};
+
 auto*&
-get_correlation_id_map()
+get_correlation_id_allocator()
 {
-    using data_type  = common::container::stable_vector<std::unique_ptr<correlation_id>>;
+    using data_type  = correlation_id_allocator;
     static auto*& _v = common::static_object<common::Synchronized<data_type>>::construct();
     return _v;
 }
 
+// pool owned by the current thread. This is a trivially destructible thread-local so it is safe
+// to read on any thread and during thread-local teardown (when it is cleared)
+thread_local correlation_id_pool* current_correlation_id_pool = nullptr;
+
+// set when the pool owner of the current thread is destroyed. Trivially destructible for the
+// same reason: the owner itself must not be accessed after its destructor has run
+thread_local bool correlation_id_pool_orphaned = false;
+
+correlation_id_pool*
+get_correlation_id_pool();
+}  // namespace
+
+void
+correlation_id_pool::reset(correlation_id*         _corr_id,
+                           uint32_t                _cnt,
+                           rocprofiler_thread_id_t _tid,
+                           uint64_t                _internal)
+{
+    _corr_id->thread_idx = _tid;
+    _corr_id->internal   = _internal;
+    _corr_id->m_next     = nullptr;
+    _corr_id->m_kern_count.store(0, std::memory_order_relaxed);
+    _corr_id->m_ref_count.store(_cnt, std::memory_order_release);
+}
+
+correlation_id*
+correlation_id_pool::acquire()
+{
+    if(!m_local) m_local = m_remote.exchange(nullptr, std::memory_order_acquire);
+
+    if(!m_local)
+    {
+        auto* _allocator = get_correlation_id_allocator();
+        if(!_allocator) return nullptr;
+
+        auto* _slab = _allocator->wlock([](auto& _data) {
+            return _data.slabs.emplace_back(std::make_unique<correlation_id_slab_t>()).get();
+        });
+
+        for(auto& itr : *_slab)
+        {
+            itr.m_pool = this;
+            itr.m_next = m_local;
+            m_local    = &itr;
+        }
+    }
+
+    auto* _ret = m_local;
+    m_local    = _ret->m_next;
+    return _ret;
+}
+
+void
+correlation_id_pool::release(correlation_id* _corr_id)
+{
+    if(current_correlation_id_pool == this)
+    {
+        _corr_id->m_next = m_local;
+        m_local          = _corr_id;
+        return;
+    }
+
+    // only the owning thread removes entries and it takes the entire list so this push is not
+    // susceptible to the ABA problem
+    auto* _head = m_remote.load(std::memory_order_relaxed);
+    do
+    {
+        _corr_id->m_next = _head;
+    } while(!m_remote.compare_exchange_weak(
+        _head, _corr_id, std::memory_order_release, std::memory_order_relaxed));
+}
+
+namespace
+{
+// thread-local handle which adopts an orphaned pool (or creates a new one) and
+// orphans the pool when the thread exits
+struct correlation_id_pool_owner
+{
+    correlation_id_pool_owner();
+    ~correlation_id_pool_owner();
+
+    correlation_id_pool* pool = nullptr;
+};
+
+correlation_id_pool_owner::correlation_id_pool_owner()
+{
+    auto* _allocator = get_correlation_id_allocator();
+    if(!_allocator) return;
+
+    pool = _allocator->wlock([](auto& _data) {
+        if(!_data.orphans.empty())
+        {
+            auto* _ret = _data.orphans.back();
+            _data.orphans.pop_back();
+            return _ret;
+        }
+        return _data.pools.emplace_back(std::make_unique<correlation_id_pool>()).get();
+    });
+
+    current_correlation_id_pool = pool;
+}
+
+correlation_id_pool_owner::~correlation_id_pool_owner()
+{
+    // correlation ids retired from here on (including the rest of thread-local teardown) are
+    // pushed onto the remote list of the pool which created them
+    current_correlation_id_pool  = nullptr;
+    correlation_id_pool_orphaned = true;
+
+    auto* _allocator = get_correlation_id_allocator();
+    if(!_allocator || !pool) return;
+
+    _allocator->wlock([this](auto& _data) { _data.orphans.emplace_back(pool); });
+    pool = nullptr;
+}
+
+correlation_id_pool*
+get_correlation_id_pool()
+{
+    if(correlation_id_pool_orphaned) return nullptr;
+
+    static thread_local auto _v = correlation_id_pool_owner{};
+    return _v.pool;
+}
+
 auto&
 get_latest_correlation_id_impl()
 {
@@ -76,33 +237,37 @@ correlation_id::sub_ref_count()
 
     if(_ret == 1)
     {
-        auto ctxs = get_active_contexts([](const context* ctx) {
-            return (ctx->buffered_tracer &&
-                    (ctx->buffered_tracer->domains(
-                        ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT)));
-        });
+        constexpr auto retirement_kind = ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT;
 
-        auto record = rocprofiler_buffer_tracing_correlation_id_retirement_record_t{
-            .size      = sizeof(rocprofiler_buffer_tracing_correlation_id_retirement_record_t),
-            .kind      = ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT,
-            .timestamp = common::timestamp_ns(),
-            .internal_correlation_id = internal};
-
-        if(!ctxs.empty())
+        const auto snapshot = get_active_tracing_snapshot();
+        if(snapshot->buffered_domains(retirement_kind))
         {
-            for(const auto* itr : ctxs)
+            auto record = rocprofiler_buffer_tracing_correlation_id_retirement_record_t{
+                .size      = sizeof(rocprofiler_buffer_tracing_correlation_id_retirement_record_t),
+                .kind      = retirement_kind,
+                .timestamp = common::timestamp_ns(),
+                .internal_correlation_id = internal};
+
+            for(const auto* itr : snapshot->contexts)
             {
-                auto* _buffer = buffer::get_buffer(itr->buffered_tracer->buffer_data.at(
-                    ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT));
+                if(!itr->buffered_tracer || !itr->buffered_tracer->domains(retirement_kind))
+                    continue;
+
+                auto* _buffer =
+                    buffer::get_buffer(itr->buffered_tracer->buffer_data.at(retirement_kind));
 
                 auto success = CHECK_NOTNULL(_buffer)->emplace(
-                    ROCPROFILER_BUFFER_CATEGORY_TRACING,
-                    ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT,
-                    record);
+                    ROCPROFILER_BUFFER_CATEGORY_TRACING, retirement_kind, record);
 
                 ROCP_FATAL_IF(!success) << "failed to emplace correlation id retirement";
             }
         }
+
+        // no more references so this correlation id can be reused (or deleted if unpooled)
+        if(m_pool)
+            m_pool->release(this);
+        else
+            delete this;
     }
 
     return _ret;
@@ -125,15 +290,18 @@ correlation_tracing_service::construct(uint32_t _init_ref_count)
 {
     ROCP_FATAL_IF(_init_ref_count == 0) << "must have reference count > 0";
 
-    auto  _internal_id = get_unique_internal_id();
-    auto* corr_id_map  = get_correlation_id_map();
-    if(!corr_id_map) return nullptr;
-    auto& ret = corr_id_map->wlock([](auto& data) -> auto& { return data.emplace_back(); });
-    ret       = std::make_unique<correlation_id>(_init_ref_count, common::get_tid(), _internal_id);
+    auto* _pool = get_correlation_id_pool();
+    auto* ret   = (_pool) ? _pool->acquire() : nullptr;
+
+    // no pool during thread-local teardown or after finalization: callers never expect nullptr
+    // so fall back to an unpooled correlation id
+    if(!ret) ret = new correlation_id{};
+
+    correlation_id_pool::reset(ret, _init_ref_count, common::get_tid(), get_unique_internal_id());
 
-    get_latest_correlation_id_impl().emplace_back(ret.get());
+    get_latest_correlation_id_impl().emplace_back(ret);
 
-    return ret.get();
+    return ret;
 }
 
 correlation_id*
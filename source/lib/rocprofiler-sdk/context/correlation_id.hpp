@@ -35,6 +35,8 @@ namespace rocprofiler
 {
 namespace context
 {
+struct correlation_id_pool;
+
 struct correlation_id
 {
     // reference count starts at 5:
@@ -72,8 +74,12 @@ struct correlation_id
     uint32_t sub_kern_count();
 
 private:
+    friend struct correlation_id_pool;
+
     std::atomic<uint32_t> m_kern_count = {0};
     std::atomic<uint32_t> m_ref_count  = {0};
+    correlation_id_pool*  m_pool       = nullptr;  // pool to return to when retired
+    correlation_id*       m_next       = nullptr;  // free-list link while in the pool
 };
 
 correlation_id*
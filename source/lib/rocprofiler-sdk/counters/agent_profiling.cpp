@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "lib/rocprofiler-sdk/counters/agent_profiling.hpp"
+#include "lib/common/container/small_vector.hpp"
 #include "lib/common/logging.hpp"
 #include "lib/rocprofiler-sdk/buffer.hpp"
 #include "lib/rocprofiler-sdk/context/context.hpp"
@@ -139,17 +140,14 @@ agent_async_handler(hsa_signal_value_t /*signal_v*/, void* data)
     }
 
     // Write out the AQL data to the buffer
-    for(auto& ast : prof_config->asts)
+    common::container::small_vector<rocprofiler_record_counter_t, 128> out;
+    for(const auto& ast : prof_config->compiled_asts)
+        ast.evaluate(decoded_pkt, out);
+
+    for(auto& val : out)
     {
-        std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
-        auto* ret = CHECK_NOTNULL(ast.evaluate(decoded_pkt, cache));
-        ast.set_out_id(*ret);
-        for(auto& val : *ret)
-        {
-            val.user_data = callback_data.user_data;
-            buf->emplace(
-                ROCPROFILER_BUFFER_CATEGORY_COUNTERS, ROCPROFILER_COUNTER_RECORD_VALUE, val);
-        }
+        val.user_data = callback_data.user_data;
+        buf->emplace(ROCPROFILER_BUFFER_CATEGORY_COUNTERS, ROCPROFILER_COUNTER_RECORD_VALUE, val);
     }
 
     // reset the signal to allow another sample to start
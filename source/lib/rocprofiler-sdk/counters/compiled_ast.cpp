@@ -0,0 +1,232 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/counters/compiled_ast.hpp"
+
+#include "lib/common/logging.hpp"
+#include "lib/common/utility.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace rocprofiler
+{
+namespace counters
+{
+namespace
+{
+constexpr auto add_op      = [](double a, double b) { return a + b; };
+constexpr auto subtract_op = [](double a, double b) { return a - b; };
+constexpr auto multiply_op = [](double a, double b) { return a * b; };
+constexpr auto divide_op   = [](double a, double b) { return (b == 0 ? 0 : a / b); };
+
+constexpr auto reduce_min_op = [](auto beg, auto end) { return *std::min_element(beg, end); };
+constexpr auto reduce_max_op = [](auto beg, auto end) { return *std::max_element(beg, end); };
+constexpr auto reduce_sum_op = [](auto beg, auto end) { return std::accumulate(beg, end, 0.0); };
+constexpr auto reduce_avg_op = [](auto beg, auto end) {
+    return std::accumulate(beg, end, 0.0) / std::distance(beg, end);
+};
+
+// the operands are combined element-wise or, if one of the operands has a single instance, the
+// single instance is combined with every instance of the other operand. The output instances
+// take the ids of the larger operand
+template <typename RegisterT, typename OpT>
+void
+apply_binary_op(RegisterT& lhs, const RegisterT& rhs, OpT&& op)
+{
+    CHECK(!lhs.values.empty() && !rhs.values.empty());
+
+    auto*       _lhs  = lhs.values.data();
+    const auto* _rhs  = rhs.values.data();
+    auto        _size = lhs.values.size();
+
+    if(_size == rhs.values.size())
+    {
+        for(size_t i = 0; i < _size; ++i)
+            _lhs[i] = op(_lhs[i], _rhs[i]);
+    }
+    else if(rhs.values.size() == 1)
+    {
+        const auto _b = _rhs[0];
+        for(size_t i = 0; i < _size; ++i)
+            _lhs[i] = op(_lhs[i], _b);
+    }
+    else if(_size == 1)
+    {
+        const auto _a = _lhs[0];
+        _size         = rhs.values.size();
+        lhs.values.resize(_size);
+        lhs.ids = rhs.ids;
+        _lhs    = lhs.values.data();
+        for(size_t i = 0; i < _size; ++i)
+            _lhs[i] = op(_a, _rhs[i]);
+    }
+    else
+    {
+        throw std::runtime_error(
+            fmt::format("Mismatched Sizes {}, {}", lhs.values.size(), rhs.values.size()));
+    }
+}
+
+template <typename RegisterT, typename OpT>
+void
+apply_reduction(RegisterT& reg, OpT&& op)
+{
+    if(reg.values.empty()) return;
+
+    auto _result = op(reg.values.begin(), reg.values.end());
+    reg.values.assign(1, _result);
+    reg.ids = nullptr;
+}
+}  // namespace
+
+CompiledAST::CompiledAST(const EvaluateAST& ast)
+: m_out_id{ast.out_id()}
+{
+    m_num_instances = 1;
+    for(const auto& itr : ast.dimension_types())
+        m_num_instances *= std::max<uint64_t>(itr.size(), 1);
+
+    compile(ast, 0);
+}
+
+void
+CompiledAST::compile(const EvaluateAST& ast, uint32_t depth)
+{
+    m_num_registers = std::max(m_num_registers, depth + 1);
+
+    // the operands of an instruction are emitted before the instruction: the first operand
+    // is evaluated into the register of the instruction and the second operand into the next
+    switch(ast.type())
+    {
+        case NUMBER_NODE:
+        {
+            m_instructions.emplace_back(
+                instruction{.op = opcode::constant, .dst = depth, .value = ast.raw_value()});
+        }
+        break;
+        case ACCUMULATE_NODE:
+        case REFERENCE_NODE:
+        {
+            m_instructions.emplace_back(
+                instruction{.op = opcode::load, .dst = depth, .metric_id = ast.metric().id()});
+        }
+        break;
+        case ADDITION_NODE:
+        case SUBTRACTION_NODE:
+        case MULTIPLY_NODE:
+        case DIVIDE_NODE:
+        {
+            auto _op = opcode::add;
+            if(ast.type() == SUBTRACTION_NODE)
+                _op = opcode::subtract;
+            else if(ast.type() == MULTIPLY_NODE)
+                _op = opcode::multiply;
+            else if(ast.type() == DIVIDE_NODE)
+                _op = opcode::divide;
+
+            compile(ast.children().at(0), depth);
+            compile(ast.children().at(1), depth + 1);
+            m_instructions.emplace_back(instruction{.op = _op, .dst = depth, .src = depth + 1});
+        }
+        break;
+        case REDUCE_NODE:
+        {
+            auto _op = opcode::reduce_sum;
+            switch(ast.reduce_op())
+            {
+                case REDUCE_MIN: _op = opcode::reduce_min; break;
+                case REDUCE_MAX: _op = opcode::reduce_max; break;
+                case REDUCE_SUM: _op = opcode::reduce_sum; break;
+                case REDUCE_AVG: _op = opcode::reduce_avg; break;
+                case REDUCE_NONE:
+                    throw std::runtime_error(
+                        fmt::format("Invalid Second argument to reduce(): {}",
+                                    static_cast<int>(ast.reduce_op())));
+            }
+
+            compile(ast.children().at(0), depth);
+            m_instructions.emplace_back(instruction{.op = _op, .dst = depth});
+        }
+        break;
+        case NONE:
+        case RANGE_NODE:
+        case CONSTANT_NODE:
+        case SELECT_NODE:
+            throw std::runtime_error(fmt::format("Unsupported node type {} in the expression of {}",
+                                                 static_cast<int>(ast.type()),
+                                                 ast.metric().name()));
+    }
+}
+
+const CompiledAST::register_data&
+CompiledAST::execute(const results_map_t& results_map) const
+{
+    // registers are shared by all the compiled ASTs evaluated on a thread and keep their
+    // capacity so evaluation does not allocate once the registers have grown
+    static thread_local auto _registers = std::vector<register_data>{};
+    if(_registers.size() < m_num_registers) _registers.resize(m_num_registers);
+
+    for(const auto& itr : m_instructions)
+    {
+        auto& _dst = _registers[itr.dst];
+        if(_dst.values.capacity() < m_num_instances) _dst.values.reserve(m_num_instances);
+
+        switch(itr.op)
+        {
+            case opcode::load:
+            {
+                const auto* _input = rocprofiler::common::get_val(results_map, itr.metric_id);
+                if(!_input)
+                    throw std::runtime_error(
+                        fmt::format("Unable to lookup results for metric {}", itr.metric_id));
+
+                _dst.values.resize(_input->size());
+                for(size_t i = 0; i < _input->size(); ++i)
+                    _dst.values[i] = (*_input)[i].counter_value;
+                _dst.ids = _input->data();
+            }
+            break;
+            case opcode::constant:
+            {
+                _dst.values.assign(1, itr.value);
+                _dst.ids = nullptr;
+            }
+            break;
+            case opcode::add: apply_binary_op(_dst, _registers[itr.src], add_op); break;
+            case opcode::subtract: apply_binary_op(_dst, _registers[itr.src], subtract_op); break;
+            case opcode::multiply: apply_binary_op(_dst, _registers[itr.src], multiply_op); break;
+            case opcode::divide: apply_binary_op(_dst, _registers[itr.src], divide_op); break;
+            case opcode::reduce_min: apply_reduction(_dst, reduce_min_op); break;
+            case opcode::reduce_max: apply_reduction(_dst, reduce_max_op); break;
+            case opcode::reduce_sum: apply_reduction(_dst, reduce_sum_op); break;
+            case opcode::reduce_avg: apply_reduction(_dst, reduce_avg_op); break;
+        }
+    }
+
+    return _registers.front();
+}
+}  // namespace counters
+}  // namespace rocprofiler
@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
+#include "lib/rocprofiler-sdk/counters/id_decode.hpp"
+
+#include <rocprofiler-sdk/fwd.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace counters
+{
+/**
+ * @brief Flattened form of an (expanded) EvaluateAST. The AST is compiled once into a list of
+ *        instructions operating on registers of contiguous doubles so that evaluating the AST
+ *        for every completed dispatch does not recurse over the AST or allocate intermediate
+ *        result vectors. The registers are allocated stack-wise: the result of an instruction
+ *        at depth N is stored in register N.
+ */
+class CompiledAST
+{
+public:
+    using results_map_t = std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>;
+
+    /**
+     * @brief Compile an AST. The AST must have been expanded (see EvaluateAST::expand_derived)
+     *        and its dimensions set. Throws if the AST contains nodes which cannot be evaluated.
+     */
+    explicit CompiledAST(const EvaluateAST& ast);
+
+    /**
+     * @brief Evaluate the AST on the results decoded from the AQL packet (and the special
+     *        counters) and append the output records (with the output id of the AST set) to
+     *        out. Unlike EvaluateAST::evaluate, the results map is not modified.
+     */
+    template <typename ContainerT>
+    void evaluate(const results_map_t& results_map, ContainerT& out) const;
+
+    const rocprofiler_counter_id_t& out_id() const { return m_out_id; }
+    size_t                          num_instructions() const { return m_instructions.size(); }
+    size_t                          num_registers() const { return m_num_registers; }
+
+private:
+    enum class opcode : uint8_t
+    {
+        load = 0,
+        constant,
+        add,
+        subtract,
+        multiply,
+        divide,
+        reduce_min,
+        reduce_max,
+        reduce_sum,
+        reduce_avg,
+    };
+
+    struct instruction
+    {
+        opcode   op        = opcode::load;
+        uint32_t dst       = 0;
+        uint32_t src       = 0;  // second operand (the first operand is dst)
+        uint64_t metric_id = 0;
+        double   value     = 0.0;
+    };
+
+    // values of the instances and the input records which provide the instance ids. Registers
+    // without input records (constants, reductions) use an instance id of zero
+    struct register_data
+    {
+        std::vector<double>                 values = {};
+        const rocprofiler_record_counter_t* ids    = nullptr;
+    };
+
+    void compile(const EvaluateAST& ast, uint32_t depth);
+
+    // runs the instructions and returns the register which holds the result
+    const register_data& execute(const results_map_t& results_map) const;
+
+    std::vector<instruction> m_instructions  = {};
+    uint32_t                 m_num_registers = 0;
+    size_t                   m_num_instances = 0;
+    rocprofiler_counter_id_t m_out_id        = {.handle = 0};
+};
+
+template <typename ContainerT>
+void
+CompiledAST::evaluate(const results_map_t& results_map, ContainerT& out) const
+{
+    const auto& _result = execute(results_map);
+
+    out.reserve(out.size() + _result.values.size());
+    for(size_t i = 0; i < _result.values.size(); ++i)
+    {
+        auto& _record = out.emplace_back(rocprofiler_record_counter_t{
+            .id            = (_result.ids) ? _result.ids[i].id : 0,
+            .counter_value = _result.values[i],
+            .dispatch_id   = 0,
+            .user_data     = {.value = 0}});
+        set_counter_in_rec(_record.id, m_out_id);
+    }
+}
+}  // namespace counters
+}  // namespace rocprofiler
@@ -25,6 +25,7 @@
 
 #include "lib/common/synchronized.hpp"
 #include "lib/rocprofiler-sdk/aql/packet_construct.hpp"
+#include "lib/rocprofiler-sdk/counters/compiled_ast.hpp"
 #include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
 #include "lib/rocprofiler-sdk/counters/metrics.hpp"
 
@@ -54,6 +55,8 @@ struct profile_config
     std::set<counters::Metric> required_special_counters{};
     // ASTs to evaluate
     std::vector<counters::EvaluateAST> asts{};
+    // ASTs compiled for evaluation (one per AST above)
+    std::vector<counters::CompiledAST> compiled_asts{};
     rocprofiler_profile_config_id_t    id{.handle = 0};
     // Packet generator to create AQL packets for insertion
     std::unique_ptr<rocprofiler::aql::CounterPacketConstruct> pkt_generator{nullptr};
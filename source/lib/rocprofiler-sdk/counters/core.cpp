@@ -101,6 +101,16 @@ counter_callback_info::setup_profile_config(std::shared_ptr<profile_config>& pro
                        << " " << e.what();
             return ROCPROFILER_STATUS_ERROR_AST_NOT_FOUND;
         }
+
+        try
+        {
+            config.compiled_asts.emplace_back(config.asts.back());
+        } catch(std::runtime_error& e)
+        {
+            ROCP_ERROR << metric.name() << " could not be compiled"
+                       << " " << e.what();
+            return ROCPROFILER_STATUS_ERROR_AST_GENERATION_FAILED;
+        }
     }
 
     profile->pkt_generator = std::make_unique<rocprofiler::aql::CounterPacketConstruct>(
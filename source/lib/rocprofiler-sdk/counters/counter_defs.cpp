@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/counters/counter_defs.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace counters
+{
+namespace counter_defs
+{
+namespace
+{
+RawAST*
+make_raw_ast(const table& _table, uint32_t _idx)
+{
+    const auto& _node = _table.nodes[_idx];
+
+    auto _children = std::vector<RawAST*>{};
+    _children.reserve(_node.children_size);
+    for(uint32_t i = 0; i < _node.children_size; ++i)
+        _children.emplace_back(make_raw_ast(_table, _table.children[_node.children + i]));
+
+    auto* _ast          = new RawAST(static_cast<NodeType>(_node.type), std::move(_children));
+    _ast->reduce_op     = std::string{_node.reduce_op};
+    _ast->accumulate_op = static_cast<ACCUMULATE_OP_TYPE>(_node.accumulate_op);
+
+    switch(_node.kind)
+    {
+        case value_kind::none: break;
+        case value_kind::string: _ast->value = std::string{_node.string_value}; break;
+        case value_kind::integer: _ast->value = _node.integer_value; break;
+    }
+
+    for(uint32_t i = 0; i < _node.reduce_size; ++i)
+        _ast->reduce_dimension_set.emplace(static_cast<rocprofiler_profile_counter_instance_types>(
+            _table.reduce_dimensions[_node.reduce_dims + i]));
+
+    for(uint32_t i = 0; i < _node.select_size; ++i)
+    {
+        const auto& _dim = _table.select_dimensions[_node.select_dims + i];
+        _ast->select_dimension_set.emplace(
+            static_cast<rocprofiler_profile_counter_instance_types>(_dim.dimension), _dim.index);
+    }
+
+    if(_node.range >= 0) _ast->range = make_raw_ast(_table, _node.range);
+
+    return _ast;
+}
+}  // namespace
+
+std::unique_ptr<RawAST>
+get_raw_ast(std::string_view expr)
+{
+    const auto& _table = get_table();
+    const auto* _beg   = _table.expressions;
+    const auto* _end   = _table.expressions + _table.expressions_size;
+    const auto* _itr   = std::lower_bound(_beg, _end, expr, [](const expression& lhs, auto rhs) {
+        return lhs.text < rhs;
+    });
+
+    if(_itr == _end || _itr->text != expr) return nullptr;
+    return std::unique_ptr<RawAST>{make_raw_ast(_table, _itr->root)};
+}
+}  // namespace counter_defs
+}  // namespace counters
+}  // namespace rocprofiler
@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "lib/rocprofiler-sdk/counters/parser/raw_ast.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace rocprofiler
+{
+namespace counters
+{
+/**
+ * The contents of counter_defs.yaml, compiled into the library at build time by
+ * rocprofiler-counter-defs-generator (see yaml/counter_defs_generator.cpp). The expressions
+ * of the counters are parsed at build time and stored as flattened ASTs so that neither
+ * yaml-cpp nor the expression parser has to run at startup.
+ */
+namespace counter_defs
+{
+// Definition of a counter for a single architecture. Architectures sharing a definition
+// in the YAML ("gfx90a/gfx942:") are split into separate entries. Entries are in document
+// order so counter ids match the ones assigned when loading the YAML.
+struct definition
+{
+    std::string_view architecture = {};
+    std::string_view name         = {};
+    std::string_view block        = {};
+    std::string_view event        = {};
+    std::string_view description  = {};
+    std::string_view expression   = {};
+    bool             derived      = false;  // definition has an expression
+};
+
+enum class value_kind : int32_t
+{
+    none = 0,
+    string,
+    integer,
+};
+
+// Node of a pre-parsed AST. Children and dimensions are [offset, offset + size) ranges of
+// the corresponding arrays in the table. Mirrors the fields of RawAST.
+struct ast_node
+{
+    int32_t          type          = NONE;
+    int32_t          accumulate_op = 0;
+    std::string_view reduce_op     = {};
+    value_kind       kind          = value_kind::none;
+    std::string_view string_value  = {};
+    int64_t          integer_value = 0;
+    int32_t          range         = -1;  // node index, -1 if there is no range
+    uint32_t         children      = 0;
+    uint32_t         children_size = 0;
+    uint32_t         reduce_dims   = 0;
+    uint32_t         reduce_size   = 0;
+    uint32_t         select_dims   = 0;
+    uint32_t         select_size   = 0;
+};
+
+struct select_dimension
+{
+    int32_t dimension = 0;
+    int32_t index     = 0;
+};
+
+// Expression (or name for hardware counters) and the index of the root node of its AST
+struct expression
+{
+    std::string_view text = {};
+    uint32_t         root = 0;
+};
+
+struct table
+{
+    const definition*       definitions       = nullptr;
+    size_t                  definitions_size  = 0;
+    const expression*       expressions       = nullptr;  // sorted by text
+    size_t                  expressions_size  = 0;
+    const ast_node*         nodes             = nullptr;
+    size_t                  nodes_size        = 0;
+    const uint32_t*         children          = nullptr;
+    const int32_t*          reduce_dimensions = nullptr;
+    const select_dimension* select_dimensions = nullptr;
+};
+
+// defined in the generated counter_defs.gen.cpp
+const table&
+get_table();
+
+/**
+ * Rebuilds the AST of an expression from the compiled table. Returns nullptr if the
+ * expression is not in counter_defs.yaml (e.g. constants or a user supplied definition file),
+ * in which case the expression has to be parsed.
+ */
+std::unique_ptr<RawAST>
+get_raw_ast(std::string_view expr);
+}  // namespace counter_defs
+}  // namespace counters
+}  // namespace rocprofiler
@@ -28,11 +28,13 @@
 
 #include <fmt/core.h>
 
+#include <hsa/hsa_ven_amd_aqlprofile.h>
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
 #include "lib/common/static_object.hpp"
 #include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/aql/aql_profile_v2.h"
 #include "lib/rocprofiler-sdk/aql/helpers.hpp"
 #include "lib/rocprofiler-sdk/aql/packet_construct.hpp"
 #include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
@@ -41,6 +43,48 @@ namespace rocprofiler
 {
 namespace counters
 {
+// defined here rather than in id_decode.cpp so that id_decode.cpp does not depend on aqlprofile
+// (it is compiled into the counter definitions generator, see yaml/CMakeLists.txt)
+const std::unordered_map<int, rocprofiler_profile_counter_instance_types>&
+aqlprofile_id_to_rocprof_instance()
+{
+    using dims_map_t = std::unordered_map<int, rocprofiler_profile_counter_instance_types>;
+
+    static auto*& aql_to_rocprof_dims =
+        common::static_object<dims_map_t>::construct([]() -> dims_map_t {
+            dims_map_t data;
+
+            aqlprofile_iterate_event_ids(
+                [](int id, const char* name, void* userdata) -> hsa_status_t {
+                    const std::unordered_map<std::string_view,
+                                             rocprofiler_profile_counter_instance_types>
+                        aql_string_to_dim = {
+                            {"XCD", ROCPROFILER_DIMENSION_XCC},
+                            {"AID", ROCPROFILER_DIMENSION_AID},
+                            {"SE", ROCPROFILER_DIMENSION_SHADER_ENGINE},
+                            {"SA", ROCPROFILER_DIMENSION_SHADER_ARRAY},
+                            {"WGP", ROCPROFILER_DIMENSION_WGP},
+                            {"INSTANCE", ROCPROFILER_DIMENSION_INSTANCE},
+                        };
+
+                    if(const auto* inst_type =
+                           rocprofiler::common::get_val(aql_string_to_dim, name))
+                    {
+                        // Supported instance type
+                        auto& map = *static_cast<
+                            std::unordered_map<int, rocprofiler_profile_counter_instance_types>*>(
+                            userdata);
+                        map.emplace(id, *inst_type);
+                    }
+                    return HSA_STATUS_SUCCESS;
+                },
+                static_cast<void*>(&data));
+            return data;
+        }());
+
+    return *aql_to_rocprof_dims;
+}
+
 std::vector<MetricDimension>
 getBlockDimensions(std::string_view agent, const Metric& metric)
 {
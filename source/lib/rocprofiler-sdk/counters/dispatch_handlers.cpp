@@ -228,20 +228,11 @@ completed_cb(const context::context*                       ctx,
     }
 
     auto _dispatch_id = session.callback_record.dispatch_info.dispatch_id;
-    for(auto& ast : prof_config->asts)
-    {
-        std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
-        auto* ret = ast.evaluate(decoded_pkt, cache);
-        CHECK(ret);
-        ast.set_out_id(*ret);
+    for(const auto& ast : prof_config->compiled_asts)
+        ast.evaluate(decoded_pkt, out);
 
-        out.reserve(out.size() + ret->size());
-        for(auto& val : *ret)
-        {
-            val.dispatch_id = _dispatch_id;
-            out.emplace_back(val);
-        }
-    }
+    for(auto& val : out)
+        val.dispatch_id = _dispatch_id;
 
     if(!out.empty())
     {
@@ -261,9 +252,10 @@ completed_cb(const context::context*                       ctx,
                          ROCPROFILER_COUNTER_RECORD_PROFILE_COUNTING_DISPATCH_HEADER,
                          _header);
 
-            for(auto itr : out)
-                buf->emplace(
-                    ROCPROFILER_BUFFER_CATEGORY_COUNTERS, ROCPROFILER_COUNTER_RECORD_VALUE, itr);
+            buf->emplace_range(ROCPROFILER_BUFFER_CATEGORY_COUNTERS,
+                               ROCPROFILER_COUNTER_RECORD_VALUE,
+                               out.data(),
+                               out.size());
         }
         else
         {
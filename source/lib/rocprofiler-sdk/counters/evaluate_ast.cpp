@@ -23,6 +23,7 @@
 #include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
 
 #include <exception>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <stdexcept>
@@ -32,6 +33,7 @@
 #include <rocprofiler-sdk/rocprofiler.h>
 
 #include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/counters/counter_defs.hpp"
 #include "lib/rocprofiler-sdk/counters/dimensions.hpp"
 #include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
 
@@ -75,7 +77,7 @@ perform_reduction(ReduceOperation reduce_op, std::vector<rocprofiler_record_coun
         {
             result =
                 *std::max_element(input_array->begin(), input_array->end(), [](auto& a, auto& b) {
-                    return a.counter_value > b.counter_value;
+                    return a.counter_value < b.counter_value;
                 });
             break;
         }
@@ -119,6 +121,29 @@ perform_reduction(ReduceOperation reduce_op, std::vector<rocprofiler_record_coun
     return input_array;
 }
 
+using raw_ast_cache_t = std::unordered_map<std::string, std::unique_ptr<RawAST>>;
+
+// The ASTs of the expressions in counter_defs.yaml are parsed at build time (see
+// counter_defs.hpp). The parser only runs for the rest (e.g. constants or the definitions
+// of a user supplied counter_defs.yaml) and, since most expressions are shared by many
+// architectures, each distinct expression is only parsed once.
+const RawAST*
+get_raw_ast(raw_ast_cache_t& cache, const std::string& expr)
+{
+    if(const auto* itr = common::get_val(cache, expr)) return itr->get();
+
+    auto ast = counter_defs::get_raw_ast(expr);
+    if(!ast)
+    {
+        RawAST* parsed = nullptr;
+        auto*   buf    = yy_scan_string(expr.c_str());
+        yyparse(&parsed);
+        yy_delete_buffer(buf);
+        ast.reset(parsed);
+    }
+    return cache.emplace(expr, std::move(ast)).first->second.get();
+}
+
 }  // namespace
 
 const std::unordered_map<std::string, EvaluateASTMap>&
@@ -126,6 +151,7 @@ get_ast_map()
 {
     static std::unordered_map<std::string, EvaluateASTMap> ast_map = []() {
         std::unordered_map<std::string, EvaluateASTMap> data;
+        raw_ast_cache_t                                 raw_asts;
         const auto& metric_map = *CHECK_NOTNULL(counters::getMetricMap());
         for(const auto& [gfx, metrics] : metric_map)
         {
@@ -141,11 +167,8 @@ get_ast_map()
             auto& eval_map = data.emplace(gfx, EvaluateASTMap{}).first->second;
             for(auto& [_, metric] : by_name)
             {
-                RawAST* ast = nullptr;
-                auto*   buf =
-                    yy_scan_string(metric.expression().empty() ? metric.name().c_str()
-                                                               : metric.expression().c_str());
-                yyparse(&ast);
+                const auto* ast = get_raw_ast(
+                    raw_asts, metric.expression().empty() ? metric.name() : metric.expression());
                 if(!ast)
                 {
                     ROCP_ERROR << fmt::format("Unable to parse metric {}", metric);
@@ -167,8 +190,6 @@ get_ast_map()
                     throw std::runtime_error(
                         fmt::format("AST was not generated for {}:{}", gfx, metric.name()));
                 }
-                yy_delete_buffer(buf);
-                delete ast;
             }
 
             for(auto& [name, ast] : eval_map)
@@ -472,44 +493,74 @@ EvaluateAST::read_special_counters(
 std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>
 EvaluateAST::read_pkt(const aql::CounterPacketConstruct* pkt_gen, hsa::AQLPacket& pkt)
 {
+    using record_vec_t = std::vector<rocprofiler_record_counter_t>;
+
     struct it_data
     {
-        std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>* data;
-        const aql::CounterPacketConstruct*                                       pkt_gen;
-        aqlprofile_agent_handle_t                                                agent;
+        const aql::SampleDecodeTable* table;
+        std::vector<record_vec_t*>*   slots;
+        size_t                        cursor;
+        aqlprofile_agent_handle_t     agent;
     };
 
     auto aql_agent = *CHECK_NOTNULL(rocprofiler::agent::get_aql_agent(pkt_gen->agent()));
 
-    std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>> ret;
+    std::unordered_map<uint64_t, record_vec_t> ret;
     if(pkt.empty) return ret;
-    it_data aql_data{.data = &ret, .pkt_gen = pkt_gen, .agent = aql_agent};
+
+    // the output of every metric is allocated up front from the decode table so decoding a
+    // sample is a table lookup and an append
+    const auto& table = pkt_gen->get_sample_decode_table();
+    auto        slots = std::vector<record_vec_t*>{};
+    slots.reserve(table.slots.size());
+    ret.reserve(table.slots.size());
+    for(const auto& itr : table.slots)
+    {
+        auto& vec = ret[itr.metric_id];
+        vec.reserve(itr.samples);
+        slots.emplace_back(&vec);
+    }
+
+    it_data aql_data{.table = &table, .slots = &slots, .cursor = 0, .agent = aql_agent};
 
     hsa_status_t status = aqlprofile_pmc_iterate_data(
         pkt.handle,
         [](aqlprofile_pmc_event_t event, uint64_t counter_id, uint64_t counter_value, void* data) {
             CHECK(data);
-            auto&       it     = *static_cast<it_data*>(data);
-            const auto* metric = it.pkt_gen->event_to_metric(event);
+            auto&       it    = *static_cast<it_data*>(data);
+            const auto* entry = it.table->find(event, it.cursor);
 
-            if(!metric) return HSA_STATUS_SUCCESS;
+            if(!entry || entry->slot == aql::SampleDecodeTable::npos) return HSA_STATUS_SUCCESS;
+
+            auto& next_rec = (*it.slots)[entry->slot]->emplace_back();
+            if(counter_id < entry->count)
+            {
+                next_rec.id = it.table->instance_ids[entry->offset + counter_id];
+            }
+            else
+            {
+                set_counter_in_rec(next_rec.id, {.handle = it.table->slots[entry->slot].metric_id});
+                auto aql_status =
+                    aql::set_dim_id_from_sample(next_rec.id, it.agent, event, counter_id);
+                CHECK_EQ(aql_status, ROCPROFILER_STATUS_SUCCESS)
+                    << rocprofiler_get_status_string(aql_status);
+            }
 
-            auto& vec = it.data->emplace(metric->id(), std::vector<rocprofiler_record_counter_t>{})
-                            .first->second;
-            auto& next_rec = vec.emplace_back();
-            set_counter_in_rec(next_rec.id, {.handle = metric->id()});
-            // Actual dimension info needs to be used here in the future
-            auto aql_status = aql::set_dim_id_from_sample(next_rec.id, it.agent, event, counter_id);
-            CHECK_EQ(aql_status, ROCPROFILER_STATUS_SUCCESS)
-                << rocprofiler_get_status_string(aql_status);
-
-            // set_dim_in_rec(next_rec.id, ROCPROFILER_DIMENSION_NONE, vec.size() - 1);
             // Note: in the near future we need to use hw_counter here instead
             next_rec.counter_value = counter_value;
             return HSA_STATUS_SUCCESS;
         },
         &aql_data);
     CHECK(status == HSA_STATUS_SUCCESS);
+
+    // metrics without samples are not part of the results
+    for(auto itr = ret.begin(); itr != ret.end();)
+    {
+        if(itr->second.empty())
+            itr = ret.erase(itr);
+        else
+            ++itr;
+    }
     return ret;
 }
 
@@ -568,7 +619,9 @@ EvaluateAST::evaluate(
         auto* r1 = _children.at(0).evaluate(results_map, cache);
         auto* r2 = _children.at(1).evaluate(results_map, cache);
 
-        if(r1->size() < r2->size()) swap(r1, r2);
+        // the output takes the ids of the larger operand
+        bool swapped = (r1->size() < r2->size());
+        if(swapped) swap(r1, r2);
 
         cache.emplace_back(std::make_unique<std::vector<rocprofiler_record_counter_t>>());
         *cache.back() = *r1;
@@ -583,7 +636,19 @@ EvaluateAST::evaluate(
             // or some other type of constant op.
             for(auto& val : *r1)
             {
-                val = op(val, *r2->begin());
+                if(swapped)
+                {
+                    // keep the order of the operands of the expression
+                    auto id          = val.id;
+                    auto dispatch_id = val.dispatch_id;
+                    val              = op(*r2->begin(), val);
+                    val.id           = id;
+                    val.dispatch_id  = dispatch_id;
+                }
+                else
+                {
+                    val = op(val, *r2->begin());
+                }
             }
         }
         else if(r2->size() == r1->size())
@@ -153,6 +153,7 @@ public:
     ReduceOperation                     reduce_op() const { return _reduce_op; }
     const std::vector<EvaluateAST>&     children() const { return _children; }
     const Metric&                       metric() const { return _metric; }
+    double                              raw_value() const { return _raw_value; }
     const std::vector<MetricDimension>& dimension_types() const { return _dimension_types; }
 
     /**
@@ -28,6 +28,7 @@
 #include "lib/common/static_object.hpp"
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk/agent.hpp"
+#include "lib/rocprofiler-sdk/counters/counter_defs.hpp"
 
 #include "glog/logging.h"
 
@@ -40,9 +41,9 @@
 #include "yaml-cpp/node/parse.h"
 #include "yaml-cpp/parser.h"
 
-#include <dlfcn.h>  // for dladdr
 #include <cstdint>
 #include <cstdlib>
+#include <optional>
 
 namespace rocprofiler
 {
@@ -87,6 +88,17 @@ get_constants()
     }
     return constants;
 }
+std::vector<Metric>&
+get_arch_metrics(MetricMap& ret, const std::string& arch_name, bool load_constants)
+{
+    auto& metricVec = ret.emplace(arch_name, std::vector<Metric>()).first->second;
+    if(metricVec.empty() && load_constants)
+    {
+        metricVec.insert(metricVec.end(), get_constants().begin(), get_constants().end());
+    }
+    return metricVec;
+}
+
 /**
  * Expected YAML Format:
  * COUNTER_NAME:
@@ -128,12 +140,7 @@ loadYAML(const std::string& filename, bool load_constants = false, bool load_der
 
             while(std::getline(ss, arch_name, '/'))
             {
-                auto& metricVec = ret.emplace(arch_name, std::vector<Metric>()).first->second;
-                if(metricVec.empty() && load_constants)
-                {
-                    metricVec.insert(
-                        metricVec.end(), get_constants().begin(), get_constants().end());
-                }
+                auto& metricVec = get_arch_metrics(ret, arch_name, load_constants);
 
                 if((def["expression"] && load_derived) || (!load_derived && !def["expression"]))
                 {
@@ -162,20 +169,47 @@ loadYAML(const std::string& filename, bool load_constants = false, bool load_der
     return ret;
 }
 
-std::string
-findViaInstallPath(const std::string& filename)
+/**
+ * Same as loadYAML but from the counter definitions compiled into the library at build time
+ * (see counter_defs.hpp). The definitions are in document order and already split per
+ * architecture so the counter ids are identical to the ones assigned by loadYAML.
+ */
+MetricMap
+loadCompiled(bool load_constants = false, bool load_derived = false)
 {
-    Dl_info dl_info = {};
-    ROCP_INFO << filename << " is being looked up via install path";
-    if(dladdr(reinterpret_cast<const void*>(rocprofiler_query_available_agents), &dl_info) != 0)
+    MetricMap   ret;
+    const auto& table = counter_defs::get_table();
+
+    for(size_t i = 0; i < table.definitions_size; ++i)
     {
-        return common::filesystem::path{dl_info.dli_fname}.parent_path().parent_path() /
-               fmt::format("share/rocprofiler-sdk/{}", filename);
+        const auto& def       = table.definitions[i];
+        auto        arch_name = std::string{def.architecture};
+        auto&       metricVec = get_arch_metrics(ret, arch_name, load_constants);
+
+        if(def.derived == load_derived)
+        {
+            metricVec.emplace_back(arch_name,
+                                   std::string{def.name},
+                                   std::string{def.block},
+                                   std::string{def.event},
+                                   std::string{def.description},
+                                   std::string{def.expression},
+                                   "",
+                                   current_id());
+            current_id()++;
+        }
     }
-    return filename;
+    ROCP_FATAL_IF(current_id() > 65536)
+        << "Counter count exceeds 16 bits, which may break counter id output";
+    return ret;
 }
 
-std::string
+/**
+ * The counter definitions are compiled into the library. A counter_defs.yaml is only read
+ * (and parsed at runtime) when the directory containing it is provided via the
+ * ROCPROFILER_METRICS_PATH environment variable.
+ */
+std::optional<std::string>
 findViaEnvironment(const std::string& filename)
 {
     if(const char* metrics_path = nullptr; (metrics_path = getenv("ROCPROFILER_METRICS_PATH")))
@@ -183,8 +217,7 @@ findViaEnvironment(const std::string& filename)
         ROCP_INFO << filename << " is being looked up via env variable ROCPROFILER_METRICS_PATH";
         return common::filesystem::path{std::string{metrics_path}} / filename;
     }
-    // No environment variable, lookup via install path
-    return findViaInstallPath(filename);
+    return std::nullopt;
 }
 
 }  // namespace
@@ -193,18 +226,22 @@ MetricMap
 getDerivedHardwareMetrics()
 {
     auto counters_path = findViaEnvironment("counter_defs.yaml");
-    ROCP_FATAL_IF(!common::filesystem::exists(counters_path))
-        << "metric xml file '" << counters_path << "' does not exist";
-    return loadYAML(counters_path, false, true);
+    if(!counters_path) return loadCompiled(false, true);
+
+    ROCP_FATAL_IF(!common::filesystem::exists(*counters_path))
+        << "metric xml file '" << *counters_path << "' does not exist";
+    return loadYAML(*counters_path, false, true);
 }
 
 MetricMap
 getBaseHardwareMetrics()
 {
     auto counters_path = findViaEnvironment("counter_defs.yaml");
-    ROCP_FATAL_IF(!common::filesystem::exists(counters_path))
-        << "metric xml file '" << counters_path << "' does not exist";
-    return loadYAML(counters_path, true, false);
+    if(!counters_path) return loadCompiled(true, false);
+
+    ROCP_FATAL_IF(!common::filesystem::exists(*counters_path))
+        << "metric xml file '" << *counters_path << "' does not exist";
+    return loadYAML(*counters_path, true, false);
 }
 
 const MetricIdMap*
@@ -0,0 +1,159 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Startup benchmark of the counter definitions: loading counter_defs.yaml at runtime (as done
+// when ROCPROFILER_METRICS_PATH is set) vs. the definitions compiled into the library, and
+// parsing the expression of every counter of every architecture vs. the pre-parsed ASTs.
+
+#include "lib/rocprofiler-sdk/counters/counter_defs.hpp"
+#include "lib/rocprofiler-sdk/counters/metrics.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+namespace counters = ::rocprofiler::counters;
+
+constexpr size_t num_iterations = 10;
+
+// returns the best time (in milliseconds) of a call to func
+template <typename FuncT>
+double
+measure(FuncT&& func)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    auto _best = std::chrono::duration<double, std::milli>::max();
+    for(size_t n = 0; n < num_iterations; ++n)
+    {
+        auto _beg = clock_type::now();
+        func();
+        auto _end = clock_type::now();
+
+        _best = std::min<std::chrono::duration<double, std::milli>>(_best, _end - _beg);
+    }
+    return _best.count();
+}
+
+size_t
+load_metrics()
+{
+    auto _base    = counters::getBaseHardwareMetrics();
+    auto _derived = counters::getDerivedHardwareMetrics();
+    return _base.size() + _derived.size();
+}
+
+const std::string&
+get_expression(const counters::Metric& metric)
+{
+    return metric.expression().empty() ? metric.name() : metric.expression();
+}
+
+// previous behavior of get_ast_map(): every metric of every architecture is parsed
+size_t
+parse_asts(const counters::MetricMap& metrics)
+{
+    size_t _n = 0;
+    for(const auto& [gfx, metric_v] : metrics)
+    {
+        for(const auto& metric : metric_v)
+        {
+            counters::RawAST* _ast = nullptr;
+            auto*             _buf = yy_scan_string(get_expression(metric).c_str());
+            yyparse(&_ast);
+            yy_delete_buffer(_buf);
+            _n += (_ast != nullptr);
+            delete _ast;
+        }
+    }
+    return _n;
+}
+
+// get_ast_map(): pre-parsed ASTs, each distinct expression is built once
+size_t
+compiled_asts(const counters::MetricMap& metrics)
+{
+    auto _cache = std::unordered_map<std::string, std::unique_ptr<counters::RawAST>>{};
+    for(const auto& [gfx, metric_v] : metrics)
+    {
+        for(const auto& metric : metric_v)
+        {
+            const auto& _expr = get_expression(metric);
+            if(_cache.count(_expr) > 0) continue;
+
+            auto _ast = counters::counter_defs::get_raw_ast(_expr);
+            if(!_ast)
+            {
+                counters::RawAST* _parsed = nullptr;
+                auto*             _buf    = yy_scan_string(_expr.c_str());
+                yyparse(&_parsed);
+                yy_delete_buffer(_buf);
+                _ast.reset(_parsed);
+            }
+            _cache.emplace(_expr, std::move(_ast));
+        }
+    }
+    return _cache.size();
+}
+}  // namespace
+
+TEST(counter_defs, benchmark)
+{
+    // reads the topology for the constants
+    load_metrics();
+
+    auto _compiled_metrics = measure(load_metrics);
+
+    setenv("ROCPROFILER_METRICS_PATH", ROCPROFILER_COUNTER_DEFS_DIR, 1);
+    auto _yaml_metrics = measure(load_metrics);
+    unsetenv("ROCPROFILER_METRICS_PATH");
+
+    const auto& _metrics       = *CHECK_NOTNULL(counters::getMetricMap());
+    auto        _parsed_asts   = measure([&_metrics]() { parse_asts(_metrics); });
+    auto        _compiled_asts = measure([&_metrics]() { compiled_asts(_metrics); });
+
+    std::cout << std::setw(24) << "" << std::setw(16) << "yaml/parser" << std::setw(16)
+              << "compiled" << "\n";
+    std::cout << std::fixed << std::setprecision(3) << std::setw(24) << "metric tables"
+              << std::setw(13) << _yaml_metrics << " ms" << std::setw(13) << _compiled_metrics
+              << " ms\n";
+    std::cout << std::setw(24) << "counter ASTs" << std::setw(13) << _parsed_asts << " ms"
+              << std::setw(13) << _compiled_asts << " ms" << std::endl;
+
+    size_t _num_metrics = 0;
+    for(const auto& itr : _metrics)
+        _num_metrics += itr.second.size();
+
+    // every expression is parsed and only a fraction of the expressions are distinct
+    EXPECT_EQ(parse_asts(_metrics), _num_metrics);
+    EXPECT_GT(compiled_asts(_metrics), 0);
+    EXPECT_LT(compiled_asts(_metrics), _num_metrics);
+}
@@ -28,6 +28,7 @@
 #include <gtest/gtest.h>
 
 #include "lib/rocprofiler-sdk/agent.hpp"
+#include "lib/rocprofiler-sdk/counters/compiled_ast.hpp"
 #include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
 #include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
 
@@ -64,6 +65,33 @@ isIdentical(const EvaluateAST& eval_ast, const RawAST& raw_ast)
     }
     return true;
 }
+
+// evaluates the compiled form of the AST. This must be invoked before EvaluateAST::evaluate
+// since the latter modifies the results map when performing reductions.
+std::vector<rocprofiler_record_counter_t>
+evaluate_compiled(
+    const EvaluateAST&                                                             ast,
+    const std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>& results)
+{
+    auto ret = std::vector<rocprofiler_record_counter_t>{};
+    rocprofiler::counters::CompiledAST{ast}.evaluate(results, ret);
+    return ret;
+}
+
+// checks that the compiled AST gives the same results as EvaluateAST::evaluate
+void
+expect_same_results(const EvaluateAST&                               ast,
+                    const std::vector<rocprofiler_record_counter_t>& compiled,
+                    std::vector<rocprofiler_record_counter_t>        evaluated)
+{
+    ast.set_out_id(evaluated);
+    ASSERT_EQ(compiled.size(), evaluated.size());
+    for(size_t i = 0; i < compiled.size(); i++)
+    {
+        EXPECT_EQ(compiled[i].id, evaluated[i].id);
+        EXPECT_DOUBLE_EQ(compiled[i].counter_value, evaluated[i].counter_value);
+    }
+}
 }  // namespace
 
 TEST(evaluate_ast, basic_copy)
@@ -327,7 +355,9 @@ TEST(evaluate_ast, counter_constants)
         }
         asts.at("gfx9").at(name).expand_derived(asts.at("gfx9"));
         std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
+        auto compiled = evaluate_compiled(asts.at("gfx9").at(name), decode);
         auto ret = asts.at("gfx9").at(name).evaluate(decode, cache);
+        expect_same_results(asts.at("gfx9").at(name), compiled, *ret);
         EXPECT_EQ(ret->size(), 1);
         EXPECT_FLOAT_EQ(ret->at(0).counter_value, final_computed_values[name]);
 
@@ -466,7 +496,9 @@ TEST(evaluate_ast, evaluate_simple_counters)
         std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>> decode = {
             {metrics[name].id(), expected}};
         std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
+        auto compiled = evaluate_compiled(asts.at("gfx9").at(name), decode);
         auto ret = asts.at("gfx9").at(name).evaluate(decode, cache);
+        expect_same_results(asts.at("gfx9").at(name), compiled, *ret);
         EXPECT_EQ(ret->size(), expected.size());
         int pos = 0;
         for(const auto& v : *ret)
@@ -512,7 +544,9 @@ TEST(evaluate_ast, evaluate_simple_counters)
         ASSERT_EQ(eval_counters->size(), eval_count);
         std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
         asts.at("gfx9").at(name).expand_derived(asts.at("gfx9"));
+        auto compiled = evaluate_compiled(asts.at("gfx9").at(name), base_counter_decode);
         auto ret = asts.at("gfx9").at(name).evaluate(base_counter_decode, cache);
+        expect_same_results(asts.at("gfx9").at(name), compiled, *ret);
         EXPECT_EQ(ret->size(), expected.size());
         int pos = 0;
         asts.at("gfx9").at(name).set_out_id(*ret);
@@ -589,7 +623,9 @@ TEST(evaulate_ast, evaulate_hybrid_counters)
         ASSERT_EQ(eval_counters->begin()->flags(), flag);
         std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
         asts.at("gfx9").at(name).expand_derived(asts.at("gfx9"));
+        auto compiled = evaluate_compiled(asts.at("gfx9").at(name), base_counter_decode);
         auto ret = asts.at("gfx9").at(name).evaluate(base_counter_decode, cache);
+        expect_same_results(asts.at("gfx9").at(name), compiled, *ret);
         EXPECT_EQ(ret->size(), expected.size());
     }
 }
@@ -633,7 +669,9 @@ run_reduce_test(
         ASSERT_EQ(eval_counters->size(), eval_count);
         std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
         asts.at("gfx9").at(name).expand_derived(asts.at("gfx9"));
+        auto compiled = evaluate_compiled(asts.at("gfx9").at(name), base_counter_decode);
         auto ret = asts.at("gfx9").at(name).evaluate(base_counter_decode, cache);
+        expect_same_results(asts.at("gfx9").at(name), compiled, *ret);
         EXPECT_EQ(ret->size(), expected.size());
         ASSERT_EQ(expected.size(), 1);
         int pos = 0;
@@ -1107,7 +1145,9 @@ TEST(evaluate_ast, evaluate_mixed_counters)
         ASSERT_EQ(eval_counters->size(), eval_count);
         std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
         asts.at("gfx9").at(name).expand_derived(asts.at("gfx9"));
+        auto compiled = evaluate_compiled(asts.at("gfx9").at(name), base_counter_decode);
         auto ret = asts.at("gfx9").at(name).evaluate(base_counter_decode, cache);
+        expect_same_results(asts.at("gfx9").at(name), compiled, *ret);
         EXPECT_EQ(ret->size(), expected.size());
         ASSERT_EQ(expected.size(), 1);
         int pos = 0;
@@ -25,12 +25,15 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdlib>
 
 #include <rocprofiler-sdk/rocprofiler.h>
 
 #include "lib/common/logging.hpp"
 #include "lib/rocprofiler-sdk/agent.hpp"
+#include "lib/rocprofiler-sdk/counters/counter_defs.hpp"
 #include "lib/rocprofiler-sdk/counters/metrics.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
 
 namespace
 {
@@ -57,6 +60,37 @@ loadTestData(const std::unordered_map<std::string, std::vector<std::vector<std::
     }
     return ret;
 }
+
+void
+compare_metric_maps(const counters::MetricMap& lhs,
+                    const counters::MetricMap& rhs,
+                    std::optional<int64_t>&    id_offset)
+{
+    auto get_tie = [](const counters::Metric& x) {
+        return std::tie(x.name(), x.block(), x.event(), x.description(), x.expression());
+    };
+
+    ASSERT_EQ(lhs.size(), rhs.size());
+    for(const auto& [gfx, lhs_v] : lhs)
+    {
+        ASSERT_EQ(rhs.count(gfx), 1) << gfx;
+        const auto& rhs_v = rhs.at(gfx);
+        ASSERT_EQ(lhs_v.size(), rhs_v.size()) << gfx;
+        for(size_t i = 0; i < lhs_v.size(); ++i)
+        {
+            const auto& l = lhs_v.at(i);
+            const auto& r = rhs_v.at(i);
+            // constants are shared
+            if(!r.special().empty()) continue;
+
+            EXPECT_TRUE(get_tie(l) == get_tie(r)) << fmt::format("\n\t{} \n\t\t!= \n\t{}", l, r);
+
+            auto offset = static_cast<int64_t>(r.id()) - static_cast<int64_t>(l.id());
+            if(!id_offset) id_offset = offset;
+            EXPECT_EQ(offset, *id_offset) << fmt::format("{}", r);
+        }
+    }
+}
 }  // namespace
 
 TEST(metrics, base_load)
@@ -126,6 +160,46 @@ TEST(metrics, derived_load)
     }
 }
 
+TEST(metrics, compiled_definitions)
+{
+    auto compiled_base    = counters::getBaseHardwareMetrics();
+    auto compiled_derived = counters::getDerivedHardwareMetrics();
+
+    // load the same definitions from counter_defs.yaml
+    setenv("ROCPROFILER_METRICS_PATH", ROCPROFILER_COUNTER_DEFS_DIR, 1);
+    auto yaml_base    = counters::getBaseHardwareMetrics();
+    auto yaml_derived = counters::getDerivedHardwareMetrics();
+    unsetenv("ROCPROFILER_METRICS_PATH");
+
+    // ids are assigned from a global counter so they are offset by the same amount
+    auto id_offset = std::optional<int64_t>{};
+    compare_metric_maps(compiled_base, yaml_base, id_offset);
+    compare_metric_maps(compiled_derived, yaml_derived, id_offset);
+}
+
+TEST(metrics, compiled_asts)
+{
+    const auto& table = counters::counter_defs::get_table();
+    ASSERT_GT(table.expressions_size, 0);
+    for(size_t i = 0; i < table.expressions_size; ++i)
+    {
+        auto expr = std::string{table.expressions[i].text};
+
+        counters::RawAST* ast = nullptr;
+        auto*             buf = yy_scan_string(expr.c_str());
+        yyparse(&ast);
+        yy_delete_buffer(buf);
+        ASSERT_NE(ast, nullptr) << expr;
+
+        auto compiled = counters::counter_defs::get_raw_ast(expr);
+        ASSERT_NE(compiled, nullptr) << expr;
+        EXPECT_EQ(fmt::format("{}", *compiled), fmt::format("{}", *ast)) << expr;
+        delete ast;
+    }
+
+    EXPECT_EQ(counters::counter_defs::get_raw_ast("NOT_A_COUNTER"), nullptr);
+}
+
 TEST(metrics, check_agent_valid)
 {
     const auto& rocp_data      = *counters::getMetricMap();
@@ -0,0 +1,342 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Build-time generator for counter_defs.gen.cpp. Reads counter_defs.yaml, parses the
+// expression of every counter and writes the definitions and the flattened ASTs as constant
+// tables (see counter_defs.hpp) so that neither the YAML nor the expressions are parsed at
+// runtime. An invalid expression in the YAML fails the build.
+
+#include "lib/rocprofiler-sdk/counters/counter_defs.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/raw_ast.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include "yaml-cpp/exceptions.h"
+#include "yaml-cpp/node/convert.h"
+#include "yaml-cpp/node/detail/impl.h"
+#include "yaml-cpp/node/impl.h"
+#include "yaml-cpp/node/iterator.h"
+#include "yaml-cpp/node/node.h"
+#include "yaml-cpp/node/parse.h"
+#include "yaml-cpp/parser.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+namespace counters     = ::rocprofiler::counters;
+namespace counter_defs = ::rocprofiler::counters::counter_defs;
+
+struct definition
+{
+    std::string architecture = {};
+    std::string name         = {};
+    std::string block        = {};
+    std::string event        = {};
+    std::string description  = {};
+    std::string expression   = {};
+    bool        derived      = false;
+};
+
+// the string_views of the nodes refer to the parsed ASTs so they are kept alive
+struct flat_ast
+{
+    std::vector<std::unique_ptr<counters::RawAST>> parsed            = {};
+    std::vector<counter_defs::ast_node>            nodes             = {};
+    std::vector<uint32_t>                          children          = {};
+    std::vector<int32_t>                           reduce_dimensions = {};
+    std::vector<counter_defs::select_dimension>    select_dimensions = {};
+};
+
+// same traversal (and therefore counter id order) as loadYAML in metrics.cpp
+std::vector<definition>
+read_definitions(const std::string& filename)
+{
+    auto _data = std::vector<definition>{};
+    auto _yaml = YAML::LoadFile(filename);
+
+    for(auto it = _yaml.begin(); it != _yaml.end(); ++it)
+    {
+        auto counter_name = it->first.as<std::string>();
+        auto counter_def  = it->second;
+        auto def_iterator = counter_def["architectures"];
+
+        for(auto def_it = def_iterator.begin(); def_it != def_iterator.end(); ++def_it)
+        {
+            auto archs = def_it->first.as<std::string>();
+            auto def   = def_it->second;
+
+            std::stringstream ss(archs);
+            std::string       arch_name;
+            while(std::getline(ss, arch_name, '/'))
+            {
+                auto& _def        = _data.emplace_back();
+                _def.architecture = arch_name;
+                _def.name         = counter_name;
+                _def.block        = def["block"] ? def["block"].as<std::string>() : "";
+                _def.event        = def["event"] ? def["event"].as<std::string>() : "";
+                _def.expression   = def["expression"] ? def["expression"].as<std::string>() : "";
+                _def.derived      = static_cast<bool>(def["expression"]);
+                if(def["description"])
+                    _def.description = def["description"].as<std::string>();
+                else if(counter_def["description"])
+                    _def.description = counter_def["description"].as<std::string>();
+            }
+        }
+    }
+    return _data;
+}
+
+uint32_t
+flatten(const counters::RawAST& ast, flat_ast& out)
+{
+    auto _children = std::vector<uint32_t>{};
+    for(const auto* itr : ast.counter_set)
+        _children.emplace_back(flatten(*itr, out));
+
+    auto _node          = counter_defs::ast_node{};
+    _node.type          = static_cast<int32_t>(ast.type);
+    _node.accumulate_op = static_cast<int32_t>(ast.accumulate_op);
+    _node.reduce_op     = ast.reduce_op;
+    if(ast.range) _node.range = static_cast<int32_t>(flatten(*ast.range, out));
+
+    if(const auto* _val = std::get_if<std::string>(&ast.value))
+    {
+        _node.kind         = counter_defs::value_kind::string;
+        _node.string_value = *_val;
+    }
+    else if(const auto* _val = std::get_if<int64_t>(&ast.value))
+    {
+        _node.kind          = counter_defs::value_kind::integer;
+        _node.integer_value = *_val;
+    }
+
+    _node.children      = out.children.size();
+    _node.children_size = _children.size();
+    out.children.insert(out.children.end(), _children.begin(), _children.end());
+
+    // sorted so the generated file does not depend on the iteration order of the sets
+    auto _reduce = std::vector<int32_t>{};
+    for(auto itr : ast.reduce_dimension_set)
+        _reduce.emplace_back(static_cast<int32_t>(itr));
+    std::sort(_reduce.begin(), _reduce.end());
+    _node.reduce_dims = out.reduce_dimensions.size();
+    _node.reduce_size = _reduce.size();
+    out.reduce_dimensions.insert(out.reduce_dimensions.end(), _reduce.begin(), _reduce.end());
+
+    auto _select = std::vector<std::pair<int32_t, int32_t>>{};
+    for(auto [dim, idx] : ast.select_dimension_set)
+        _select.emplace_back(static_cast<int32_t>(dim), idx);
+    std::sort(_select.begin(), _select.end());
+    _node.select_dims = out.select_dimensions.size();
+    _node.select_size = _select.size();
+    for(auto [dim, idx] : _select)
+        out.select_dimensions.emplace_back(counter_defs::select_dimension{dim, idx});
+
+    out.nodes.emplace_back(_node);
+    return out.nodes.size() - 1;
+}
+
+uint32_t
+parse(const std::string& expr, flat_ast& out)
+{
+    counters::RawAST* _ast = nullptr;
+    auto*             _buf = yy_scan_string(expr.c_str());
+    yyparse(&_ast);
+    yy_delete_buffer(_buf);
+
+    if(!_ast) throw std::runtime_error{fmt::format("unable to parse expression '{}'", expr)};
+
+    out.parsed.emplace_back(_ast);
+    return flatten(*_ast, out);
+}
+
+std::string
+quote(std::string_view str)
+{
+    auto _v = std::string{"\""};
+    for(unsigned char c : str)
+    {
+        if(c == '"' || c == '\\')
+            _v += fmt::format("\\{}", static_cast<char>(c));
+        else if(c == '\n')
+            _v += "\\n";
+        else if(c < 0x20 || c >= 0x7f)
+            _v += fmt::format("\\{:03o}", c);
+        else
+            _v += static_cast<char>(c);
+    }
+    return _v + "\"";
+}
+
+std::string_view
+kind_name(counter_defs::value_kind kind)
+{
+    switch(kind)
+    {
+        case counter_defs::value_kind::none: return "value_kind::none";
+        case counter_defs::value_kind::string: return "value_kind::string";
+        case counter_defs::value_kind::integer: return "value_kind::integer";
+    }
+    return "value_kind::none";
+}
+
+template <typename Tp, typename FuncT>
+void
+write_array(std::ostream&    os,
+            std::string_view type,
+            std::string_view name,
+            const Tp&        data,
+            FuncT&&          func)
+{
+    os << fmt::format("constexpr auto {} = std::array<{}, {}>{{{{\n", name, type, data.size());
+    for(const auto& itr : data)
+        os << "    " << func(itr) << ",\n";
+    os << "}};\n\n";
+}
+
+void
+write_table(std::ostream&                          os,
+            const std::vector<definition>&         defs,
+            const std::map<std::string, uint32_t>& exprs,
+            const flat_ast&                        ast)
+{
+    os << "// Generated by rocprofiler-counter-defs-generator from counter_defs.yaml. Do not "
+          "edit.\n\n"
+       << "#include \"lib/rocprofiler-sdk/counters/counter_defs.hpp\"\n\n"
+       << "#include <array>\n\n"
+       << "namespace rocprofiler\n{\nnamespace counters\n{\nnamespace counter_defs\n{\n"
+       << "namespace\n{\n";
+
+    write_array(os, "definition", "definitions", defs, [](const definition& itr) {
+        return fmt::format("definition{{{}, {}, {}, {}, {}, {}, {}}}",
+                           quote(itr.architecture),
+                           quote(itr.name),
+                           quote(itr.block),
+                           quote(itr.event),
+                           quote(itr.description),
+                           quote(itr.expression),
+                           itr.derived);
+    });
+
+    write_array(os, "expression", "expressions", exprs, [](const auto& itr) {
+        return fmt::format("expression{{{}, {}}}", quote(itr.first), itr.second);
+    });
+
+    write_array(os, "ast_node", "nodes", ast.nodes, [](const counter_defs::ast_node& itr) {
+        return fmt::format("ast_node{{{}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, "
+                           "{}, {}}}",
+                           itr.type,
+                           itr.accumulate_op,
+                           quote(itr.reduce_op),
+                           kind_name(itr.kind),
+                           quote(itr.string_value),
+                           itr.integer_value,
+                           itr.range,
+                           itr.children,
+                           itr.children_size,
+                           itr.reduce_dims,
+                           itr.reduce_size,
+                           itr.select_dims,
+                           itr.select_size);
+    });
+
+    write_array(os, "uint32_t", "children", ast.children, [](uint32_t itr) {
+        return std::to_string(itr);
+    });
+
+    write_array(os, "int32_t", "reduce_dimensions", ast.reduce_dimensions, [](int32_t itr) {
+        return std::to_string(itr);
+    });
+
+    write_array(os,
+                "select_dimension",
+                "select_dimensions",
+                ast.select_dimensions,
+                [](const counter_defs::select_dimension& itr) {
+                    return fmt::format("select_dimension{{{}, {}}}", itr.dimension, itr.index);
+                });
+
+    os << "}  // namespace\n\n"
+       << "const table&\nget_table()\n{\n"
+       << "    static constexpr auto _v = table{definitions.data(),\n"
+       << "                                     definitions.size(),\n"
+       << "                                     expressions.data(),\n"
+       << "                                     expressions.size(),\n"
+       << "                                     nodes.data(),\n"
+       << "                                     nodes.size(),\n"
+       << "                                     children.data(),\n"
+       << "                                     reduce_dimensions.data(),\n"
+       << "                                     select_dimensions.data()};\n"
+       << "    return _v;\n}\n"
+       << "}  // namespace counter_defs\n}  // namespace counters\n}  // namespace rocprofiler\n";
+}
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    if(argc != 3)
+    {
+        fprintf(stderr, "usage: %s <counter_defs.yaml> <output.cpp>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        auto _defs = read_definitions(argv[1]);
+
+        // hardware counters are parsed by name, derived counters by expression. Each distinct
+        // expression is parsed once regardless of the number of architectures sharing it
+        auto _ast   = flat_ast{};
+        auto _exprs = std::map<std::string, uint32_t>{};
+        for(const auto& itr : _defs)
+        {
+            const auto& _expr = itr.expression.empty() ? itr.name : itr.expression;
+            if(_exprs.count(_expr) == 0) _exprs.emplace(_expr, parse(_expr, _ast));
+        }
+
+        auto _ofs = std::ofstream{argv[2]};
+        if(!_ofs) throw std::runtime_error{fmt::format("unable to open '{}'", argv[2])};
+        write_table(_ofs, _defs, _exprs, _ast);
+    } catch(std::exception& e)
+    {
+        fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -289,11 +289,13 @@ hip_api_impl<TableIdx, OpIdx>::functor(Args... args)
                                                buffer_record);
     }
 
+    // pop before releasing the last reference: once the reference count hits zero, the
+    // correlation id may be recycled by another thread
+    context::pop_latest_correlation_id(corr_id);
+
     // decrement the reference count after usage in the callback/buffers
     corr_id->sub_ref_count();
 
-    context::pop_latest_correlation_id(corr_id);
-
     if constexpr(!std::is_void<RetT>::value) return _ret;
 }
 }  // namespace hip
@@ -43,8 +43,12 @@
 #include <hsa/amd_hsa_signal.h>
 #include <hsa/hsa.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <limits>
+#include <memory>
 #include <type_traits>
 
 #define ROCPROFILER_LIB_ROCPROFILER_HSA_ASYNC_COPY_CPP_IMPL 1
@@ -60,9 +64,8 @@ namespace async_copy
 {
 namespace
 {
-using context_t              = context::context;
-using context_array_t        = common::container::small_vector<const context_t*>;
-using external_corr_id_map_t = std::unordered_map<const context_t*, rocprofiler_user_data_t>;
+using context_t       = context::context;
+using context_array_t = common::container::small_vector<const context_t*>;
 
 template <size_t OpIdx>
 struct async_copy_info;
@@ -159,6 +162,7 @@ struct async_copy_data
     uint64_t                            start_ts       = 0;
     context::correlation_id*            correlation_id = nullptr;
     tracing::tracing_data               tracing_data   = {};
+    bool                                pooled         = false;  // owned by async_copy_data_pool
 
     callback_data_t get_callback_data(timestamp_t _beg = 0, timestamp_t _end = 0) const;
     buffered_data_t get_buffered_record(const context_t* _ctx,
@@ -307,6 +311,165 @@ get_active_signals()
     return _v;
 }
 
+// Lock-free pool of async_copy_data records. Each record keeps its replacement signal after
+// the copy completes so the signal is created once and then recycled. The free list is a
+// stack of record indices with an ABA tag in the upper 32 bits of the head. When the pool is
+// exhausted, records (and signals) are allocated and destroyed per copy.
+struct async_copy_data_pool
+{
+    static constexpr uint32_t capacity = 512;
+    static constexpr uint32_t npos     = std::numeric_limits<uint32_t>::max();
+
+    async_copy_data_pool();
+    ~async_copy_data_pool()                               = default;
+    async_copy_data_pool(const async_copy_data_pool&)     = delete;
+    async_copy_data_pool(async_copy_data_pool&&) noexcept = delete;
+    async_copy_data_pool& operator=(const async_copy_data_pool&) = delete;
+    async_copy_data_pool& operator=(async_copy_data_pool&&) noexcept = delete;
+
+    // returns nullptr if the pool is exhausted. The rocp_signal of the record is zero if the
+    // record has never been used
+    async_copy_data* acquire();
+
+    // returns false if the record is not owned by the pool
+    bool release(async_copy_data* _data);
+
+    // destroy the signals of all the records which were handed out
+    void destroy();
+
+private:
+    static constexpr uint64_t pack(uint64_t _tag, uint32_t _idx) { return (_tag << 32) | _idx; }
+    static constexpr uint32_t index(uint64_t _head) { return static_cast<uint32_t>(_head); }
+    static constexpr uint64_t tag(uint64_t _head) { return (_head >> 32); }
+
+    std::atomic<uint64_t>                    m_head   = pack(0, npos);
+    std::atomic<uint32_t>                    m_unused = 0;  // records never handed out
+    std::unique_ptr<std::atomic<uint32_t>[]> m_next   = {};
+    std::unique_ptr<async_copy_data[]>       m_data   = {};
+};
+
+async_copy_data_pool::async_copy_data_pool()
+: m_next{std::make_unique<std::atomic<uint32_t>[]>(capacity)}
+, m_data{std::make_unique<async_copy_data[]>(capacity)}
+{
+    for(uint32_t i = 0; i < capacity; ++i)
+        m_data[i].pooled = true;
+}
+
+async_copy_data*
+async_copy_data_pool::acquire()
+{
+    auto _head = m_head.load(std::memory_order_acquire);
+    while(index(_head) != npos)
+    {
+        auto _idx  = index(_head);
+        auto _next = m_next[_idx].load(std::memory_order_relaxed);
+        if(m_head.compare_exchange_weak(_head,
+                                        pack(tag(_head) + 1, _next),
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+            return &m_data[_idx];
+    }
+
+    if(m_unused.load(std::memory_order_relaxed) < capacity)
+    {
+        auto _idx = m_unused.fetch_add(1, std::memory_order_relaxed);
+        if(_idx < capacity) return &m_data[_idx];
+    }
+
+    return nullptr;
+}
+
+bool
+async_copy_data_pool::release(async_copy_data* _data)
+{
+    if(!_data || !_data->pooled) return false;
+
+    auto _idx = static_cast<uint32_t>(_data - m_data.get());
+    ROCP_FATAL_IF(_idx >= capacity) << "async_copy_data record is not owned by the pool";
+
+    // reset everything except the signal
+    *_data = async_copy_data{.rocp_signal = _data->rocp_signal, .pooled = true};
+
+    auto _head = m_head.load(std::memory_order_relaxed);
+    do
+    {
+        m_next[_idx].store(index(_head), std::memory_order_relaxed);
+    } while(!m_head.compare_exchange_weak(_head,
+                                          pack(tag(_head) + 1, _idx),
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+
+    return true;
+}
+
+void
+async_copy_data_pool::destroy()
+{
+    // function pointer may be null during unit testing
+    if(hsa::get_hsa_ref_count() == 0 || !get_core_table()->hsa_signal_destroy_fn) return;
+
+    auto _n = std::min(m_unused.load(), capacity);
+    for(uint32_t i = 0; i < _n; ++i)
+    {
+        if(m_data[i].rocp_signal.handle == 0) continue;
+        ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(m_data[i].rocp_signal));
+        m_data[i].rocp_signal.handle = 0;
+    }
+}
+
+async_copy_data_pool*
+get_async_copy_data_pool()
+{
+    static auto*& _v = common::static_object<async_copy_data_pool>::construct();
+    return _v;
+}
+
+// returns a record with a signal which has been (re)set to the given value
+async_copy_data*
+acquire_async_copy_data(hsa_signal_value_t _signal_value)
+{
+    auto* _pool = get_async_copy_data_pool();
+    auto* _data = (_pool) ? _pool->acquire() : nullptr;
+    if(!_data) _data = new async_copy_data{};
+
+    if(_data->rocp_signal.handle != 0)
+    {
+        get_core_table()->hsa_signal_store_relaxed_fn(_data->rocp_signal, _signal_value);
+        return _data;
+    }
+
+    const uint32_t     num_consumers = 0;
+    const hsa_agent_t* consumers     = nullptr;
+    auto               _status       = get_core_table()->hsa_signal_create_fn(
+        _signal_value, num_consumers, consumers, &_data->rocp_signal);
+
+    if(_status != HSA_STATUS_SUCCESS)
+    {
+        ROCP_ERROR << "hsa_signal_create returned non-zero error code " << _status;
+
+        _data->rocp_signal.handle = 0;
+        if(!_pool || !_pool->release(_data)) delete _data;
+        return nullptr;
+    }
+
+    return _data;
+}
+
+// recycles the record and signal or destroys them if they are not owned by the pool
+void
+release_async_copy_data(async_copy_data* _data)
+{
+    auto* _pool = get_async_copy_data_pool();
+    if(_pool && _pool->release(_data)) return;
+
+    if(_data->rocp_signal.handle != 0)
+    {
+        ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(_data->rocp_signal));
+    }
+    delete _data;
+}
+
 template <typename Tp, typename Up>
 constexpr Tp*
 convert_hsa_handle(Up _hsa_object)
@@ -348,7 +511,7 @@ async_copy_handler(hsa_signal_value_t signal_value, void* arg)
     if(registration::get_fini_status() > 0)
     {
         auto* _data = static_cast<async_copy_data*>(arg);
-        delete _data;
+        if(!_data->pooled) delete _data;
         return false;
     }
 
@@ -432,8 +595,7 @@ async_copy_handler(hsa_signal_value_t signal_value, void* arg)
         get_core_table()->hsa_signal_store_screlease_fn(_data->orig_signal, signal_value);
     }
 
-    ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(_data->rocp_signal));
-    delete _data;
+    release_async_copy_data(_data);
 
     if(_corr_id) _corr_id->sub_ref_count();
 
@@ -573,6 +735,10 @@ async_copy_impl(Args... args)
         }
     }
 
+    constexpr auto           completion_signal_idx  = arg_indices<OpIdx>::completion_signal_idx;
+    auto&                    _completion_signal     = std::get<completion_signal_idx>(_tied_args);
+    const hsa_signal_value_t _completion_signal_val = 1;
+
     async_copy_data* _data = nullptr;
 
     {
@@ -590,7 +756,14 @@ async_copy_impl(Args... args)
                           std::make_index_sequence<N>{});
         }
 
-        _data               = new async_copy_data{};
+        _data = acquire_async_copy_data(_completion_signal_val);
+        if(!_data)
+        {
+            return invoke(get_next_dispatch<TableIdx, OpIdx>(),
+                          std::move(_tied_args),
+                          std::make_index_sequence<N>{});
+        }
+
         _data->tracing_data = std::move(tracing_data);
     }
 
@@ -603,29 +776,8 @@ async_copy_impl(Args... args)
     _data->direction    = _direction;
     _data->bytes_copied = compute_copy_bytes(std::get<copy_size_idx>(_tied_args));
 
-    constexpr auto           completion_signal_idx  = arg_indices<OpIdx>::completion_signal_idx;
-    auto&                    _completion_signal     = std::get<completion_signal_idx>(_tied_args);
-    const hsa_signal_value_t _completion_signal_val = 1;
-
     auto original_value = get_core_table()->hsa_signal_load_scacquire_fn(_completion_signal);
 
-    {
-        const uint32_t     num_consumers = 0;
-        const hsa_agent_t* consumers     = nullptr;
-        auto               _status       = get_core_table()->hsa_signal_create_fn(
-            _completion_signal_val, num_consumers, consumers, &_data->rocp_signal);
-
-        if(_status != HSA_STATUS_SUCCESS)
-        {
-            ROCP_ERROR << "hsa_signal_create returned non-zero error code " << _status;
-
-            delete _data;
-            return invoke(get_next_dispatch<TableIdx, OpIdx>(),
-                          std::move(_tied_args),
-                          std::make_index_sequence<N>{});
-        }
-    }
-
     {
         auto _status = get_amd_ext_table()->hsa_amd_signal_async_handler_fn(_data->rocp_signal,
                                                                             HSA_SIGNAL_CONDITION_LT,
@@ -637,10 +789,7 @@ async_copy_impl(Args... args)
         {
             ROCP_ERROR << "hsa_amd_signal_async_handler returned non-zero error code " << _status;
 
-            ROCP_HSA_TABLE_CALL(ERROR, get_core_table()->hsa_signal_destroy_fn(_data->rocp_signal))
-                << ":: failed to destroy signal after async handler failed";
-
-            delete _data;
+            release_async_copy_data(_data);
             return invoke(get_next_dispatch<TableIdx, OpIdx>(),
                           std::move(_tied_args),
                           std::make_index_sequence<N>{});
@@ -851,6 +1000,7 @@ async_copy_fini()
 
     async_copy_sync();
     async_copy::get_active_signals()->destroy();
+    if(async_copy::get_async_copy_data_pool()) async_copy::get_async_copy_data_pool()->destroy();
 }
 }  // namespace hsa
 }  // namespace rocprofiler
@@ -22,8 +22,11 @@
 
 #include "lib/rocprofiler-sdk/hsa/profile_serializer.hpp"
 
+#include "lib/common/environment.hpp"
 #include "lib/rocprofiler-sdk/hsa/queue_controller.hpp"
 
+#include <string>
+
 namespace rocprofiler
 {
 namespace hsa
@@ -58,20 +61,57 @@ clear_complete_barriers(std::deque<profiler_serializer::barrier_with_state>& bar
     }
 }
 
+profiler_serializer::Scope
+get_env_scope()
+{
+    auto _scope = common::get_env("ROCPROFILER_SERIALIZATION_SCOPE", std::string{"agent"});
+    if(_scope == "process") return profiler_serializer::Scope::PROCESS;
+    if(_scope != "agent")
+        ROCP_WARNING << "Invalid ROCPROFILER_SERIALIZATION_SCOPE=" << _scope
+                     << " (expected 'agent' or 'process'). Serializing kernels per agent";
+    return profiler_serializer::Scope::AGENT;
+}
 }  // namespace
 
+profiler_serializer::profiler_serializer()
+: profiler_serializer{get_env_scope()}
+{}
+
+profiler_serializer::profiler_serializer(Scope _scope_v)
+: _scope{_scope_v}
+{}
+
+rocprofiler_agent_id_t
+profiler_serializer::get_scope_id(const Queue& queue) const
+{
+    // all queues share a single dispatch state when serializing the process
+    if(_scope == Scope::PROCESS) return rocprofiler_agent_id_t{.handle = 0};
+    return queue.get_agent().get_rocp_agent()->id;
+}
+
+profiler_serializer::dispatch_state&
+profiler_serializer::get_dispatch_state(const Queue& queue)
+{
+    return _dispatch_state[get_scope_id(queue)];
+}
+
+const Queue*
+profiler_serializer::get_dispatch_queue(const Queue& queue) const
+{
+    auto itr = _dispatch_state.find(get_scope_id(queue));
+    return (itr != _dispatch_state.end()) ? itr->second.dispatch_queue : nullptr;
+}
+
 void
 profiler_serializer::add_queue(hsa_queue_t** hsa_queues, const Queue& queue)
 {
     hsa_signal_t signal = queue.ready_signal;
     hsa_status_t status =
-        CHECK_NOTNULL(get_queue_controller())
-            ->get_ext_table()
-            .hsa_amd_signal_async_handler_fn(signal,
-                                             HSA_SIGNAL_CONDITION_EQ,
-                                             -1,
-                                             profiler_serializer_ready_signal_handler,
-                                             *hsa_queues);
+        queue.ext_api().hsa_amd_signal_async_handler_fn(signal,
+                                                        HSA_SIGNAL_CONDITION_EQ,
+                                                        -1,
+                                                        profiler_serializer_ready_signal_handler,
+                                                        *hsa_queues);
     if(status != HSA_STATUS_SUCCESS) ROCP_FATAL << "hsa_amd_signal_async_handler failed";
 }
 
@@ -101,22 +141,18 @@ profiler_serializer::kernel_completion_signal(const Queue& completed)
 
     if(state == Status::DISABLED) return;
 
-    CHECK(_dispatch_queue);
-    _dispatch_queue = nullptr;
-    CHECK_NOTNULL(get_queue_controller())
-        ->get_core_table()
-        .hsa_signal_store_screlease_fn(completed.block_signal, 1);
-    CHECK_NOTNULL(get_queue_controller())
-        ->get_core_table()
-        .hsa_signal_store_screlease_fn(completed.ready_signal, 0);
-    if(!_dispatch_ready.empty())
+    // Only the kernels within the scope of the completed kernel were waiting on it
+    auto& _state = get_dispatch_state(completed);
+    CHECK(_state.dispatch_queue);
+    _state.dispatch_queue = nullptr;
+    completed.core_api().hsa_signal_store_screlease_fn(completed.block_signal, 1);
+    completed.core_api().hsa_signal_store_screlease_fn(completed.ready_signal, 0);
+    if(!_state.dispatch_ready.empty())
     {
-        const auto* queue = _dispatch_ready.front();
-        _dispatch_ready.erase(_dispatch_ready.begin());
-        CHECK_NOTNULL(get_queue_controller())
-            ->get_core_table()
-            .hsa_signal_store_screlease_fn(queue->block_signal, 0);
-        _dispatch_queue = queue;
+        const auto* queue = _state.dispatch_ready.front();
+        _state.dispatch_ready.pop_front();
+        queue->core_api().hsa_signal_store_screlease_fn(queue->block_signal, 0);
+        _state.dispatch_queue = queue;
     }
 }
 
@@ -133,9 +169,7 @@ profiler_serializer::queue_ready(hsa_queue_t* hsa_queue, const Queue& queue)
             CHECK_NOTNULL(get_queue_controller())
                 ->set_queue_state(queue_state::done_destroy, hsa_queue);
             ROCP_TRACE << "Destroying ready signal...";
-            CHECK_NOTNULL(get_queue_controller())
-                ->get_core_table()
-                .hsa_signal_destroy_fn(queue.ready_signal);
+            queue.core_api().hsa_signal_destroy_fn(queue.ready_signal);
             ROCP_TRACE << "Notifying queue condition variable...";
             queue.cv_ready_signal.notify_one();
             return;
@@ -143,20 +177,17 @@ profiler_serializer::queue_ready(hsa_queue_t* hsa_queue, const Queue& queue)
     }
 
     ROCP_TRACE << "setting queue ready signal to 1...";
-    CHECK_NOTNULL(get_queue_controller())
-        ->get_core_table()
-        .hsa_signal_store_screlease_fn(queue.ready_signal, 1);
+    queue.core_api().hsa_signal_store_screlease_fn(queue.ready_signal, 1);
 
-    if(_dispatch_queue == nullptr)
+    auto& _state = get_dispatch_state(queue);
+    if(_state.dispatch_queue == nullptr)
     {
-        CHECK_NOTNULL(get_queue_controller())
-            ->get_core_table()
-            .hsa_signal_store_screlease_fn(queue.block_signal, 0);
-        _dispatch_queue = &queue;
+        queue.core_api().hsa_signal_store_screlease_fn(queue.block_signal, 0);
+        _state.dispatch_queue = &queue;
     }
     else
     {
-        _dispatch_ready.push_back(&queue);
+        _state.dispatch_ready.push_back(&queue);
     }
 }
 
@@ -212,15 +243,17 @@ profiler_serializer::destroy_queue(hsa_queue_t* id, const Queue& queue)
         barriers.barrier->remove_queue(&queue);
     }
 
-    _dispatch_ready.erase(
+    auto& _state = get_dispatch_state(queue);
+    _state.dispatch_ready.erase(
         std::remove_if(
-            _dispatch_ready.begin(),
-            _dispatch_ready.end(),
+            _state.dispatch_ready.begin(),
+            _state.dispatch_ready.end(),
             [&](auto& it) {
                 /*Deletes the queue to be destructed from the dispatch ready.*/
                 if(it->get_id().handle == queue.get_id().handle)
                 {
-                    if(_dispatch_queue && _dispatch_queue->get_id().handle == queue.get_id().handle)
+                    if(_state.dispatch_queue &&
+                       _state.dispatch_queue->get_id().handle == queue.get_id().handle)
                     {
                         // insert fatal condition here
                         // ToDO [srnagara]: Need to find a solution rather than abort.
@@ -231,11 +264,9 @@ profiler_serializer::destroy_queue(hsa_queue_t* id, const Queue& queue)
                 }
                 return false;
             }),
-        _dispatch_ready.end());
+        _state.dispatch_ready.end());
     CHECK_NOTNULL(get_queue_controller())->set_queue_state(queue_state::to_destroy, id);
-    CHECK_NOTNULL(get_queue_controller())
-        ->get_core_table()
-        .hsa_signal_store_screlease_fn(queue.ready_signal, 0);
+    queue.core_api().hsa_signal_store_screlease_fn(queue.ready_signal, 0);
 
     ROCP_INFO << "queue destroyed";
 }
@@ -254,8 +285,7 @@ profiler_serializer::enable(const queue_map_t& queues)
     clear_complete_barriers(_barrier);
 
     _barrier.emplace_back(Status::DISABLED,
-                          std::make_unique<hsa_barrier>(
-                              [] {}, CHECK_NOTNULL(get_queue_controller())->get_core_table()));
+                          std::make_unique<hsa_barrier>([] {}, queues.begin()->second->core_api()));
     _serializer_status = Status::ENABLED;
     _barrier.back().barrier->set_barrier(queues);
 
@@ -276,8 +306,7 @@ profiler_serializer::disable(const queue_map_t& queues)
     clear_complete_barriers(_barrier);
 
     _barrier.emplace_back(Status::ENABLED,
-                          std::make_unique<hsa_barrier>(
-                              [] {}, CHECK_NOTNULL(get_queue_controller())->get_core_table()));
+                          std::make_unique<hsa_barrier>([] {}, queues.begin()->second->core_api()));
     _serializer_status = Status::DISABLED;
     _barrier.back().barrier->set_barrier(queues);
 
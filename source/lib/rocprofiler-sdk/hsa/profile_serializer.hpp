@@ -23,6 +23,8 @@
 #pragma once
 
 #include <rocprofiler-sdk/rocprofiler.h>
+#include <rocprofiler-sdk/cxx/hash.hpp>
+#include <rocprofiler-sdk/cxx/operators.hpp>
 
 #include "lib/common/container/small_vector.hpp"
 #include "lib/rocprofiler-sdk/hsa/hsa_barrier.hpp"
@@ -38,14 +40,17 @@ namespace hsa
 /*This is a profiler serializer. It should be instantiated
 only once for the profiler. The following is the
 description of each field.
-1. _dispatch_queue - The queue to which the currently dispatched kernel
-        belongs to.
-        At any given time, in serialization only one kernel
-        can be executing.
-2. _dispatch_ready- It is a software data structure which holds
-        the queues which have a kernel ready to be dispatched.
-        This stores the queues in FIFO order.
-3. serializer_mutex - The mutex is used for thread synchronization
+1. _dispatch_state - The dispatch state of each serialization scope.
+        The scope is either the agent of the queue (default) or
+        the whole process (ROCPROFILER_SERIALIZATION_SCOPE=process).
+        Each dispatch state holds:
+        a. dispatch_queue - The queue to which the currently dispatched
+           kernel belongs to. At any given time, in serialization only
+           one kernel per scope can be executing.
+        b. dispatch_ready - It is a software data structure which holds
+           the queues which have a kernel ready to be dispatched.
+           This stores the queues in FIFO order.
+2. serializer_mutex - The mutex is used for thread synchronization
         while accessing the singleton instance of this structure.
 Currently, in case of profiling kernels are serialized by default.
 */
@@ -58,6 +63,23 @@ public:
         DISABLED,
     };
 
+    // Set of kernels that are serialized against each other
+    enum class Scope
+    {
+        AGENT,    // kernels dispatched to the same agent
+        PROCESS,  // all kernels of the process
+    };
+
+    struct dispatch_state
+    {
+        const Queue*             dispatch_queue = nullptr;
+        std::deque<const Queue*> dispatch_ready = {};
+    };
+
+    // Scope is read from the ROCPROFILER_SERIALIZATION_SCOPE environment variable
+    profiler_serializer();
+    explicit profiler_serializer(Scope _scope);
+
     struct barrier_with_state
     {
         barrier_with_state(Status _state, std::unique_ptr<hsa_barrier> _barrier)
@@ -84,11 +106,18 @@ public:
 
     static void add_queue(hsa_queue_t** hsa_queues, const Queue& queue);
 
+    Scope get_scope() const { return _scope; }
+    // Queue whose kernel is currently dispatched within the scope of the queue, if any
+    const Queue* get_dispatch_queue(const Queue& queue) const;
+
 private:
-    const Queue*                   _dispatch_queue{nullptr};
-    std::deque<const Queue*>       _dispatch_ready;
-    std::atomic<Status>            _serializer_status{Status::DISABLED};
-    std::deque<barrier_with_state> _barrier;
+    rocprofiler_agent_id_t get_scope_id(const Queue& queue) const;
+    dispatch_state&        get_dispatch_state(const Queue& queue);
+
+    Scope                                                      _scope{Scope::AGENT};
+    std::unordered_map<rocprofiler_agent_id_t, dispatch_state> _dispatch_state;
+    std::atomic<Status>                                        _serializer_status{Status::DISABLED};
+    std::deque<barrier_with_state>                             _barrier;
 };
 
 }  // namespace hsa
@@ -43,6 +43,9 @@
 #include <hsa/hsa_ext_amd.h>
 
 #include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
 
 // static assert for rocprofiler_packet ABI compatibility
 static_assert(sizeof(hsa_ext_amd_aql_pm4_packet_t) == sizeof(hsa_kernel_dispatch_packet_t),
@@ -67,30 +70,12 @@ namespace hsa
 {
 namespace
 {
-template <typename DomainT, typename... Args>
-inline bool
-context_filter(const context::context* ctx, DomainT domain, Args... args)
-{
-    if constexpr(std::is_same<DomainT, rocprofiler_buffer_tracing_kind_t>::value)
-    {
-        return (ctx->buffered_tracer && ctx->buffered_tracer->domains(domain, args...));
-    }
-    else if constexpr(std::is_same<DomainT, rocprofiler_callback_tracing_kind_t>::value)
-    {
-        return (ctx->callback_tracer && ctx->callback_tracer->domains(domain, args...));
-    }
-    else
-    {
-        static_assert(common::mpl::assert_false<DomainT>::value, "unsupported domain type");
-        return false;
-    }
-}
-
 bool
-context_filter(const context::context* ctx)
+is_kernel_dispatch_traced()
 {
-    return (context_filter(ctx, ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH) ||
-            context_filter(ctx, ROCPROFILER_CALLBACK_TRACING_KERNEL_DISPATCH));
+    const auto snapshot = context::get_active_tracing_snapshot();
+    return (snapshot->buffered_domains(ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH) ||
+            snapshot->callback_domains(ROCPROFILER_CALLBACK_TRACING_KERNEL_DISPATCH));
 }
 
 bool
@@ -107,16 +92,17 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
     }
 
     auto& queue_info_session = *static_cast<Queue::queue_info_session_t*>(data);
+    auto& queue              = queue_info_session.queue;
     auto  dispatch_time      = kernel_dispatch::get_dispatch_time(queue_info_session);
 
     kernel_dispatch::dispatch_complete(queue_info_session, dispatch_time);
 
     // Calls our internal callbacks to callers who need to be notified post
     // kernel execution.
-    queue_info_session.queue.signal_callback([&](const auto& map) {
+    queue.signal_callback([&](const auto& map) {
         for(const auto& [client_id, cb_pair] : map)
         {
-            cb_pair.second(queue_info_session.queue,
+            cb_pair.second(queue,
                            queue_info_session.kernel_pkt,
                            queue_info_session,
                            queue_info_session.inst_pkt,
@@ -124,7 +110,7 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
         }
     });
 
-    // Delete signals and packets, signal we have completed.
+    // Recycle signals, signal we have completed.
     if(queue_info_session.interrupt_signal.handle != 0u)
     {
 #if !defined(NDEBUG)
@@ -132,14 +118,12 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
             signals.erase(queue_info_session.interrupt_signal.handle);
         });
 #endif
-        hsa::get_core_table()->hsa_signal_store_screlease_fn(queue_info_session.interrupt_signal,
-                                                             -1);
-        hsa::get_core_table()->hsa_signal_destroy_fn(queue_info_session.interrupt_signal);
+        queue.core_api().hsa_signal_store_screlease_fn(queue_info_session.interrupt_signal, -1);
+        queue.release_signal(queue_info_session.interrupt_signal);
     }
     if(queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal.handle != 0u)
     {
-        hsa::get_core_table()->hsa_signal_destroy_fn(
-            queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal);
+        queue.release_signal(queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal);
     }
 
     // we need to decrement this reference count at the end of the functions
@@ -153,8 +137,10 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
         _corr_id->sub_ref_count();
     }
 
-    queue_info_session.queue.async_complete();
-    delete static_cast<Queue::queue_info_session_t*>(data);
+    // the session must be released before async_complete() since the queue may be destroyed
+    // once there are no more active kernels
+    queue.release_session(&queue_info_session);
+    queue.async_complete();
 
     return false;
 }
@@ -179,6 +165,16 @@ bit_extract(Integral x, int first, int last)
     return (x >> first) & bit_mask<Integral>(0, last - first);
 }
 
+// reusable storage for the packets written to the queue. The storage is moved out while in use
+// so that nested/concurrent writes never share the same vector
+auto&
+get_transformed_packets_storage()
+{
+    static thread_local auto _v = std::vector<rocprofiler_packet>{};
+    return _v;
+}
+}  // namespace
+
 /**
  * @brief This function is a queue write interceptor. It intercepts the
  * packet write function. Creates an instance of packet class with the raw
@@ -220,8 +216,7 @@ WriteInterceptor(const void* packets,
     auto& queue = *static_cast<Queue*>(data);
 
     // We have no packets or no one who needs to be notified, do nothing.
-    if(pkt_count == 0 ||
-       (queue.get_notifiers() == 0 && context::get_active_contexts(context_filter).empty()))
+    if(pkt_count == 0 || (queue.get_notifiers() == 0 && !is_kernel_dispatch_traced()))
     {
         writer(packets, pkt_count);
         return;
@@ -233,7 +228,8 @@ WriteInterceptor(const void* packets,
                                tracing_data_v);
 
     const auto* packets_arr         = static_cast<const rocprofiler_packet*>(packets);
-    auto        transformed_packets = std::vector<rocprofiler_packet>{};
+    auto        transformed_packets = std::move(get_transformed_packets_storage());
+    transformed_packets.clear();
 
     // Searching accross all the packets given during this write
     for(size_t i = 0; i < pkt_count; ++i)
@@ -294,7 +290,7 @@ WriteInterceptor(const void* packets,
         // create our own signal that we can get a callback on. if there is an original completion
         // signal we will create a barrier packet, assign the original completion signal that that
         // barrier packet, and add it right after the kernel packet
-        queue.create_signal(0, &kernel_pkt.kernel_dispatch.completion_signal);
+        kernel_pkt.kernel_dispatch.completion_signal = queue.acquire_signal();
 
         // computes the "size" based on the offset of reserved_padding field
         constexpr auto kernel_dispatch_info_rt_size =
@@ -416,7 +412,7 @@ WriteInterceptor(const void* packets,
         if(injected_end_pkt)
         {
             // Adding a barrier packet with the original packet's completion signal.
-            queue.create_signal(0, &interrupt_signal);
+            interrupt_signal                                             = queue.acquire_signal();
             completion_signal                                            = interrupt_signal;
             transformed_packets.back().ext_amd_aql_pm4.completion_signal = interrupt_signal;
             CreateBarrierPacket(&interrupt_signal, &interrupt_signal, transformed_packets);
@@ -424,7 +420,7 @@ WriteInterceptor(const void* packets,
         else
         {
             completion_signal = kernel_pkt.kernel_dispatch.completion_signal;
-            get_core_table()->hsa_signal_store_screlease_fn(completion_signal, 0);
+            queue.core_api().hsa_signal_store_screlease_fn(completion_signal, 0);
         }
 
         ROCP_FATAL_IF(packet_type != HSA_PACKET_TYPE_KERNEL_DISPATCH)
@@ -434,7 +430,8 @@ WriteInterceptor(const void* packets,
         // signal completes.
         queue.signal_async_handler(
             completion_signal,
-            new Queue::queue_info_session_t{.queue            = queue,
+            queue.acquire_session(
+                Queue::queue_info_session_t{.queue            = queue,
                                             .inst_pkt         = std::move(inst_pkt),
                                             .interrupt_signal = interrupt_signal,
                                             .tid              = thr_id,
@@ -443,7 +440,7 @@ WriteInterceptor(const void* packets,
                                             .correlation_id   = corr_id,
                                             .kernel_pkt       = kernel_pkt,
                                             .callback_record  = callback_record,
-                                            .tracing_data     = tracing_data_v});
+                                            .tracing_data     = tracing_data_v}));
 
         {
             auto tracer_data = callback_record;
@@ -460,8 +457,10 @@ WriteInterceptor(const void* packets,
         "QueueID {}: {}", queue.get_id().handle, fmt::join(transformed_packets, fmt::format(" ")));
 
     writer(transformed_packets.data(), transformed_packets.size());
+
+    // return the storage for reuse by the next write on this thread
+    get_transformed_packets_storage() = std::move(transformed_packets);
 }
-}  // namespace
 
 Queue::Queue(const AgentCache& agent, CoreApiTable table)
 : _core_api(table)
@@ -470,6 +469,14 @@ Queue::Queue(const AgentCache& agent, CoreApiTable table)
     _core_api.hsa_signal_create_fn(0, 0, nullptr, &_active_kernels);
 }
 
+Queue::Queue(const AgentCache& agent, CoreApiTable core_api, AmdExtTable ext_api)
+: _core_api(core_api)
+, _ext_api(ext_api)
+, _agent(agent)
+{
+    _core_api.hsa_signal_create_fn(0, 0, nullptr, &_active_kernels);
+}
+
 Queue::Queue(const AgentCache&  agent,
              uint32_t           size,
              hsa_queue_type32_t type,
@@ -538,6 +545,89 @@ Queue::~Queue()
 {
     sync();
     _core_api.hsa_signal_destroy_fn(_active_kernels);
+
+    auto _lk = std::unique_lock<std::mutex>{_pool_mutex};
+    for(auto itr : _signal_pool)
+        _core_api.hsa_signal_destroy_fn(itr);
+    for(auto* itr : _session_pool)
+        ::operator delete(itr);
+    _signal_pool.clear();
+    _session_pool.clear();
+}
+
+hsa_signal_t
+Queue::acquire_signal()
+{
+    auto _signal = hsa_signal_t{.handle = 0};
+    {
+        auto _lk = std::unique_lock<std::mutex>{_pool_mutex};
+        if(!_signal_pool.empty())
+        {
+            _signal = _signal_pool.back();
+            _signal_pool.pop_back();
+        }
+    }
+
+    if(_signal.handle == 0)
+        create_signal(0, &_signal);
+    else
+        _core_api.hsa_signal_store_relaxed_fn(_signal, 1);
+
+    return _signal;
+}
+
+void
+Queue::release_signal(hsa_signal_t signal)
+{
+    if(signal.handle == 0) return;
+
+    {
+        auto _lk = std::unique_lock<std::mutex>{_pool_mutex};
+        if(_signal_pool.size() < max_pool_size)
+        {
+            _signal_pool.emplace_back(signal);
+            return;
+        }
+    }
+
+    _core_api.hsa_signal_destroy_fn(signal);
+}
+
+Queue::queue_info_session_t*
+Queue::acquire_session(queue_info_session_t&& session)
+{
+    void* _storage = nullptr;
+    {
+        auto _lk = std::unique_lock<std::mutex>{_pool_mutex};
+        if(!_session_pool.empty())
+        {
+            _storage = _session_pool.back();
+            _session_pool.pop_back();
+        }
+    }
+
+    if(!_storage) _storage = ::operator new(sizeof(queue_info_session_t));
+
+    return new(_storage) queue_info_session_t{std::move(session)};
+}
+
+void
+Queue::release_session(queue_info_session_t* session)
+{
+    if(!session) return;
+
+    session->~queue_info_session_t();
+
+    {
+        auto _lk = std::unique_lock<std::mutex>{_pool_mutex};
+        if(_session_pool.size() < max_pool_size)
+        {
+            _session_pool.emplace_back(session);
+            return;
+        }
+    }
+
+    ::operator delete(session);
 }
 
 void
@@ -28,6 +28,7 @@
 #include <rocprofiler-sdk/fwd.h>
 
 #include "lib/common/container/small_vector.hpp"
+#include "lib/common/defines.hpp"
 #include "lib/common/synchronized.hpp"
 #include "lib/rocprofiler-sdk/hsa/agent_cache.hpp"
 #include "lib/rocprofiler-sdk/hsa/aql_packet.hpp"
@@ -46,7 +47,9 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace rocprofiler
 {
@@ -93,6 +96,7 @@ public:
     using callback_map_t = std::unordered_map<ClientID, std::pair<queue_cb_t, completed_cb_t>>;
 
     Queue(const AgentCache& agent, CoreApiTable table);
+    Queue(const AgentCache& agent, CoreApiTable core_api, AmdExtTable ext_api);
     Queue(const AgentCache&  agent,
           uint32_t           size,
           hsa_queue_type32_t type,
@@ -111,6 +115,14 @@ public:
     void create_signal(uint32_t attribute, hsa_signal_t* signal) const;
     void signal_async_handler(const hsa_signal_t& signal, Queue::queue_info_session_t* data) const;
 
+    // Signals and sessions of completed dispatches are recycled so that the steady-state
+    // interception of kernel dispatches does not allocate. Acquired signals have a value of 1,
+    // i.e. they are equivalent to create_signal(0, &signal)
+    hsa_signal_t          acquire_signal();
+    void                  release_signal(hsa_signal_t signal);
+    queue_info_session_t* acquire_session(queue_info_session_t&& session);
+    void                  release_session(queue_info_session_t* session);
+
     template <typename FuncT>
     void signal_callback(FuncT&& func) const;
 
@@ -156,8 +168,25 @@ private:
     queue_state                                       _state           = queue_state::normal;
     std::mutex                                        _lock_queue;
     hsa_signal_t                                      _active_kernels = {.handle = 0};
+
+    // recycled signals + storage for sessions of completed dispatches
+    static constexpr size_t max_pool_size = 1024;
+
+    std::mutex                _pool_mutex   = {};
+    std::vector<hsa_signal_t> _signal_pool  = {};
+    std::vector<void*>        _session_pool = {};
 };
 
+// Intercepts the packets written to the queue (registered via
+// hsa_amd_queue_intercept_register). Internal visibility: never exported from the shared
+// library, only reachable by targets linking the object library (e.g. benchmarks)
+ROCPROFILER_INTERNAL_API void
+WriteInterceptor(const void*                           packets,
+                 uint64_t                              pkt_count,
+                 uint64_t                              user_pkt_index,
+                 void*                                 data,
+                 hsa_amd_queue_intercept_packet_writer writer);
+
 inline rocprofiler_queue_id_t
 Queue::get_id() const
 {
@@ -34,6 +34,7 @@
 
 #include <pthread.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <mutex>
 #include <stdexcept>
@@ -58,14 +59,14 @@ auto affinity_functor(intmax_t)
 }
 
 auto
-get_thread_pool_config()
+get_thread_pool_config(size_t pool_size)
 {
     return thread_pool_config_t{.init         = true,
                                 .use_tbb      = false,
                                 .use_affinity = false,
                                 .verbose      = 0,
                                 .priority     = 0,
-                                .pool_size    = 1,
+                                .pool_size    = pool_size,
                                 .task_queue   = nullptr,
                                 .set_affinity = affinity_functor,
                                 .initializer  = []() {},
@@ -73,8 +74,8 @@ get_thread_pool_config()
 }
 }  // namespace
 
-TaskGroup::TaskGroup()
-: parent_type{new thread_pool_t{get_thread_pool_config()}, false}
+TaskGroup::TaskGroup(size_t pool_size)
+: parent_type{new thread_pool_t{get_thread_pool_config(pool_size)}, false}
 , m_pool{parent_type::thread_pool()}
 {}
 
@@ -218,6 +219,20 @@ get_task_groups()
     return _v;
 }
 
+struct parallel_task_group
+{
+    std::mutex    mutex     = {};
+    bool          finalized = false;
+    task_group_t* group     = nullptr;
+};
+
+parallel_task_group&
+get_parallel_task_group_data()
+{
+    static auto* _v = new parallel_task_group{};
+    return *_v;
+}
+
 void
 create_forked_callback_threads()
 {
@@ -230,6 +245,10 @@ create_forked_callback_threads()
             notify_post_internal_thread_create(ROCPROFILER_LIBRARY);
         }
     }
+
+    // the threads of the parallel task group do not exist in the child: it is created again on
+    // first use
+    get_parallel_task_group_data().group = nullptr;
 }
 }  // namespace
 
@@ -264,6 +283,16 @@ finalize()
         delete get_task_groups();
         get_task_groups() = nullptr;
     }
+
+    auto& _parallel = get_parallel_task_group_data();
+    auto  _lk       = std::unique_lock<std::mutex>{_parallel.mutex};
+    if(_parallel.group)
+    {
+        _parallel.group->join();
+        delete _parallel.group;
+        _parallel.group = nullptr;
+    }
+    _parallel.finalized = true;
 }
 
 void
@@ -303,6 +332,21 @@ get_task_group(rocprofiler_callback_thread_t cb_tid)
     if(!get_task_groups() || get_task_groups()->empty()) return nullptr;
     return get_task_groups()->at(cb_tid.handle);
 }
+
+task_group_t*
+get_parallel_task_group()
+{
+    auto& _parallel = get_parallel_task_group_data();
+    auto  _lk       = std::unique_lock<std::mutex>{_parallel.mutex};
+    if(!_parallel.group && !_parallel.finalized)
+    {
+        notify_pre_internal_thread_create(ROCPROFILER_LIBRARY);
+        _parallel.group =
+            new task_group_t{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+        notify_post_internal_thread_create(ROCPROFILER_LIBRARY);
+    }
+    return _parallel.group;
+}
 }  // namespace internal_threading
 }  // namespace rocprofiler
 
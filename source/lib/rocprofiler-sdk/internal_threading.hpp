@@ -49,7 +49,7 @@ public:
     using parent_type   = PTL::TaskManager;
     using task_type     = PTL::PackagedTask<void>;
 
-    TaskGroup();
+    explicit TaskGroup(size_t pool_size = 1);
     ~TaskGroup() override;
 
     TaskGroup(const TaskGroup&)     = delete;
@@ -87,5 +87,10 @@ create_callback_thread();
 
 // returns the task group for the given callback thread identifier
 task_group_t* get_task_group(rocprofiler_callback_thread_t);
+
+// returns the task group for data-parallel work within the library (one thread per CPU). It is
+// created on first use and destroyed by finalize(): returns nullptr once finalized
+task_group_t*
+get_parallel_task_group();
 }  // namespace internal_threading
 }  // namespace rocprofiler
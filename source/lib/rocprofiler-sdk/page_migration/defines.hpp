@@ -37,7 +37,6 @@
             assert(char_count > 0);                                                                \
             std::string_view event_str{cursor, char_count};                                        \
                                                                                                    \
-            ROCP_INFO << fmt::format("KFD event: [{}]", event_str);                                \
             HANDLER(event_str);                                                                    \
                                                                                                    \
             cursor = pos + 1;                                                                      \
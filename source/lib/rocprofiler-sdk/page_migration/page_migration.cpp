@@ -29,6 +29,7 @@
 #include "lib/rocprofiler-sdk/context/context.hpp"
 #include "lib/rocprofiler-sdk/details/kfd_ioctl.h"
 #include "lib/rocprofiler-sdk/internal_threading.hpp"
+#include "lib/rocprofiler-sdk/page_migration/parser.hpp"
 #include "lib/rocprofiler-sdk/page_migration/utils.hpp"
 
 #include <rocprofiler-sdk/agent.h>
@@ -43,14 +44,14 @@
 
 #include <sys/poll.h>
 #include <unistd.h>
+#include <array>
 #include <atomic>
+#include <bitset>
 #include <cassert>
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
-#include <cstdio>
 #include <cstdlib>
-#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -65,10 +66,6 @@
 #include <sys/eventfd.h>
 #include <sys/ioctl.h>
 
-#define ROCPROFILER_LIB_ROCPROFILER_SDK_PAGE_MIGRATION_PAGE_MIGRATION_CPP_IMPL 1
-#include "page_migration.def.cpp"
-#undef ROCPROFILER_LIB_ROCPROFILER_SDK_PAGE_MIGRATION_PAGE_MIGRATION_CPP_IMPL
-
 namespace rocprofiler
 {
 namespace page_migration
@@ -89,13 +86,6 @@ namespace
 {
 using namespace page_migration;
 
-constexpr auto
-page_to_bytes(size_t val)
-{
-    // each page is 4KB = 4096 bytes
-    return val << 12;
-}
-
 template <typename EnumT, int ValueE>
 struct page_migration_enum_info;
 
@@ -165,273 +155,107 @@ to_string(EnumT val,
     return to_string_impl(val, std::make_index_sequence<last>{});
 }
 
-template <size_t>
-page_migration_record_t parse_uvm_event(std::string_view)
-{
-    ROCP_FATAL_IF(false) << uvm_event_info<ROCPROFILER_UVM_EVENT_NONE>::format_str;
-    return {};
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_PAGE_FAULT_START>(std::string_view str)
-{
-    page_migration_record_t rec{};
-    auto&                   e = rec.page_fault;
-    uint32_t                kind{};
-
-    char fault;
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_PAGE_FAULT_START>::format_str.data(),
-                &kind,
-                &rec.start_timestamp,
-                &rec.pid,
-                &e.address,
-                &e.node_id,
-                &fault);
-
-    e.read_fault = (fault == 'R');
-    e.address    = page_to_bytes(e.address);
-
-    ROCP_INFO << fmt::format("Page fault start [ ts: {} pid: {} addr: 0x{:X} node: {} ] \n",
-                             rec.start_timestamp,
-                             rec.pid,
-                             e.address,
-                             e.node_id);
-
-    return rec;
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_PAGE_FAULT_END>(std::string_view str)
-{
-    page_migration_record_t rec{};
-    auto&                   e = rec.page_fault;
-    uint32_t                kind{};
-
-    char migrated;
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_PAGE_FAULT_END>::format_str.data(),
-                &kind,
-                &rec.end_timestamp,
-                &rec.pid,
-                &e.address,
-                &e.node_id,
-                &migrated);
-
-    // M or U -> migrated / unmigrated?
-    if(migrated == 'M')
-        e.migrated = true;
-    else if(migrated == 'U')
-        e.migrated = false;
-    // else
-    // throw std::runtime_error("Invalid SVM memory migrate type");
-    e.address = page_to_bytes(e.address);
-
-    ROCP_INFO << fmt::format(
-        "Page fault end [ ts: {} pid: {} addr: 0x{:X} node: {} migrated: {} ] \n",
-        rec.end_timestamp,
-        rec.pid,
-        e.address,
-        e.node_id,
-        migrated);
-
-    return rec;
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_MIGRATE_START>(std::string_view str)
-{
-    page_migration_record_t rec{};
-    auto&                   e = rec.page_migrate;
-    uint32_t                kind{};
-    uint32_t                trigger{};
-
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_MIGRATE_START>::format_str.data(),
-                &kind,
-                &rec.start_timestamp,
-                &rec.pid,
-                &e.start_addr,
-                &e.end_addr,
-                &e.from_node,
-                &e.to_node,
-                &e.prefetch_node,
-                &e.preferred_node,
-                &trigger);
-
-    e.end_addr += e.start_addr;
-    e.trigger    = static_cast<migrate_trigger_t>(trigger);
-    e.start_addr = page_to_bytes(e.start_addr);
-    e.end_addr   = page_to_bytes(e.end_addr) - 1;
-
-    ROCP_INFO << fmt::format(
-        "Page migrate start [ ts: {} pid: {} addr s: 0x{:X} addr "
-        "e: 0x{:X} size: {}B from node: {} to node: {} prefetch node: {} preferred node: {} "
-        "trigger: {} ] \n",
-        rec.start_timestamp,
-        rec.pid,
-        e.start_addr,
-        e.end_addr,
-        (e.end_addr - e.start_addr),
-        e.from_node,
-        e.to_node,
-        e.prefetch_node,
-        e.preferred_node,
-        to_string(e.trigger));
-
-    return rec;
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_MIGRATE_END>(std::string_view str)
-{
-    page_migration_record_t rec{};
-    auto&                   e = rec.page_migrate;
-    uint32_t                kind{};
-    uint32_t                trigger{};
-
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_MIGRATE_END>::format_str.data(),
-                &kind,
-                &rec.end_timestamp,
-                &rec.pid,
-                &e.start_addr,
-                &e.end_addr,
-                &e.from_node,
-                &e.to_node,
-                &trigger);
-
-    e.end_addr += e.start_addr;
-    e.trigger    = static_cast<migrate_trigger_t>(trigger);
-    e.start_addr = page_to_bytes(e.start_addr);
-    e.end_addr   = page_to_bytes(e.end_addr) - 1;
-
-    ROCP_INFO << fmt::format("Page migrate end [ ts: {} pid: {} addr s: 0x{:X} addr e: "
-                             "0x{:X} from node: {} to node: {} trigger: {} ] \n",
-                             rec.end_timestamp,
-                             rec.pid,
-                             e.start_addr,
-                             e.end_addr,
-                             e.from_node,
-                             e.to_node,
-                             to_string(e.trigger));
-
-    return rec;
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_QUEUE_EVICTION>(std::string_view str)
-{
-    page_migration_record_t rec{};
-    auto&                   e = rec.queue_suspend;
-    uint32_t                kind{};
-    uint32_t                trigger{};
-
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_QUEUE_EVICTION>::format_str.data(),
-                &kind,
-                &rec.start_timestamp,
-                &rec.pid,
-                &e.node_id,
-                &trigger);
-
-    rec.queue_suspend.trigger = static_cast<qsuspend_trigger_t>(trigger);
-
-    ROCP_INFO << fmt::format("Queue evict [ ts: {} pid: {} node: {} trigger: {} ] \n",
-                             rec.start_timestamp,
-                             rec.pid,
-                             e.node_id,
-                             to_string(e.trigger));
-
-    return rec;
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_QUEUE_RESTORE>(std::string_view str)
-{
-    page_migration_record_t rec{};
-    auto&                   e = rec.queue_suspend;
-    uint32_t                kind{};
-
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_QUEUE_RESTORE>::format_str.data(),
-                &kind,
-                &rec.end_timestamp,
-                &rec.pid,
-                &e.node_id);
-    // check if we have a valid char at the end. -1 has \0
-    if(str[str.size() - 2] == 'R')
-        e.rescheduled = true;
-    else
-        e.rescheduled = false;
-
-    ROCP_INFO << fmt::format(
-        "Queue restore [ ts: {} pid: {} node: {} ] \n", rec.end_timestamp, rec.pid, e.node_id);
-
-    return rec;
-}
-
-template <>
-page_migration_record_t
-parse_uvm_event<ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU>(std::string_view str)
+// the events are only formatted for the log when INFO messages are emitted
+bool
+info_logging_enabled()
 {
-    page_migration_record_t rec{};
-    auto&                   e = rec.unmap_from_gpu;
-    uint32_t                kind{};
-    uint32_t                trigger{};
-
-    std::sscanf(str.data(),
-                uvm_event_info<ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU>::format_str.data(),
-                &kind,
-                &rec.start_timestamp,
-                &rec.pid,
-                &e.start_addr,
-                &e.end_addr,
-                &e.node_id,
-                &trigger);
-
-    e.end_addr += e.start_addr;
-    rec.end_timestamp          = rec.start_timestamp;
-    rec.unmap_from_gpu.trigger = static_cast<unmap_trigger_t>(trigger);
-    e.start_addr               = page_to_bytes(e.start_addr);
-    e.end_addr                 = page_to_bytes(e.end_addr);
-
-    ROCP_INFO << fmt::format("Unmap from GPU [ ts: {} pid: {} start addr: 0x{:X} end addr: 0x{:X}  "
-                             "node: {} trigger {} ] \n",
-                             rec.start_timestamp,
-                             rec.pid,
-                             e.start_addr,
-                             e.end_addr,
-                             e.node_id,
-                             to_string(e.trigger));
-
-    return rec;
+    return FLAGS_minloglevel <= google::GLOG_INFO;
 }
 
-template <size_t OpInx, size_t... OpInxs>
-page_migration_record_t
-parse_uvm_event(uvm_event_id_t   event_id,
-                std::string_view strn,
-                std::index_sequence<OpInx, OpInxs...>)
+void
+log_uvm_event(uvm_event_id_t event_id, const page_migration_record_t& rec)
 {
-    if(OpInx == static_cast<uint32_t>(event_id))
+    switch(static_cast<uint32_t>(event_id))
     {
-        auto rec      = parse_uvm_event<OpInx>(strn);
-        rec.size      = sizeof(page_migration_record_t);
-        rec.kind      = ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION;
-        rec.operation = to_rocprof_op(OpInx);
-        return rec;
+        case ROCPROFILER_UVM_EVENT_PAGE_FAULT_START:
+        {
+            const auto& e = rec.page_fault;
+            ROCP_INFO << fmt::format("Page fault start [ ts: {} pid: {} addr: 0x{:X} node: {} ] \n",
+                                     rec.start_timestamp,
+                                     rec.pid,
+                                     e.address,
+                                     e.node_id);
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_PAGE_FAULT_END:
+        {
+            const auto& e = rec.page_fault;
+            ROCP_INFO << fmt::format(
+                "Page fault end [ ts: {} pid: {} addr: 0x{:X} node: {} migrated: {} ] \n",
+                rec.end_timestamp,
+                rec.pid,
+                e.address,
+                e.node_id,
+                e.migrated ? 'M' : 'U');
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_MIGRATE_START:
+        {
+            const auto& e = rec.page_migrate;
+            ROCP_INFO << fmt::format(
+                "Page migrate start [ ts: {} pid: {} addr s: 0x{:X} addr "
+                "e: 0x{:X} size: {}B from node: {} to node: {} prefetch node: {} preferred node: "
+                "{} trigger: {} ] \n",
+                rec.start_timestamp,
+                rec.pid,
+                e.start_addr,
+                e.end_addr,
+                (e.end_addr - e.start_addr),
+                e.from_node,
+                e.to_node,
+                e.prefetch_node,
+                e.preferred_node,
+                to_string(e.trigger));
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_MIGRATE_END:
+        {
+            const auto& e = rec.page_migrate;
+            ROCP_INFO << fmt::format("Page migrate end [ ts: {} pid: {} addr s: 0x{:X} addr e: "
+                                     "0x{:X} from node: {} to node: {} trigger: {} ] \n",
+                                     rec.end_timestamp,
+                                     rec.pid,
+                                     e.start_addr,
+                                     e.end_addr,
+                                     e.from_node,
+                                     e.to_node,
+                                     to_string(e.trigger));
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_QUEUE_EVICTION:
+        {
+            const auto& e = rec.queue_suspend;
+            ROCP_INFO << fmt::format("Queue evict [ ts: {} pid: {} node: {} trigger: {} ] \n",
+                                     rec.start_timestamp,
+                                     rec.pid,
+                                     e.node_id,
+                                     to_string(e.trigger));
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_QUEUE_RESTORE:
+        {
+            ROCP_INFO << fmt::format("Queue restore [ ts: {} pid: {} node: {} ] \n",
+                                     rec.end_timestamp,
+                                     rec.pid,
+                                     rec.queue_suspend.node_id);
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU:
+        {
+            const auto& e = rec.unmap_from_gpu;
+            ROCP_INFO << fmt::format(
+                "Unmap from GPU [ ts: {} pid: {} start addr: 0x{:X} end addr: 0x{:X}  "
+                "node: {} trigger {} ] \n",
+                rec.start_timestamp,
+                rec.pid,
+                e.start_addr,
+                e.end_addr,
+                e.node_id,
+                to_string(e.trigger));
+            break;
+        }
+        default: break;
     }
-    else if constexpr(sizeof...(OpInxs) > 0)
-        return parse_uvm_event(event_id, strn, std::index_sequence<OpInxs...>{});
-    else
-        return page_migration_record_t{};
 }
 
 /* -----------------------------------------------------------------------------------*/
@@ -516,12 +340,6 @@ get_key<ROCPROFILER_PAGE_MIGRATION_QUEUE_SUSPEND>(
 
 /* -----------------------------------------------------------------------------------*/
 
-template <>
-page_migration_record_t parse_uvm_event<0>(std::string_view)
-{
-    throw std::runtime_error("None Op for parsing UVM events should not happen");
-}
-
 template <>
 void
 update_end<ROCPROFILER_UVM_EVENT_NONE>(const page_migration_record_t&, page_migration_record_t&)
@@ -616,25 +434,6 @@ kfd_bitmask(const small_vector<size_t>& rocprof_event_ids, std::index_sequence<O
     return m;
 }
 
-template <size_t OpInx, size_t... OpInxs>
-constexpr size_t
-to_uvm_op_impl(size_t kfd_id, std::index_sequence<OpInx, OpInxs...>)
-{
-    // if(kfd_id == uvm_event_info<OpInx>::kfd_event) return uvm_event_info<OpInx>::uvm_event;
-    if(kfd_id == uvm_event_info<OpInx>::kfd_event) return OpInx;
-    if constexpr(sizeof...(OpInxs) > 0)
-        return to_uvm_op_impl(kfd_id, std::index_sequence<OpInxs...>{});
-    else
-        return 0;
-}
-
-constexpr uvm_event_id_t
-kfd_to_uvm_op(kfd_event_id_t kfd_id)
-{
-    return static_cast<uvm_event_id_t>(
-        to_uvm_op_impl(kfd_id, std::make_index_sequence<ROCPROFILER_UVM_EVENT_LAST>{}));
-}
-
 struct buffered_context_data
 {
     const context::context* ctx = nullptr;
@@ -716,34 +515,56 @@ report_event(uvm_event_id_t                                      event_id,
     }
 }
 
+// handles all the events returned by one read() of a GPU node's SMI file descriptor
 void
-handle_reporting(std::string_view event_data)
+handle_reporting(std::string_view event_batch)
 {
-    uint32_t kfd_event_id;
-    std::sscanf(event_data.data(), "%x ", &kfd_event_id);
-    std::vector<buffered_context_data> buffered_contexts{};
+    using contexts_array_t =
+        std::array<std::vector<buffered_context_data>, ROCPROFILER_PAGE_MIGRATION_LAST>;
+
+    // the contexts of each operation are looked up once per batch instead of once per event and
+    // the storage is reused across batches
+    static thread_local auto buffered_contexts = contexts_array_t{};
+    auto                     populated         = std::bitset<ROCPROFILER_PAGE_MIGRATION_LAST>{};
+    const auto               log_event         = info_logging_enabled();
 
-    auto uvm_event_op = kfd_to_uvm_op(static_cast<kfd_event_id_t>(kfd_event_id));
+    auto&& handle_event = [&](std::string_view event_data) {
+        ROCP_INFO_IF(log_event) << "KFD event: [" << event_data << "]";
 
-    populate_contexts(uvm_event_op, buffered_contexts);
-    if(buffered_contexts.empty()) return;
+        auto record       = page_migration_record_t{};
+        auto uvm_event_op = parse_kfd_event(event_data, record);
+        if(uvm_event_op == ROCPROFILER_UVM_EVENT_NONE)
+        {
+            ROCP_INFO_IF(log_event) << "Ignoring unknown KFD event: [" << event_data << "]";
+            return;
+        }
 
-    // Parse and process the event
-    auto record = parse_uvm_event(
-        uvm_event_op, event_data, std::make_index_sequence<ROCPROFILER_UVM_EVENT_LAST>{});
+        if(log_event) log_uvm_event(uvm_event_op, record);
 
-    // pair up start and end and only then insert it into the buffer
-    if(report_event(uvm_event_op, record))
-    {
-        for(const auto& itr : buffered_contexts)
+        auto  operation = to_rocprof_op(uvm_event_op);
+        auto& contexts  = buffered_contexts.at(operation);
+        if(!populated.test(operation))
         {
-            auto* _buffer = buffer::get_buffer(itr.ctx->buffered_tracer->buffer_data.at(
-                ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION));
-            CHECK_NOTNULL(_buffer)->emplace(ROCPROFILER_BUFFER_CATEGORY_TRACING,
-                                            ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION,
-                                            record);
+            populate_contexts(operation, contexts);
+            populated.set(operation);
         }
-    }
+        if(contexts.empty()) return;
+
+        // pair up start and end and only then insert it into the buffer
+        if(report_event(uvm_event_op, record))
+        {
+            for(const auto& itr : contexts)
+            {
+                auto* _buffer = buffer::get_buffer(itr.ctx->buffered_tracer->buffer_data.at(
+                    ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION));
+                CHECK_NOTNULL(_buffer)->emplace(ROCPROFILER_BUFFER_CATEGORY_TRACING,
+                                                ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION,
+                                                record);
+            }
+        }
+    };
+
+    KFD_EVENT_PARSE_EVENTS(event_batch, handle_event);
 }
 
 }  // namespace
@@ -899,14 +720,6 @@ struct poll_kfd_t
         active = true;
     }
 
-    static auto get_event_id(const std::string_view& strn)
-    {
-        uint32_t event_id{std::numeric_limits<uint32_t>::max()};
-        std::sscanf(strn.data(), "%x ", &event_id);
-
-        CHECK(event_id <= KFD_SMI_EVENT_ALL_PROCESS);
-    }
-
     poll_kfd_t(const poll_kfd_t&) = delete;
     poll_kfd_t& operator=(const poll_kfd_t&) = delete;
 
@@ -1024,7 +837,7 @@ poll_events(small_vector<pollfd> file_handles, bool non_blocking)
 
                 // ROCP_INFO << fmt::format("Raw KFD string [({})]\n",
                 // event_strings.data());
-                KFD_EVENT_PARSE_EVENTS(event_strings, handle_reporting);
+                handle_reporting(event_strings);
             }
             fd.revents = 0;
         }
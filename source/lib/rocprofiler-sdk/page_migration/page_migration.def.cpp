@@ -31,15 +31,16 @@ namespace rocprofiler
 namespace page_migration
 {
 // clang-format off
-// Map ROCPROF UVM enums to KFD enums
+// Map ROCPROF UVM enums to KFD enums. The format strings describe the event after the KFD
+// event id (i.e. "%x ") which prefixes every event
 SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_NONE,             KFD_SMI_EVENT_NONE,             "Error: Invalid UVM event from KFD" );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_MIGRATE_START,    KFD_SMI_EVENT_MIGRATE_START,    "%x %ld -%d @%lx(%lx) %x->%x %x:%x %d\n" );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_MIGRATE_END,      KFD_SMI_EVENT_MIGRATE_END,      "%x %ld -%d @%lx(%lx) %x->%x %d\n"       );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_PAGE_FAULT_START, KFD_SMI_EVENT_PAGE_FAULT_START, "%x %ld -%d @%lx(%x) %c\n"               );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_PAGE_FAULT_END,   KFD_SMI_EVENT_PAGE_FAULT_END,   "%x %ld -%d @%lx(%x) %c\n"               );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_QUEUE_EVICTION,   KFD_SMI_EVENT_QUEUE_EVICTION,   "%x %ld -%d %x %d\n"                     );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_QUEUE_RESTORE,    KFD_SMI_EVENT_QUEUE_RESTORE,    "%x %ld -%d %x\n"                        );
-SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU,   KFD_SMI_EVENT_UNMAP_FROM_GPU,   "%x %ld -%d @%lx(%lx) %x %d\n"          );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_MIGRATE_START,    KFD_SMI_EVENT_MIGRATE_START,    "%ld -%d @%lx(%lx) %x->%x %x:%x %d\n"    );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_MIGRATE_END,      KFD_SMI_EVENT_MIGRATE_END,      "%ld -%d @%lx(%lx) %x->%x %d\n"          );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_PAGE_FAULT_START, KFD_SMI_EVENT_PAGE_FAULT_START, "%ld -%d @%lx(%x) %c\n"                  );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_PAGE_FAULT_END,   KFD_SMI_EVENT_PAGE_FAULT_END,   "%ld -%d @%lx(%x) %c\n"                  );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_QUEUE_EVICTION,   KFD_SMI_EVENT_QUEUE_EVICTION,   "%ld -%d %x %d\n"                        );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_QUEUE_RESTORE,    KFD_SMI_EVENT_QUEUE_RESTORE,    "%ld -%d %x\n"                           );
+SPECIALIZE_UVM_KFD_EVENT(ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU,   KFD_SMI_EVENT_UNMAP_FROM_GPU,   "%ld -%d @%lx(%lx) %x %d\n"             );
 // clang-format on
 #    undef SPECIALIZE_UVM_KFD_EVENT
 
@@ -0,0 +1,369 @@
+// MIT License
+//
+// Copyright (c) 2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "lib/rocprofiler-sdk/details/kfd_ioctl.h"
+#include "lib/rocprofiler-sdk/page_migration/defines.hpp"
+#include "lib/rocprofiler-sdk/page_migration/utils.hpp"
+
+#include <rocprofiler-sdk/buffer_tracing.h>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#define ROCPROFILER_LIB_ROCPROFILER_SDK_PAGE_MIGRATION_PAGE_MIGRATION_CPP_IMPL 1
+#include "lib/rocprofiler-sdk/page_migration/page_migration.def.cpp"
+#undef ROCPROFILER_LIB_ROCPROFILER_SDK_PAGE_MIGRATION_PAGE_MIGRATION_CPP_IMPL
+
+namespace rocprofiler
+{
+namespace page_migration
+{
+using page_migration_record_t = rocprofiler_buffer_tracing_page_migration_record_t;
+
+// Allocation-free replacement of std::sscanf for the KFD SMI event formats in
+// page_migration.def.cpp. Only the %x, %d and %c conversions (with an optional 'l' length
+// modifier) are supported.
+namespace parse
+{
+inline void
+skip_whitespace(std::string_view& str)
+{
+    while(!str.empty() && (str.front() == ' ' || str.front() == '\t'))
+        str.remove_prefix(1);
+}
+
+// matches the literal characters of the format up to the next conversion. Like sscanf, a
+// whitespace in the format matches any amount of whitespace (including none) in the input
+inline bool
+scan_literals(std::string_view& str, std::string_view& fmt)
+{
+    while(!fmt.empty() && fmt.front() != '%')
+    {
+        if(fmt.front() == ' ' || fmt.front() == '\n')
+            skip_whitespace(str);
+        else if(!str.empty() && str.front() == fmt.front())
+            str.remove_prefix(1);
+        else
+            return false;
+        fmt.remove_prefix(1);
+    }
+    return !fmt.empty();
+}
+
+template <typename Tp>
+bool
+scan_value(std::string_view& str, std::string_view& fmt, Tp& value)
+{
+    static_assert(std::is_integral<Tp>::value, "only integer conversions are supported");
+
+    fmt.remove_prefix(1);
+    while(!fmt.empty() && fmt.front() == 'l')
+        fmt.remove_prefix(1);
+    if(fmt.empty()) return false;
+
+    const auto conversion = fmt.front();
+    fmt.remove_prefix(1);
+
+    if(conversion == 'c')
+    {
+        if(str.empty()) return false;
+        value = static_cast<Tp>(str.front());
+        str.remove_prefix(1);
+        return true;
+    }
+
+    skip_whitespace(str);
+    const int base    = (conversion == 'x') ? 16 : 10;
+    auto [_end, _err] = std::from_chars(str.data(), str.data() + str.size(), value, base);
+    if(_err != std::errc{}) return false;
+    str.remove_prefix(_end - str.data());
+    return true;
+}
+
+/**
+ * @brief Parses @p str according to @p fmt into @p args
+ * @returns true if every conversion succeeded
+ */
+template <typename... Args>
+bool
+scan(std::string_view str, std::string_view fmt, Args&... args)
+{
+    return ((scan_literals(str, fmt) && scan_value(str, fmt, args)) && ...);
+}
+
+/**
+ * @brief Removes the hexadecimal KFD event id which prefixes every SMI event from @p event
+ * @returns the KFD event id or KFD_SMI_EVENT_NONE if the event is malformed
+ */
+inline uint32_t
+event_id(std::string_view& event)
+{
+    uint32_t _id      = KFD_SMI_EVENT_NONE;
+    auto [_end, _err] = std::from_chars(event.data(), event.data() + event.size(), _id, 16);
+    if(_err != std::errc{} || _id > KFD_SMI_EVENT_ALL_PROCESS) return KFD_SMI_EVENT_NONE;
+    event.remove_prefix(_end - event.data());
+    return _id;
+}
+}  // namespace parse
+
+constexpr auto
+page_to_bytes(size_t val)
+{
+    // each page is 4KB = 4096 bytes
+    return val << 12;
+}
+
+template <size_t OpInx, size_t... OpInxs>
+constexpr size_t
+to_uvm_op_impl(size_t kfd_id, std::index_sequence<OpInx, OpInxs...>)
+{
+    if(kfd_id == uvm_event_info<OpInx>::kfd_event) return OpInx;
+    if constexpr(sizeof...(OpInxs) > 0)
+        return to_uvm_op_impl(kfd_id, std::index_sequence<OpInxs...>{});
+    else
+        return 0;
+}
+
+constexpr uvm_event_id_t
+kfd_to_uvm_op(size_t kfd_id)
+{
+    return static_cast<uvm_event_id_t>(
+        to_uvm_op_impl(kfd_id, std::make_index_sequence<ROCPROFILER_UVM_EVENT_LAST>{}));
+}
+
+// The parsers below receive the event without its KFD event id (see parse::event_id)
+template <size_t>
+bool
+parse_uvm_event(std::string_view, page_migration_record_t&)
+{
+    return false;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_PAGE_FAULT_START>(std::string_view         str,
+                                                        page_migration_record_t& rec)
+{
+    auto& e     = rec.page_fault;
+    char  fault = '\0';
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_PAGE_FAULT_START>::format_str,
+                    rec.start_timestamp,
+                    rec.pid,
+                    e.address,
+                    e.node_id,
+                    fault))
+        return false;
+
+    e.read_fault = (fault == 'R');
+    e.address    = page_to_bytes(e.address);
+    return true;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_PAGE_FAULT_END>(std::string_view         str,
+                                                      page_migration_record_t& rec)
+{
+    auto& e        = rec.page_fault;
+    char  migrated = '\0';
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_PAGE_FAULT_END>::format_str,
+                    rec.end_timestamp,
+                    rec.pid,
+                    e.address,
+                    e.node_id,
+                    migrated))
+        return false;
+
+    // M or U -> migrated / unmigrated
+    e.migrated = (migrated == 'M');
+    e.address  = page_to_bytes(e.address);
+    return true;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_MIGRATE_START>(std::string_view         str,
+                                                     page_migration_record_t& rec)
+{
+    auto&    e       = rec.page_migrate;
+    uint32_t trigger = 0;
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_MIGRATE_START>::format_str,
+                    rec.start_timestamp,
+                    rec.pid,
+                    e.start_addr,
+                    e.end_addr,
+                    e.from_node,
+                    e.to_node,
+                    e.prefetch_node,
+                    e.preferred_node,
+                    trigger))
+        return false;
+
+    e.end_addr += e.start_addr;
+    e.trigger    = static_cast<rocprofiler_page_migration_trigger_t>(trigger);
+    e.start_addr = page_to_bytes(e.start_addr);
+    e.end_addr   = page_to_bytes(e.end_addr) - 1;
+    return true;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_MIGRATE_END>(std::string_view         str,
+                                                   page_migration_record_t& rec)
+{
+    auto&    e       = rec.page_migrate;
+    uint32_t trigger = 0;
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_MIGRATE_END>::format_str,
+                    rec.end_timestamp,
+                    rec.pid,
+                    e.start_addr,
+                    e.end_addr,
+                    e.from_node,
+                    e.to_node,
+                    trigger))
+        return false;
+
+    e.end_addr += e.start_addr;
+    e.trigger    = static_cast<rocprofiler_page_migration_trigger_t>(trigger);
+    e.start_addr = page_to_bytes(e.start_addr);
+    e.end_addr   = page_to_bytes(e.end_addr) - 1;
+    return true;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_QUEUE_EVICTION>(std::string_view         str,
+                                                      page_migration_record_t& rec)
+{
+    auto&    e       = rec.queue_suspend;
+    uint32_t trigger = 0;
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_QUEUE_EVICTION>::format_str,
+                    rec.start_timestamp,
+                    rec.pid,
+                    e.node_id,
+                    trigger))
+        return false;
+
+    e.trigger = static_cast<rocprofiler_page_migration_queue_suspend_trigger_t>(trigger);
+    return true;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_QUEUE_RESTORE>(std::string_view         str,
+                                                     page_migration_record_t& rec)
+{
+    auto& e = rec.queue_suspend;
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_QUEUE_RESTORE>::format_str,
+                    rec.end_timestamp,
+                    rec.pid,
+                    e.node_id))
+        return false;
+
+    // the node is followed by 'R' when the queue was rescheduled
+    e.rescheduled = (str.back() == 'R');
+    return true;
+}
+
+template <>
+inline bool
+parse_uvm_event<ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU>(std::string_view         str,
+                                                      page_migration_record_t& rec)
+{
+    auto&    e       = rec.unmap_from_gpu;
+    uint32_t trigger = 0;
+
+    if(!parse::scan(str,
+                    uvm_event_info<ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU>::format_str,
+                    rec.start_timestamp,
+                    rec.pid,
+                    e.start_addr,
+                    e.end_addr,
+                    e.node_id,
+                    trigger))
+        return false;
+
+    e.end_addr += e.start_addr;
+    rec.end_timestamp = rec.start_timestamp;
+    e.trigger         = static_cast<rocprofiler_page_migration_unmap_from_gpu_trigger_t>(trigger);
+    e.start_addr      = page_to_bytes(e.start_addr);
+    e.end_addr        = page_to_bytes(e.end_addr);
+    return true;
+}
+
+template <size_t OpInx, size_t... OpInxs>
+bool
+parse_uvm_event(uvm_event_id_t           event_id,
+                std::string_view         strn,
+                page_migration_record_t& rec,
+                std::index_sequence<OpInx, OpInxs...>)
+{
+    if(OpInx == static_cast<uint32_t>(event_id))
+    {
+        rec           = page_migration_record_t{};
+        rec.size      = sizeof(page_migration_record_t);
+        rec.kind      = ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION;
+        rec.operation = to_rocprof_op(OpInx);
+        return parse_uvm_event<OpInx>(strn, rec);
+    }
+    else if constexpr(sizeof...(OpInxs) > 0)
+        return parse_uvm_event(event_id, strn, rec, std::index_sequence<OpInxs...>{});
+    else
+        return false;
+}
+
+/**
+ * @brief Parses one SMI event (without the trailing newline) into @p rec
+ * @returns the UVM event id or ROCPROFILER_UVM_EVENT_NONE if the event is unknown or malformed
+ */
+inline uvm_event_id_t
+parse_kfd_event(std::string_view event, page_migration_record_t& rec)
+{
+    auto _uvm_id = kfd_to_uvm_op(parse::event_id(event));
+    if(_uvm_id == ROCPROFILER_UVM_EVENT_NONE) return ROCPROFILER_UVM_EVENT_NONE;
+
+    if(!parse_uvm_event(
+           _uvm_id, event, rec, std::make_index_sequence<ROCPROFILER_UVM_EVENT_LAST>{}))
+        return ROCPROFILER_UVM_EVENT_NONE;
+    return _uvm_id;
+}
+}  // namespace page_migration
+}  // namespace rocprofiler
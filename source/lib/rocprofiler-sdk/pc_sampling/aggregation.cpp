@@ -0,0 +1,229 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/pc_sampling/aggregation.hpp"
+#include "lib/common/utility.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace pc_sampling
+{
+namespace
+{
+inline size_t
+hash_combine(size_t seed, uint64_t value)
+{
+    return seed ^ (std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15UL + (seed << 6) + (seed >> 2));
+}
+}  // namespace
+
+bool
+PCSAggregator::hist_key_t::operator==(const hist_key_t& rhs) const
+{
+    return code_object_offset == rhs.code_object_offset && code_object_id == rhs.code_object_id &&
+           exec_mask == rhs.exec_mask && snapshot == rhs.snapshot && flags == rhs.flags &&
+           wave_issued == rhs.wave_issued;
+}
+
+size_t
+PCSAggregator::key_hash::operator()(const hist_key_t& key) const
+{
+    auto _v = std::hash<uint64_t>{}(key.code_object_offset);
+    _v      = hash_combine(_v, key.code_object_id);
+    _v      = hash_combine(_v, key.exec_mask);
+    _v      = hash_combine(_v,
+                      (uint64_t{key.snapshot} << 16) | (uint64_t{key.flags} << 8) |
+                          uint64_t{key.wave_issued});
+    return _v;
+}
+
+PCSAggregator::PCSAggregator(uint64_t flush_interval_ns, emit_fn_t emit_fn)
+: m_flush_interval{flush_interval_ns}
+, m_emit{std::move(emit_fn)}
+, m_last_flush{common::timestamp_ns()}
+{}
+
+void
+PCSAggregator::load_code_object(uint64_t code_object_id, uint64_t load_base, uint64_t load_size)
+{
+    auto _range = code_object_range_t{load_base, load_base + load_size, code_object_id};
+
+    std::unique_lock<std::shared_mutex> lock(m_code_objects_mut);
+    auto _pos = std::upper_bound(
+        m_code_objects.begin(),
+        m_code_objects.end(),
+        _range,
+        [](const auto& lhs, const auto& rhs) { return lhs.begin < rhs.begin; });
+    m_code_objects.insert(_pos, _range);
+}
+
+void
+PCSAggregator::unload_code_object(uint64_t code_object_id)
+{
+    std::unique_lock<std::shared_mutex> lock(m_code_objects_mut);
+    m_code_objects.erase(
+        std::remove_if(m_code_objects.begin(),
+                       m_code_objects.end(),
+                       [code_object_id](const auto& itr) {
+                           return itr.code_object_id == code_object_id;
+                       }),
+        m_code_objects.end());
+}
+
+// requires the shared lock of m_code_objects_mut
+PCSAggregator::hist_key_t
+PCSAggregator::make_key(const rocprofiler_pc_sampling_record_t& sample) const
+{
+    auto _key               = hist_key_t{};
+    _key.code_object_offset = sample.pc;
+    _key.exec_mask          = sample.exec_mask;
+    _key.wave_issued        = sample.wave_issued;
+    std::memcpy(&_key.flags, &sample.flags, sizeof(_key.flags));
+    if(sample.flags.has_stall_reason != 0)
+        std::memcpy(&_key.snapshot, &sample.snapshot, sizeof(_key.snapshot));
+
+    // last code object loaded at or below the pc
+    auto _itr = std::upper_bound(
+        m_code_objects.begin(),
+        m_code_objects.end(),
+        sample.pc,
+        [](uint64_t pc, const code_object_range_t& range) { return pc < range.begin; });
+    if(_itr != m_code_objects.begin() && sample.pc < std::prev(_itr)->end)
+    {
+        _key.code_object_id = std::prev(_itr)->code_object_id;
+        _key.code_object_offset -= std::prev(_itr)->begin;
+    }
+
+    return _key;
+}
+
+void
+PCSAggregator::add(const rocprofiler_pc_sampling_record_t* samples, size_t num_samples)
+{
+    if(num_samples == 0) return;
+
+    // translate the samples and group them by shard
+    auto _keys   = std::vector<std::pair<hist_key_t, size_t>>{};
+    auto _offset = std::array<size_t, num_shards + 1>{};
+    _keys.reserve(num_samples);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_code_objects_mut);
+        for(size_t i = 0; i < num_samples; ++i)
+        {
+            auto _key   = make_key(samples[i]);
+            auto _shard = key_hash{}(_key) % num_shards;
+            _keys.emplace_back(_key, _shard);
+            ++_offset.at(_shard + 1);
+        }
+    }
+
+    for(size_t i = 1; i < _offset.size(); ++i)
+        _offset.at(i) += _offset.at(i - 1);
+
+    auto _grouped = std::vector<hist_key_t>(num_samples);
+    {
+        auto _next = _offset;
+        for(const auto& [key, shard] : _keys)
+            _grouped.at(_next.at(shard)++) = key;
+    }
+
+    for(size_t i = 0; i < num_shards; ++i)
+    {
+        if(_offset.at(i) == _offset.at(i + 1)) continue;
+
+        auto&                        _shard = m_shards.at(i);
+        std::unique_lock<std::mutex> lock(_shard.mut);
+        for(size_t j = _offset.at(i); j < _offset.at(i + 1); ++j)
+            ++_shard.counts[_grouped.at(j)];
+    }
+}
+
+void
+PCSAggregator::flush()
+{
+    auto _records = std::vector<record_t>{};
+
+    // the records are emitted without holding any lock: emitting into a lossless buffer may
+    // wait for the buffer callback, which may flush this aggregator again
+    std::unique_lock<std::mutex> flush_lock(m_flush_mut);
+    for(auto& _shard : m_shards)
+    {
+        std::unique_lock<std::mutex> lock(_shard.mut);
+        for(auto itr = _shard.counts.begin(); itr != _shard.counts.end();)
+        {
+            // evict the keys that were not sampled since the previous flush
+            if(itr->second == 0)
+            {
+                itr = _shard.counts.erase(itr);
+                continue;
+            }
+
+            const auto& _key        = itr->first;
+            auto        _rec        = common::init_public_api_struct(record_t{});
+            _rec.wave_issued        = _key.wave_issued;
+            _rec.code_object_id     = _key.code_object_id;
+            _rec.code_object_offset = _key.code_object_offset;
+            _rec.exec_mask          = _key.exec_mask;
+            _rec.count              = std::exchange(itr->second, 0);
+            std::memcpy(&_rec.flags, &_key.flags, sizeof(_key.flags));
+            std::memcpy(&_rec.snapshot, &_key.snapshot, sizeof(_key.snapshot));
+            _records.emplace_back(_rec);
+            ++itr;
+        }
+    }
+
+    m_last_flush.store(common::timestamp_ns(), std::memory_order_relaxed);
+    flush_lock.unlock();
+
+    if(!_records.empty()) m_emit(_records.data(), _records.size());
+}
+
+void
+PCSAggregator::flush_if_due()
+{
+    if(m_flush_interval == 0) return;
+
+    auto _last = m_last_flush.load(std::memory_order_relaxed);
+    auto _now  = common::timestamp_ns();
+    if(_now < _last + m_flush_interval) return;
+
+    // only one of the threads observing an elapsed interval flushes
+    if(m_last_flush.compare_exchange_strong(_last, _now, std::memory_order_relaxed)) flush();
+}
+
+size_t
+PCSAggregator::size() const
+{
+    size_t _v = 0;
+    for(const auto& _shard : m_shards)
+    {
+        std::unique_lock<std::mutex> lock(_shard.mut);
+        _v += _shard.counts.size();
+    }
+    return _v;
+}
+}  // namespace pc_sampling
+}  // namespace rocprofiler
@@ -0,0 +1,130 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/pc_sampling.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace pc_sampling
+{
+/**
+ * @brief Histogram of the PC samples of a single agent.
+ *
+ * Instead of placing every ::rocprofiler_pc_sampling_record_t in the SDK's buffer, the samples
+ * are counted per (code object, offset within the code object, exec mask, flags, stall/issue
+ * reason) key. The correlation id, timestamp, and the hardware/wave identifiers of the samples
+ * are dropped. A flush emits one ::rocprofiler_pc_sampling_aggregate_record_t per key whose
+ * count changed since the previous flush and resets the counts. Keys that stay unchanged for a
+ * whole flush interval are evicted, so the histogram only holds the recently sampled keys.
+ *
+ * The histogram is split into shards, each protected by its own lock, so the threads
+ * delivering the samples of different ROCr buffers rarely contend with each other. A batch of
+ * samples locks every shard at most once.
+ *
+ * PCSAggregator is a singleton per PCSAgentSession.
+ */
+class PCSAggregator
+{
+public:
+    using record_t  = rocprofiler_pc_sampling_aggregate_record_t;
+    using emit_fn_t = std::function<void(const record_t*, size_t)>;
+
+    static constexpr size_t num_shards = 16;
+
+    /// @param flush_interval_ns minimum number of nanoseconds between the flushes initiated by
+    /// @ref flush_if_due. Zero disables these flushes.
+    /// @param emit_fn receives the records generated by a flush
+    PCSAggregator(uint64_t flush_interval_ns, emit_fn_t emit_fn);
+
+    /// Samples whose PC is in [@p load_base, @p load_base + @p load_size) are attributed to
+    /// the code object with @p code_object_id.
+    void load_code_object(uint64_t code_object_id, uint64_t load_base, uint64_t load_size);
+    void unload_code_object(uint64_t code_object_id);
+
+    /// Counts @p num_samples samples.
+    void add(const rocprofiler_pc_sampling_record_t* samples, size_t num_samples);
+
+    /// Emits the counts accumulated since the previous flush.
+    void flush();
+
+    /// Calls @ref flush if at least flush interval nanoseconds elapsed since the previous flush.
+    void flush_if_due();
+
+    /// Number of keys currently held by the histogram.
+    size_t size() const;
+
+private:
+    struct hist_key_t
+    {
+        uint64_t code_object_id     = 0;
+        uint64_t code_object_offset = 0;
+        uint64_t exec_mask          = 0;
+        uint32_t snapshot           = 0;
+        uint8_t  flags              = 0;
+        uint8_t  wave_issued        = 0;
+
+        bool operator==(const hist_key_t& rhs) const;
+    };
+
+    struct key_hash
+    {
+        size_t operator()(const hist_key_t& key) const;
+    };
+
+    struct shard_t
+    {
+        mutable std::mutex                                 mut;
+        std::unordered_map<hist_key_t, uint64_t, key_hash> counts;
+    };
+
+    struct code_object_range_t
+    {
+        uint64_t begin          = 0;
+        uint64_t end            = 0;
+        uint64_t code_object_id = 0;
+    };
+
+    hist_key_t make_key(const rocprofiler_pc_sampling_record_t& sample) const;
+
+    const uint64_t                   m_flush_interval;
+    const emit_fn_t                  m_emit;
+    std::array<shard_t, num_shards>  m_shards           = {};
+    std::atomic<uint64_t>            m_last_flush       = {0};
+    std::mutex                       m_flush_mut        = {};
+    mutable std::shared_mutex        m_code_objects_mut = {};
+    std::vector<code_object_range_t> m_code_objects     = {};
+};
+}  // namespace pc_sampling
+}  // namespace rocprofiler
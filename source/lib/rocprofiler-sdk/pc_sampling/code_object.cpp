@@ -27,6 +27,7 @@
 #    include "lib/common/container/operators.hpp"
 #    include "lib/common/logging.hpp"
 #    include "lib/rocprofiler-sdk/code_object/code_object.hpp"
+#    include "lib/rocprofiler-sdk/pc_sampling/aggregation.hpp"
 #    include "lib/rocprofiler-sdk/pc_sampling/service.hpp"
 
 #    include <rocprofiler-sdk/fwd.h>
@@ -92,6 +93,17 @@ flush_buffers_generate_marker_record(rocprofiler_callback_phase_t
 
     auto* buff = rocprofiler::buffer::get_buffer(agent_buffer_id);
 
+    // The samples flushed above are attributed to the code objects loaded before this event.
+    if(auto* aggregator = agent_session->aggregator.get())
+    {
+        const auto& rocp_data = code_object.rocp_data;
+        if(phase == ROCPROFILER_CALLBACK_PHASE_LOAD)
+            aggregator->load_code_object(
+                rocp_data.code_object_id, rocp_data.load_base, rocp_data.load_size);
+        else
+            aggregator->unload_code_object(rocp_data.code_object_id);
+    }
+
     // create code object load/unload marker record and emplace it into the SDK's PC SAMPLING
     // buffer.
     if(phase == ROCPROFILER_CALLBACK_PHASE_LOAD)
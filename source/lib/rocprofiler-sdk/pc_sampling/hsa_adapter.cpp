@@ -328,6 +328,12 @@ pc_sampling_service_finish_configuration(context::pc_sampling_service* service)
         {
             std::runtime_error("PCS parser does not accept buffer");
         }
+
+        if(agent_session->aggregator)
+        {
+            agent_session->parser->register_aggregator_for_agent(agent_session->agent->id,
+                                                                 agent_session->aggregator.get());
+        }
     }
 
     // Register callbacks for the HSA's queue interceptor.
@@ -375,6 +381,10 @@ flush_internal_agent_buffers(const PCSAgentSession* agent_session)
             std::runtime_error("Fail to flush ROCr's buffer explicitly");
         }
     });
+
+    // All samples delivered prior to the flush are counted, so emit the counts.
+    if(agent_session->aggregator) agent_session->aggregator->flush();
+
     return ROCPROFILER_STATUS_SUCCESS;
 }
 }  // namespace hsa
@@ -91,6 +91,127 @@ struct std::hash<Parser::DispatchPkt>
 
 namespace Parser
 {
+/**
+ * Fixed-capacity open-addressing (linear probing) table which maps the dispatch seen by the trap
+ * handler, i.e. the (doorbell, wrapped dispatch index) correlation id and the device, to the
+ * correlation_id of the dispatch. Lookups never throw nor allocate: find() returns nullptr
+ * when the dispatch is unknown. The capacity is a power of two which is only increased by
+ * insert(), i.e. when a dispatch is registered, and never while the samples are parsed.
+ */
+class CorrelationTable
+{
+public:
+    static constexpr size_t initial_capacity = 1024;
+
+    CorrelationTable() { slots.resize(initial_capacity, empty_slot()); }
+
+    const rocprofiler_correlation_id_t* find(const DispatchPkt& key) const
+    {
+        if(key.correlation_id_in.raw == empty_key) return nullptr;
+
+        for(size_t i = home(key);; i = (i + 1) & mask())
+        {
+            const auto& slot = slots[i];
+            if(slot.key == key) return &slot.value;
+            if(slot.key.correlation_id_in.raw == empty_key) return nullptr;
+        }
+    }
+
+    //! Inserts or overwrites the correlation_id of the dispatch
+    void insert(const DispatchPkt& key, rocprofiler_correlation_id_t value)
+    {
+        if(key.correlation_id_in.raw == empty_key) return;
+
+        // keep the load factor at most 1/2 so that the probe sequences remain short
+        if(2 * (count + 1) > slots.size()) rehash(2 * slots.size());
+
+        for(size_t i = home(key);; i = (i + 1) & mask())
+        {
+            auto& slot = slots[i];
+            if(slot.key == key)
+            {
+                slot.value = value;
+                return;
+            }
+            if(slot.key.correlation_id_in.raw == empty_key)
+            {
+                slot = {key, value};
+                count++;
+                return;
+            }
+        }
+    }
+
+    //! Removes the dispatch. The entries displaced by the dispatch are shifted back (no tombstones)
+    void erase(const DispatchPkt& key)
+    {
+        if(key.correlation_id_in.raw == empty_key) return;
+
+        size_t i = home(key);
+        for(;; i = (i + 1) & mask())
+        {
+            if(slots[i].key.correlation_id_in.raw == empty_key) return;
+            if(slots[i].key == key) break;
+        }
+
+        for(size_t j = (i + 1) & mask();; j = (j + 1) & mask())
+        {
+            if(slots[j].key.correlation_id_in.raw == empty_key) break;
+
+            // the entry in j may move to the hole in i if its home slot is not in (i, j]
+            size_t k = home(slots[j].key);
+            if(((j - k) & mask()) >= ((j - i) & mask()))
+            {
+                slots[i] = slots[j];
+                i        = j;
+            }
+        }
+
+        slots[i] = empty_slot();
+        count--;
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+
+private:
+    struct slot_t
+    {
+        DispatchPkt                  key;
+        rocprofiler_correlation_id_t value;
+    };
+
+    //! The reserved bits of the trap correlation id are never all set
+    static constexpr uint64_t empty_key = ~0ul;
+
+    static slot_t empty_slot()
+    {
+        return {DispatchPkt{trap_correlation_id_t{.raw = empty_key}, device_handle{.handle = 0}},
+                rocprofiler_correlation_id_t{}};
+    }
+
+    size_t mask() const { return slots.size() - 1; }
+
+    size_t home(const DispatchPkt& key) const
+    {
+        uint64_t hash = (key.correlation_id_in.raw ^ (key.dev.handle * 0x9e3779b97f4a7c15ul)) *
+                        0xff51afd7ed558ccdul;
+        return (hash ^ (hash >> 32)) & mask();
+    }
+
+    void rehash(size_t new_capacity)
+    {
+        auto old_slots = std::vector<slot_t>(new_capacity, empty_slot());
+        std::swap(slots, old_slots);
+        count = 0;
+        for(const auto& slot : old_slots)
+            if(slot.key.correlation_id_in.raw != empty_key) insert(slot.key, slot.value);
+    }
+
+    std::vector<slot_t> slots{};
+    size_t              count = 0;
+};
+
 /**
  * Coordinates DispatchMap and DoorBellMap to reconstruct the original correlation_id
  * from the correlation_id seen by the trap handler.
@@ -107,7 +228,7 @@ public:
     bool checkDispatch(const dispatch_pkt_id_t& pkt) const
     {
         auto trap = trap_correlation_id(pkt.doorbell_id, pkt.write_index, pkt.queue_size);
-        return dispatch_to_correlation.find({trap, pkt.device}) != dispatch_to_correlation.end();
+        return dispatch_to_correlation.find({trap, pkt.device}) != nullptr;
     }
 
     /**
@@ -117,7 +238,7 @@ public:
     {
         cache_dev_id = ~0ul;
         auto trap_id = trap_correlation_id(pkt.doorbell_id, pkt.write_index, pkt.queue_size);
-        dispatch_to_correlation[{trap_id, pkt.device}] = pkt.correlation_id;
+        dispatch_to_correlation.insert({trap_id, pkt.device}, pkt.correlation_id);
     }
 
     /**
@@ -132,18 +253,23 @@ public:
 
     /**
      * Given a device dev, doorbell and and wrapped dispatch_id,
-     * @returns the correlation_id set by dispatch_pkt_id_t
+     * @returns the correlation_id set by dispatch_pkt_id_t or nullptr if the dispatch is unknown
      */
-    rocprofiler_correlation_id_t get(device_handle dev, trap_correlation_id_t correlation_in)
+    const rocprofiler_correlation_id_t* find(device_handle         dev,
+                                             trap_correlation_id_t correlation_in)
     {
 #ifndef _PARSER_CORRELATION_DISABLE_CACHE
         if(dev.handle == cache_dev_id && correlation_in == cache_correlation_id_in)
             return cache_correlation_id_out;
 #endif
-        cache_correlation_id_out = dispatch_to_correlation.at({correlation_in, dev});
-        cache_dev_id             = dev.handle;
-        cache_correlation_id_in  = correlation_in;
-        return cache_correlation_id_out;
+        const auto* correlation_id = dispatch_to_correlation.find({correlation_in, dev});
+        if(correlation_id)
+        {
+            cache_correlation_id_out = correlation_id;
+            cache_dev_id             = dev.handle;
+            cache_correlation_id_in  = correlation_in;
+        }
+        return correlation_id;
     }
 
     /**
@@ -167,14 +293,13 @@ public:
     }
 
 private:
-    std::unordered_map<DispatchPkt, rocprofiler_correlation_id_t> dispatch_to_correlation{};
-
-    // Making get() const and these cache variables mutable causes performance to be unstable
-    trap_correlation_id_t        cache_correlation_id_in{.raw = ~0ul};  // Invalid value in cache
-    rocprofiler_correlation_id_t cache_correlation_id_out{
-        .internal = ~0ul,
-        .external = rocprofiler_user_data_t{.value = ~0ul}};
-    uint64_t cache_dev_id = ~0ul;  // Invalid device Id in cache
+    CorrelationTable dispatch_to_correlation{};
+
+    // Making find() const and these cache variables mutable causes performance to be unstable.
+    // The cached entry points into the table so it is invalidated by newDispatch() and forget()
+    trap_correlation_id_t               cache_correlation_id_in{.raw = ~0ul};  // Invalid value
+    const rocprofiler_correlation_id_t* cache_correlation_id_out = nullptr;
+    uint64_t                            cache_dev_id = ~0ul;  // Invalid device Id in cache
 };
 }  // namespace Parser
 
@@ -186,25 +311,25 @@ add_upcoming_samples(const device_handle               device,
                      Parser::CorrelationMap*           corr_map,
                      rocprofiler_pc_sampling_record_t* samples)
 {
-    pcsample_status_t status = PCSAMPLE_STATUS_SUCCESS;
+    // samples of an unknown dispatch, e.g. of a dispatch which was already forgotten, are given
+    // the null correlation_id. The misses are counted instead of branching out of the loop
+    const auto unknown = rocprofiler_correlation_id_t{
+        .internal = ROCPROFILER_CORRELATION_ID_INTERNAL_NONE,
+        .external = rocprofiler_user_data_t{.value = ROCPROFILER_CORRELATION_ID_INTERNAL_NONE}};
+
+    uint64_t num_misses = 0;
     for(uint64_t p = 0; p < available_samples; p++)
     {
         const auto* snap = reinterpret_cast<const perf_sample_snapshot_v1*>(buffer + p);
-        samples[p]       = copySample<bHostTrap, GFXIP>((const void*) (buffer + p));
-        samples[p].size  = sizeof(rocprofiler_pc_sampling_record_t);
-        try
-        {
-            Parser::trap_correlation_id_t trap{.raw = snap->correlation_id};
-            samples[p].correlation_id = corr_map->get(device, trap);
-        } catch(std::exception& e)
-        {
-            samples[p].correlation_id = {.internal = ROCPROFILER_CORRELATION_ID_INTERNAL_NONE,
-                                         .external = rocprofiler_user_data_t{
-                                             .value = ROCPROFILER_CORRELATION_ID_INTERNAL_NONE}};
-            status                    = PCSAMPLE_STATUS_PARSER_ERROR;
-        }
+        const auto* correlation_id =
+            corr_map->find(device, Parser::trap_correlation_id_t{.raw = snap->correlation_id});
+
+        samples[p]                = copySample<bHostTrap, GFXIP>((const void*) (buffer + p));
+        samples[p].size           = sizeof(rocprofiler_pc_sampling_record_t);
+        samples[p].correlation_id = (correlation_id) ? *correlation_id : unknown;
+        num_misses += (correlation_id == nullptr);
     }
-    return status;
+    return (num_misses == 0) ? PCSAMPLE_STATUS_SUCCESS : PCSAMPLE_STATUS_PARSER_ERROR;
 }
 
 template <typename GFXIP>
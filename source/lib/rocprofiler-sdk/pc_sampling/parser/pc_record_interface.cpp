@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "lib/rocprofiler-sdk/pc_sampling/parser/pc_record_interface.hpp"
+#include "lib/rocprofiler-sdk/pc_sampling/aggregation.hpp"
 
 uint64_t
 PCSamplingParserContext::alloc(rocprofiler_pc_sampling_record_t** buffer, uint64_t size)
@@ -104,14 +105,22 @@ PCSamplingParserContext::generate_upcoming_pc_record(
     const rocprofiler_pc_sampling_record_t* samples,
     size_t                                  num_samples)
 {
+    auto aggr_itr = _agent_aggregators.find(rocprofiler_agent_id_t{agent_id_handle});
+    if(aggr_itr != _agent_aggregators.end())
+    {
+        aggr_itr->second->add(samples, num_samples);
+        aggr_itr->second->flush_if_due();
+        return;
+    }
+
     auto buff_id = _agent_buffers.at(rocprofiler_agent_id_t{agent_id_handle});
     rocprofiler::buffer::instance* buff = rocprofiler::buffer::get_buffer(buff_id);
 
     if(!buff)
         throw std::runtime_error(fmt::format("Buffer with id: {} does not exists", buff_id.handle));
 
-    for(size_t i = 0; i < num_samples; i++)
-        buff->emplace(ROCPROFILER_BUFFER_CATEGORY_PC_SAMPLING,
-                      ROCPROFILER_PC_SAMPLING_RECORD_SAMPLE,
-                      samples[i]);
+    buff->emplace_range(ROCPROFILER_BUFFER_CATEGORY_PC_SAMPLING,
+                        ROCPROFILER_PC_SAMPLING_RECORD_SAMPLE,
+                        samples,
+                        num_samples);
 }
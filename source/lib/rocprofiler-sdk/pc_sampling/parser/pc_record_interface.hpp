@@ -41,6 +41,15 @@
 #include <thread>
 #include <unordered_set>
 
+namespace rocprofiler
+{
+namespace pc_sampling
+{
+// forward declaration to avoid circular dependency
+class PCSAggregator;
+}  // namespace pc_sampling
+}  // namespace rocprofiler
+
 struct PCSamplingData
 {
     PCSamplingData(size_t size)
@@ -122,6 +131,18 @@ public:
         _agent_buffers.erase(agent_id);
     }
 
+    /**
+     * @brief Samples of the agent with @p agent_id are counted by the @p aggregator
+     * instead of being placed in the agent's buffer.
+     */
+    void register_aggregator_for_agent(rocprofiler_agent_id_t                   agent_id,
+                                       rocprofiler::pc_sampling::PCSAggregator* aggregator)
+    {
+        std::unique_lock<std::shared_mutex> lock(mut);
+
+        _agent_aggregators[agent_id] = aggregator;
+    }
+
 protected:
     /**
      * @brief Parses the given input data and generates pc sampling records.
@@ -183,4 +204,6 @@ protected:
 
 private:
     std::unordered_map<rocprofiler_agent_id_t, rocprofiler_buffer_id_t> _agent_buffers;
+    std::unordered_map<rocprofiler_agent_id_t, rocprofiler::pc_sampling::PCSAggregator*>
+        _agent_aggregators;
 };
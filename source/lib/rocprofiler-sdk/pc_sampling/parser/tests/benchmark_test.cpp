@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 #include <cstddef>
+#include <cstring>
+#include <random>
 
 #include "lib/rocprofiler-sdk/pc_sampling/parser/tests/mocks.hpp"
 
@@ -94,3 +96,113 @@ TEST(pcs_parser, benchmark_test)
     EXPECT_EQ(Benchmark(false), true);
     EXPECT_EQ(Benchmark(false), true);
 }
+
+/**
+ * Benchmarks the parser when a fraction (miss_rate) of the samples belong to a dispatch unknown to
+ * the parser, e.g. a dispatch which was already forgotten, and when the samples of the dispatches
+ * are interleaved, which defeats the single-entry cache of the correlation map.
+ */
+static bool
+BenchmarkMixed(bool bWarmup, float miss_rate, bool bInterleave)
+{
+    constexpr size_t SAMPLE_PER_DISPATCH = 8192;
+    constexpr size_t DISP_PER_QUEUE      = 12;
+    constexpr size_t NUM_QUEUES          = MockDoorBell::num_unique_bells;
+    constexpr size_t TOTAL_NUM_SAMPLES   = NUM_QUEUES * DISP_PER_QUEUE * SAMPLE_PER_DISPATCH;
+
+    std::shared_ptr<MockRuntimeBuffer> buffer = std::make_shared<MockRuntimeBuffer>();
+    std::vector<std::shared_ptr<MockDispatch>> active_dispatches;
+
+    for(size_t q = 0; q < NUM_QUEUES; q++)
+    {
+        std::shared_ptr<MockQueue> queue = std::make_shared<MockQueue>(DISP_PER_QUEUE * 2, buffer);
+        for(size_t d = 0; d < DISP_PER_QUEUE; d++)
+            active_dispatches.push_back(std::make_shared<MockDispatch>(queue));
+    }
+
+    buffer->genUpcomingSamples(TOTAL_NUM_SAMPLES);
+
+    // none of the mock doorbells uses this doorbell id. The pc of the samples of the unknown
+    // dispatch is set to a value which is not the unique_id of any dispatch
+    const auto unknown_id = Parser::CorrelationMap::trap_correlation_id(
+        MockDoorBell::num_unique_bells << 3, 0, DISP_PER_QUEUE * 2);
+    constexpr uint64_t unknown_pc = ~0ul;
+
+    std::mt19937                          rdgen(1);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    size_t                                num_misses = 0;
+
+    auto genSample = [&](const std::shared_ptr<MockDispatch>& dispatch) {
+        if(dist(rdgen) >= miss_rate) return MockWave(dispatch).genPCSample();
+
+        packet_union_t uni;
+        ::memset(&uni, 0, sizeof(uni));
+        uni.snap.pc             = unknown_pc;
+        uni.snap.correlation_id = unknown_id.raw;
+        buffer->submit(uni);
+        num_misses++;
+    };
+
+    if(bInterleave)
+    {
+        for(size_t i = 0; i < SAMPLE_PER_DISPATCH; i++)
+            for(auto& dispatch : active_dispatches)
+                genSample(dispatch);
+    }
+    else
+    {
+        for(auto& dispatch : active_dispatches)
+            for(size_t i = 0; i < SAMPLE_PER_DISPATCH; i++)
+                genSample(dispatch);
+    }
+
+    std::pair<rocprofiler_pc_sampling_record_t*, size_t> userdata;
+    userdata.first  = new rocprofiler_pc_sampling_record_t[TOTAL_NUM_SAMPLES];
+    userdata.second = TOTAL_NUM_SAMPLES;
+
+    auto t0     = std::chrono::system_clock::now();
+    auto status = parse_buffer(
+        (generic_sample_t*) buffer->packets.data(),
+        buffer->packets.size(),
+        GFXIP_MAJOR,
+        [](rocprofiler_pc_sampling_record_t** sample, uint64_t size, void* userdata_) {
+            auto* pair =
+                reinterpret_cast<std::pair<rocprofiler_pc_sampling_record_t*, size_t>*>(userdata_);
+            assert(TOTAL_NUM_SAMPLES == pair->second);
+            *sample = pair->first;
+            return size;
+        },
+        &userdata);
+    auto  t1             = std::chrono::system_clock::now();
+    float samples_per_us = float(TOTAL_NUM_SAMPLES) / (t1 - t0).count() * 1E3f;
+
+    // the samples of the unknown dispatch are reported as parser errors
+    auto expected = (num_misses > 0) ? PCSAMPLE_STATUS_PARSER_ERROR : PCSAMPLE_STATUS_SUCCESS;
+    bool bSuccess = (status == expected);
+
+    for(size_t i = 0; i < TOTAL_NUM_SAMPLES; i++)
+    {
+        const auto& sample = userdata.first[i];
+        uint64_t    expected_id =
+            (sample.pc == unknown_pc) ? ROCPROFILER_CORRELATION_ID_INTERNAL_NONE : sample.pc;
+        if(sample.correlation_id.internal != expected_id) bSuccess = false;
+    }
+
+    if(!bWarmup)
+    {
+        std::cout << "Benchmark (" << (bInterleave ? "interleaved" : "sequential") << ", "
+                  << int(miss_rate * 100 + 0.5f) << "% misses): Parsed "
+                  << int(samples_per_us * 1E3f + 0.5f) * 1E-3f << " Msample/s" << std::endl;
+    }
+
+    delete[] userdata.first;
+    return bSuccess;
+}
+
+TEST(pcs_parser, benchmark_mixed_test)
+{
+    EXPECT_EQ(BenchmarkMixed(true, 0.0f, false), true);
+    for(bool bInterleave : {false, true})
+        for(float miss_rate : {0.0f, 0.01f, 0.1f, 0.5f})
+            EXPECT_EQ(BenchmarkMixed(false, miss_rate, bInterleave), true);
+}
@@ -351,3 +351,47 @@ TEST(pcs_parser, multi_buffer)
     delete[] all_allocations[0].first;
     delete[] all_allocations[1].first;
 };
+
+/**
+ * Inserts and erases random dispatches in the correlation table, growing it past its initial
+ * capacity, and compares every lookup against a std::unordered_map.
+ */
+TEST(pcs_parser, correlation_table)
+{
+    constexpr size_t NUM_ACTIONS = 100000;
+    constexpr size_t NUM_KEYS    = 4 * Parser::CorrelationTable::initial_capacity;
+
+    Parser::CorrelationTable                          table;
+    std::unordered_map<Parser::DispatchPkt, uint64_t> reference;
+    std::vector<Parser::DispatchPkt>                  keys;
+
+    for(size_t i = 0; i < NUM_KEYS; i++)
+    {
+        auto trap = Parser::CorrelationMap::trap_correlation_id(rdgen() << 3, rdgen(), 1 << 16);
+        keys.push_back({trap, device_handle{.handle = rdgen() % 4}});
+    }
+
+    for(size_t i = 0; i < NUM_ACTIONS; i++)
+    {
+        const auto& key = keys[rdgen() % keys.size()];
+        if(rdgen() % 3 == 0)
+        {
+            table.erase(key);
+            reference.erase(key);
+        }
+        else
+        {
+            table.insert(key, {.internal = i, .external = rocprofiler_user_data_t{.value = i}});
+            reference[key] = i;
+        }
+    }
+
+    EXPECT_EQ(table.size(), reference.size());
+    for(const auto& key : keys)
+    {
+        const auto* corr = table.find(key);
+        auto        it   = reference.find(key);
+        EXPECT_EQ(corr != nullptr, it != reference.end());
+        if(corr && it != reference.end()) EXPECT_EQ(corr->internal, it->second);
+    }
+}
@@ -26,6 +26,7 @@
 #if ROCPROFILER_SDK_HSA_PC_SAMPLING > 0
 
 #    include "lib/common/logging.hpp"
+#    include "lib/rocprofiler-sdk/pc_sampling/aggregation.hpp"
 #    include "lib/rocprofiler-sdk/pc_sampling/hsa_adapter.hpp"
 #    include "lib/rocprofiler-sdk/pc_sampling/ioctl/ioctl_adapter.hpp"
 #    include "lib/rocprofiler-sdk/pc_sampling/utils.hpp"
@@ -234,6 +235,34 @@ configure_pc_sampling_service(context::context*                ctx,
     return ROCPROFILER_STATUS_SUCCESS;
 }
 
+rocprofiler_status_t
+configure_pc_sampling_aggregation(context::context*          ctx,
+                                  const rocprofiler_agent_t* agent,
+                                  uint64_t                   flush_interval)
+{
+    // The aggregation applies to the samples of an already configured service
+    if(!ctx->pc_sampler || ctx->pc_sampler->agent_sessions.count(agent->id) == 0)
+        return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    auto* session = ctx->pc_sampler->agent_sessions.at(agent->id).get();
+    if(session->aggregator) return ROCPROFILER_STATUS_ERROR_SERVICE_ALREADY_CONFIGURED;
+
+    // The records are placed in the buffer of the service
+    auto emit_fn = [buffer_id = session->buffer_id](const PCSAggregator::record_t* records,
+                                                    size_t                         num_records) {
+        auto* buff = rocprofiler::buffer::get_buffer(buffer_id);
+        if(!buff) return;
+
+        buff->emplace_range(ROCPROFILER_BUFFER_CATEGORY_PC_SAMPLING,
+                            ROCPROFILER_PC_SAMPLING_RECORD_AGGREGATE,
+                            records,
+                            num_records);
+    };
+    session->aggregator = std::make_unique<PCSAggregator>(flush_interval, std::move(emit_fn));
+
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
 bool
 is_pc_sample_service_configured(rocprofiler_agent_id_t agent_id)
 {
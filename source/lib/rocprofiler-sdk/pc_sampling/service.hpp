@@ -62,6 +62,11 @@ configure_pc_sampling_service(context::context*                ctx,
                               uint64_t                         interval,
                               rocprofiler_buffer_id_t          buffer_id);
 
+rocprofiler_status_t
+configure_pc_sampling_aggregation(context::context*          ctx,
+                                  const rocprofiler_agent_t* agent,
+                                  uint64_t                   flush_interval);
+
 bool
 is_pc_sample_service_configured(rocprofiler_agent_id_t agent_id);
 
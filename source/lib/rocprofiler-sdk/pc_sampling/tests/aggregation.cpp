@@ -0,0 +1,183 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/pc_sampling/aggregation.hpp"
+
+#include <rocprofiler-sdk/pc_sampling.h>
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+using aggregator_t = rocprofiler::pc_sampling::PCSAggregator;
+using record_t     = rocprofiler_pc_sampling_aggregate_record_t;
+using hist_key_t   = std::tuple<uint64_t, uint64_t, uint64_t, uint32_t>;
+
+rocprofiler_pc_sampling_record_t
+make_sample(uint64_t pc, uint64_t exec_mask, uint32_t reason_not_issued = 0)
+{
+    auto _v                       = rocprofiler_pc_sampling_record_t{};
+    _v.size                       = sizeof(rocprofiler_pc_sampling_record_t);
+    _v.flags.valid                = 1;
+    _v.flags.type                 = 2;
+    _v.flags.has_stall_reason     = 1;
+    _v.pc                         = pc;
+    _v.exec_mask                  = exec_mask;
+    _v.snapshot.reason_not_issued = reason_not_issued;
+    _v.correlation_id.internal    = pc;  // dropped by the aggregation
+    return _v;
+}
+
+// accumulates the emitted records per key
+struct histogram
+{
+    void operator()(const record_t* records, size_t num_records)
+    {
+        ++num_emits;
+        for(size_t i = 0; i < num_records; ++i)
+        {
+            const auto& _rec = records[i];
+            EXPECT_EQ(_rec.size, sizeof(record_t));
+            EXPECT_GT(_rec.count, 0);
+            counts[hist_key_t{_rec.code_object_id,
+                              _rec.code_object_offset,
+                              _rec.exec_mask,
+                              _rec.snapshot.reason_not_issued}] += _rec.count;
+            ++num_records_emitted;
+        }
+    }
+
+    std::map<hist_key_t, uint64_t> counts              = {};
+    size_t                         num_emits           = 0;
+    size_t                         num_records_emitted = 0;
+};
+}  // namespace
+
+TEST(pc_sampling, aggregation)
+{
+    auto _hist = histogram{};
+    auto _aggr = aggregator_t{0, [&_hist](const record_t* recs, size_t n) { _hist(recs, n); }};
+
+    _aggr.load_code_object(1, 0x1000, 0x1000);
+    _aggr.load_code_object(2, 0x4000, 0x100);
+
+    auto _samples = std::vector<rocprofiler_pc_sampling_record_t>{};
+    for(size_t i = 0; i < 3; ++i)
+        _samples.emplace_back(make_sample(0x1010, 0xff));
+    _samples.emplace_back(make_sample(0x1010, 0xf));
+    _samples.emplace_back(make_sample(0x1010, 0xff, 3));
+    _samples.emplace_back(make_sample(0x4020, 0xff));
+    // outside of any code object
+    _samples.emplace_back(make_sample(0x4100, 0xff));
+    _samples.emplace_back(make_sample(0x10, 0xff));
+
+    _aggr.add(_samples.data(), _samples.size());
+    EXPECT_EQ(_aggr.size(), 6);
+
+    // a zero flush interval never flushes periodically
+    _aggr.flush_if_due();
+    EXPECT_EQ(_hist.num_emits, 0);
+
+    _aggr.flush();
+    EXPECT_EQ(_hist.num_emits, 1);
+    EXPECT_EQ(_hist.num_records_emitted, 6);
+    EXPECT_EQ((_hist.counts[hist_key_t{1, 0x10, 0xff, 0}]), 3);
+    EXPECT_EQ((_hist.counts[hist_key_t{1, 0x10, 0xf, 0}]), 1);
+    EXPECT_EQ((_hist.counts[hist_key_t{1, 0x10, 0xff, 3}]), 1);
+    EXPECT_EQ((_hist.counts[hist_key_t{2, 0x20, 0xff, 0}]), 1);
+    EXPECT_EQ((_hist.counts[hist_key_t{0, 0x4100, 0xff, 0}]), 1);
+    EXPECT_EQ((_hist.counts[hist_key_t{0, 0x10, 0xff, 0}]), 1);
+
+    // only the deltas are emitted and the keys not sampled since the previous flush are evicted
+    _aggr.add(_samples.data(), 1);
+    _aggr.flush();
+    EXPECT_EQ(_hist.num_emits, 2);
+    EXPECT_EQ(_hist.num_records_emitted, 7);
+    EXPECT_EQ((_hist.counts[hist_key_t{1, 0x10, 0xff, 0}]), 4);
+    EXPECT_EQ(_aggr.size(), 1);
+
+    // nothing changed
+    _aggr.flush();
+    EXPECT_EQ(_hist.num_emits, 2);
+    EXPECT_EQ(_aggr.size(), 0);
+
+    // samples of an unloaded code object are not attributed to it
+    _aggr.unload_code_object(1);
+    _aggr.add(_samples.data(), 1);
+    _aggr.flush();
+    EXPECT_EQ((_hist.counts[hist_key_t{0, 0x1010, 0xff, 0}]), 1);
+}
+
+TEST(pc_sampling, aggregation_concurrent)
+{
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_batches = 200;
+    constexpr size_t batch_size  = 256;
+    constexpr size_t num_pcs     = 64;
+
+    auto _hist     = histogram{};
+    auto _hist_mut = std::mutex{};
+    // flush periodically while the samples are being added
+    auto _aggr = aggregator_t{1, [&](const record_t* recs, size_t n) {
+                                  std::unique_lock<std::mutex> lock(_hist_mut);
+                                  _hist(recs, n);
+                              }};
+    _aggr.load_code_object(7, 0x10000, num_pcs * 4);
+
+    auto _samples = std::vector<rocprofiler_pc_sampling_record_t>{};
+    for(size_t i = 0; i < batch_size; ++i)
+        _samples.emplace_back(make_sample(0x10000 + (i % num_pcs) * 4, 0xff));
+
+    auto _threads = std::vector<std::thread>{};
+    for(size_t i = 0; i < num_threads; ++i)
+    {
+        _threads.emplace_back([&]() {
+            for(size_t j = 0; j < num_batches; ++j)
+            {
+                _aggr.add(_samples.data(), _samples.size());
+                _aggr.flush_if_due();
+            }
+        });
+    }
+    for(auto& itr : _threads)
+        itr.join();
+
+    _aggr.flush();
+
+    uint64_t _total = 0;
+    for(const auto& [key, count] : _hist.counts)
+    {
+        EXPECT_EQ(std::get<0>(key), 7);
+        EXPECT_LT(std::get<1>(key), num_pcs * 4);
+        EXPECT_EQ(count, num_threads * num_batches * batch_size / num_pcs);
+        _total += count;
+    }
+    EXPECT_EQ(_hist.counts.size(), num_pcs);
+    EXPECT_EQ(_total, num_threads * num_batches * batch_size);
+}
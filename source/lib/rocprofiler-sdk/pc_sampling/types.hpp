@@ -2,6 +2,7 @@
 
 #include "lib/rocprofiler-sdk/hsa/hsa.hpp"
 #include "lib/rocprofiler-sdk/hsa/queue.hpp"
+#include "lib/rocprofiler-sdk/pc_sampling/aggregation.hpp"
 #include "lib/rocprofiler-sdk/pc_sampling/cid_manager.hpp"
 #include "lib/rocprofiler-sdk/pc_sampling/defines.hpp"
 #include "lib/rocprofiler-sdk/pc_sampling/parser/pc_record_interface.hpp"
@@ -42,6 +43,8 @@ struct PCSAgentSession
     std::unique_ptr<PCSamplingParserContext> parser = {};
     // Manager responsible for retiring CIDs
     std::unique_ptr<PCSCIDManager> cid_manager = {};
+    // Histogram of the samples, if aggregation is configured
+    std::unique_ptr<PCSAggregator> aggregator = {};
 };
 
 // TODO static assertions
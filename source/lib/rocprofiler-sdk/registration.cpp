@@ -599,6 +599,8 @@ initialize()
         internal_threading::initialize();
         // initialization is no longer available
         set_init_status(1);
+        // tracing services may have been configured on contexts started during initialization
+        context::update_active_tracing_snapshot();
     });
 }
 
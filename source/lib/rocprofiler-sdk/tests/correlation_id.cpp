@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include "lib/rocprofiler-sdk/context/correlation_id.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace context = ::rocprofiler::context;
+
+using correlation_service = context::correlation_tracing_service;
+}  // namespace
+
+TEST(correlation_id, reuse)
+{
+    auto* _first = correlation_service::construct(1);
+    auto  _id    = _first->internal;
+    context::pop_latest_correlation_id(_first);
+    _first->sub_ref_count();
+
+    // retired correlation id should be handed back out with a new internal id
+    auto* _second = correlation_service::construct(1);
+    EXPECT_EQ(_first, _second);
+    EXPECT_GT(_second->internal, _id);
+    EXPECT_EQ(_second->get_ref_count(), 1);
+    EXPECT_EQ(_second->get_kern_count(), 0);
+    context::pop_latest_correlation_id(_second);
+    _second->sub_ref_count();
+}
+
+TEST(correlation_id, release_cross_thread)
+{
+    auto* _corr_id = correlation_service::construct(2);
+    auto  _id      = _corr_id->internal;
+    context::pop_latest_correlation_id(_corr_id);
+    _corr_id->sub_ref_count();
+
+    // the final reference is released by another thread (e.g. kernel completion) so the
+    // correlation id must be returned to the pool of this thread, not the pool of the other
+    // thread
+    std::thread{[_corr_id]() { _corr_id->sub_ref_count(); }}.join();
+
+    auto _reclaimed = false;
+    auto _batch     = std::vector<context::correlation_id*>{};
+    for(size_t i = 0; i < 1024 && !_reclaimed; ++i)
+    {
+        auto* _itr = correlation_service::construct(1);
+        context::pop_latest_correlation_id(_itr);
+        if(_itr == _corr_id)
+        {
+            EXPECT_GT(_itr->internal, _id);
+            _reclaimed = true;
+        }
+        _batch.emplace_back(_itr);
+    }
+
+    EXPECT_TRUE(_reclaimed);
+
+    for(auto* itr : _batch)
+        itr->sub_ref_count();
+}
+
+TEST(correlation_id, thread_local_teardown)
+{
+    // constructs a correlation id (e.g. traced API call) from a thread-local destructor
+    struct construct_on_exit
+    {
+        ~construct_on_exit()
+        {
+            auto* _corr_id = correlation_service::construct(1);
+            if(!_corr_id) return;
+
+            internal->store(_corr_id->internal);
+            context::pop_latest_correlation_id(_corr_id);
+            _corr_id->sub_ref_count();
+        }
+
+        std::atomic<uint64_t>* internal = nullptr;
+    };
+
+    auto _internal = std::atomic<uint64_t>{0};
+    auto _id       = uint64_t{0};
+
+    std::thread{[&_internal, &_id]() {
+        // constructed before the correlation id pool of this thread so it is destroyed after it
+        static thread_local auto _on_exit = construct_on_exit{&_internal};
+
+        auto* _corr_id = correlation_service::construct(1);
+        _id            = _corr_id->internal;
+        context::pop_latest_correlation_id(_corr_id);
+        _corr_id->sub_ref_count();
+    }}.join();
+
+    EXPECT_GT(_internal.load(), _id);
+}
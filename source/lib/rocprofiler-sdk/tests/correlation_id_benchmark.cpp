@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// CPU-only benchmark of the correlation id pools. Emulates the lifetime of 100M correlation ids
+// (reduced via ROCPROFILER_TEST_CORRELATION_ID_CALLS) and verifies that retired correlation ids
+// are recycled, i.e. the resident set size does not grow with the number of calls.
+
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include "lib/common/environment.hpp"
+#include "lib/common/units.hpp"
+#include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/context/correlation_id.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace context = ::rocprofiler::context;
+namespace common  = ::rocprofiler::common;
+
+using correlation_service = context::correlation_tracing_service;
+
+// resident set size in bytes
+size_t
+get_rss()
+{
+    auto   _ifs   = std::ifstream{"/proc/self/statm"};
+    size_t _size  = 0;
+    size_t _pages = 0;
+    _ifs >> _size >> _pages;
+    return _pages * common::units::get_page_size();
+}
+
+// number of calls can be reduced for debug/sanitizer builds
+size_t
+get_num_calls(size_t _default)
+{
+    return common::get_env("ROCPROFILER_TEST_CORRELATION_ID_CALLS", _default);
+}
+
+// emulates the lifetime of a correlation id in a traced API call
+void
+traced_call()
+{
+    auto* _corr_id = correlation_service::construct(2);
+    _corr_id->sub_ref_count();
+    context::pop_latest_correlation_id(_corr_id);
+    _corr_id->sub_ref_count();
+}
+}  // namespace
+
+TEST(correlation_id, stress)
+{
+    constexpr size_t max_rss_growth = 16 * common::units::MB;
+
+    const auto num_calls = get_num_calls(100000000);
+
+    // warm-up so that the thread-local pool is populated
+    for(size_t i = 0; i < 1000000; ++i)
+        traced_call();
+
+    auto _rss_beg = get_rss();
+    for(size_t i = 0; i < num_calls; ++i)
+        traced_call();
+    auto _rss_end = get_rss();
+
+    EXPECT_LT(_rss_end, _rss_beg + max_rss_growth);
+}
+
+TEST(correlation_id, stress_cross_thread)
+{
+    // correlation ids retired on a different thread (e.g. kernel completion) must make it
+    // back to the pool of the thread which constructed them
+    constexpr size_t max_rss_growth = 16 * common::units::MB;
+    constexpr size_t batch_size     = 8192;
+
+    const auto num_calls = get_num_calls(100000000) / 10;
+
+    auto _batch   = std::vector<context::correlation_id*>{};
+    auto _execute = [&_batch]() {
+        for(size_t i = 0; i < batch_size; ++i)
+        {
+            auto* _corr_id = correlation_service::construct(2);
+            context::pop_latest_correlation_id(_corr_id);
+            _corr_id->sub_ref_count();
+            _batch.emplace_back(_corr_id);
+        }
+
+        // the final reference is released by another thread
+        std::thread{[](auto _data) {
+                        for(auto* itr : _data)
+                            itr->sub_ref_count();
+                    },
+                    std::move(_batch)}
+            .join();
+        _batch.clear();
+    };
+
+    // warm-up
+    for(size_t i = 0; i < 16; ++i)
+        _execute();
+
+    auto _rss_beg = get_rss();
+    for(size_t i = 0; i < num_calls; i += batch_size)
+        _execute();
+    auto _rss_end = get_rss();
+
+    EXPECT_LT(_rss_end, _rss_beg + max_rss_growth);
+}
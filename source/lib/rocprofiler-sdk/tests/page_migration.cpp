@@ -22,6 +22,7 @@
 
 #include "lib/common/defines.hpp"
 #include "lib/rocprofiler-sdk/details/kfd_ioctl.h"
+#include "lib/rocprofiler-sdk/page_migration/parser.hpp"
 #include "lib/rocprofiler-sdk/page_migration/utils.hpp"
 
 #include <rocprofiler-sdk/fwd.h>
@@ -33,10 +34,6 @@
 #include <sstream>
 #include <string_view>
 
-#define ROCPROFILER_LIB_ROCPROFILER_SDK_PAGE_MIGRATION_PAGE_MIGRATION_CPP_IMPL 1
-#include "lib/rocprofiler-sdk/page_migration/page_migration.def.cpp"
-#undef ROCPROFILER_LIB_ROCPROFILER_SDK_PAGE_MIGRATION_PAGE_MIGRATION_CPP_IMPL
-
 #define ASSERT_SAME(A, B) static_assert(static_cast<size_t>(A) == static_cast<size_t>(B))
 
 namespace
@@ -174,3 +171,62 @@ TEST(page_migtation, rocprof_kfd_map)
 
     // clang-format on
 }
+
+TEST(page_migration, parse_kfd_events)
+{
+    using namespace ::rocprofiler::page_migration;
+
+    auto rec = page_migration_record_t{};
+
+    EXPECT_EQ(parse_kfd_event("5 1000 -42 @7f00(10) 0->1 0:1 1", rec),
+              ROCPROFILER_UVM_EVENT_MIGRATE_START);
+    EXPECT_EQ(rec.operation, ROCPROFILER_PAGE_MIGRATION_PAGE_MIGRATE);
+    EXPECT_EQ(rec.start_timestamp, 1000);
+    EXPECT_EQ(rec.pid, 42);
+    EXPECT_EQ(rec.page_migrate.start_addr, page_to_bytes(0x7f00));
+    EXPECT_EQ(rec.page_migrate.end_addr, page_to_bytes(0x7f10) - 1);
+    EXPECT_EQ(rec.page_migrate.from_node, 0);
+    EXPECT_EQ(rec.page_migrate.to_node, 1);
+    EXPECT_EQ(rec.page_migrate.prefetch_node, 0);
+    EXPECT_EQ(rec.page_migrate.preferred_node, 1);
+    EXPECT_EQ(rec.page_migrate.trigger, ROCPROFILER_PAGE_MIGRATION_TRIGGER_PAGEFAULT_GPU);
+
+    EXPECT_EQ(parse_kfd_event("6 2000 -42 @7f00(10) 0->1 1", rec),
+              ROCPROFILER_UVM_EVENT_MIGRATE_END);
+    EXPECT_EQ(rec.end_timestamp, 2000);
+    EXPECT_EQ(rec.page_migrate.end_addr, page_to_bytes(0x7f10) - 1);
+
+    EXPECT_EQ(parse_kfd_event("7 3000 -42 @abc(2) R", rec),
+              ROCPROFILER_UVM_EVENT_PAGE_FAULT_START);
+    EXPECT_EQ(rec.operation, ROCPROFILER_PAGE_MIGRATION_PAGE_FAULT);
+    EXPECT_EQ(rec.page_fault.address, page_to_bytes(0xabc));
+    EXPECT_EQ(rec.page_fault.node_id, 2);
+    EXPECT_EQ(rec.page_fault.read_fault, 1);
+
+    EXPECT_EQ(parse_kfd_event("8 4000 -42 @abc(2) M", rec), ROCPROFILER_UVM_EVENT_PAGE_FAULT_END);
+    EXPECT_EQ(rec.end_timestamp, 4000);
+    EXPECT_EQ(rec.page_fault.migrated, 1);
+
+    EXPECT_EQ(parse_kfd_event("9 5000 -42 3 2", rec), ROCPROFILER_UVM_EVENT_QUEUE_EVICTION);
+    EXPECT_EQ(rec.operation, ROCPROFILER_PAGE_MIGRATION_QUEUE_SUSPEND);
+    EXPECT_EQ(rec.queue_suspend.node_id, 3);
+    EXPECT_EQ(rec.queue_suspend.trigger, ROCPROFILER_PAGE_MIGRATION_QUEUE_SUSPEND_TRIGGER_TTM);
+
+    EXPECT_EQ(parse_kfd_event("a 6000 -42 3 R", rec), ROCPROFILER_UVM_EVENT_QUEUE_RESTORE);
+    EXPECT_EQ(rec.queue_suspend.rescheduled, 1);
+    EXPECT_EQ(parse_kfd_event("a 6000 -42 3", rec), ROCPROFILER_UVM_EVENT_QUEUE_RESTORE);
+    EXPECT_EQ(rec.queue_suspend.rescheduled, 0);
+
+    EXPECT_EQ(parse_kfd_event("b 7000 -42 @100(4) 1 0", rec), ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU);
+    EXPECT_EQ(rec.operation, ROCPROFILER_PAGE_MIGRATION_UNMAP_FROM_GPU);
+    EXPECT_EQ(rec.start_timestamp, rec.end_timestamp);
+    EXPECT_EQ(rec.unmap_from_gpu.start_addr, page_to_bytes(0x100));
+    EXPECT_EQ(rec.unmap_from_gpu.end_addr, page_to_bytes(0x104));
+    EXPECT_EQ(rec.unmap_from_gpu.node_id, 1);
+
+    // unknown and malformed events
+    EXPECT_EQ(parse_kfd_event("", rec), ROCPROFILER_UVM_EVENT_NONE);
+    EXPECT_EQ(parse_kfd_event("1 1000 -42", rec), ROCPROFILER_UVM_EVENT_NONE);
+    EXPECT_EQ(parse_kfd_event("7 1000 -42 abc(2) R", rec), ROCPROFILER_UVM_EVENT_NONE);
+    EXPECT_EQ(parse_kfd_event("5 1000 -42 @7f00(10) 0->1", rec), ROCPROFILER_UVM_EVENT_NONE);
+}
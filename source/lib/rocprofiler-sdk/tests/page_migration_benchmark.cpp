@@ -0,0 +1,274 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// CPU-only replay benchmark of the KFD SMI event parser. A recording of the text read from the
+// SMI file descriptors is replayed in read()-sized batches, so no GPU (or KFD) is required. The
+// previous std::sscanf-based parsing is measured as the reference and validates the records.
+
+#include "lib/rocprofiler-sdk/page_migration/parser.hpp"
+
+#include <rocprofiler-sdk/buffer_tracing.h>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+namespace page_migration = ::rocprofiler::page_migration;
+
+using page_migration_record_t = page_migration::page_migration_record_t;
+
+// size of the scratch buffer passed to read() by the page migration polling thread
+constexpr size_t batch_size     = 1024 * 128;
+constexpr size_t num_batches    = 64;
+constexpr size_t num_iterations = 5;
+
+// recorded events of a UVM-heavy workload (page faults resolved by migrations, evictions)
+constexpr auto recorded_events = std::string_view{
+    "7 1873624562130 -29471 @7f2a1c0d4(1) W\n"
+    "5 1873624563218 -29471 @7f2a1c0d4(200) 0->1 0:1 1\n"
+    "6 1873624571942 -29471 @7f2a1c0d4(200) 0->1 1\n"
+    "8 1873624572017 -29471 @7f2a1c0d4(1) M\n"
+    "7 1873624572390 -29471 @7f2a1c2d4(1) R\n"
+    "8 1873624572411 -29471 @7f2a1c2d4(1) U\n"
+    "b 1873624580125 -29471 @7f2a1c0d4(200) 1 0\n"
+    "9 1873624581006 -29471 1 2\n"
+    "a 1873624590437 -29471 1 R\n"
+    "5 1873624591002 -29471 @7f2a1c0d4(200) 1->0 0:0 0\n"
+    "6 1873624598755 -29471 @7f2a1c0d4(200) 1->0 0\n"};
+
+// the text returned by one read(): whole events up to the batch size
+std::string
+get_batch()
+{
+    auto _batch = std::string{};
+    _batch.reserve(batch_size);
+    while(_batch.size() + recorded_events.size() <= batch_size)
+        _batch.append(recorded_events);
+    return _batch;
+}
+
+// the previous parsing of an event: the KFD event id is read with std::sscanf, the event is
+// formatted for the log and std::sscanf is used again to read the whole event
+template <size_t OpIdx, typename... Args>
+bool
+sscanf_event(const char* event, Args*... args)
+{
+    static const auto _format =
+        fmt::format("%x {}", page_migration::uvm_event_info<OpIdx>::format_str);
+
+    uint32_t _kind = 0;
+    return std::sscanf(event, _format.c_str(), &_kind, args...) == sizeof...(Args) + 1;
+}
+
+page_migration::uvm_event_id_t
+sscanf_kfd_event(std::string_view event, page_migration_record_t& rec)
+{
+    using namespace page_migration;
+
+    uint32_t kfd_event_id = 0;
+    std::sscanf(event.data(), "%x ", &kfd_event_id);
+
+    auto _log = fmt::format("KFD event: [{}]", event);
+    (void) _log;
+
+    auto _uvm_id  = kfd_to_uvm_op(kfd_event_id);
+    rec           = page_migration_record_t{};
+    rec.size      = sizeof(page_migration_record_t);
+    rec.kind      = ROCPROFILER_BUFFER_TRACING_PAGE_MIGRATION;
+    rec.operation = to_rocprof_op(_uvm_id);
+
+    const auto* _str    = event.data();
+    uint32_t    trigger = 0;
+    uint32_t    node_id = 0;
+    uint64_t    address = 0;
+    char        flag    = '\0';
+
+    switch(static_cast<uint32_t>(_uvm_id))
+    {
+        case ROCPROFILER_UVM_EVENT_PAGE_FAULT_START:
+        {
+            sscanf_event<ROCPROFILER_UVM_EVENT_PAGE_FAULT_START>(
+                _str, &rec.start_timestamp, &rec.pid, &address, &node_id, &flag);
+            rec.page_fault.read_fault = (flag == 'R');
+            rec.page_fault.address    = page_to_bytes(address);
+            rec.page_fault.node_id    = node_id;
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_PAGE_FAULT_END:
+        {
+            sscanf_event<ROCPROFILER_UVM_EVENT_PAGE_FAULT_END>(
+                _str, &rec.end_timestamp, &rec.pid, &address, &node_id, &flag);
+            rec.page_fault.migrated = (flag == 'M');
+            rec.page_fault.address  = page_to_bytes(address);
+            rec.page_fault.node_id  = node_id;
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_MIGRATE_START:
+        case ROCPROFILER_UVM_EVENT_MIGRATE_END:
+        {
+            auto& e = rec.page_migrate;
+            if(_uvm_id == ROCPROFILER_UVM_EVENT_MIGRATE_START)
+                sscanf_event<ROCPROFILER_UVM_EVENT_MIGRATE_START>(_str,
+                                                                  &rec.start_timestamp,
+                                                                  &rec.pid,
+                                                                  &e.start_addr,
+                                                                  &e.end_addr,
+                                                                  &e.from_node,
+                                                                  &e.to_node,
+                                                                  &e.prefetch_node,
+                                                                  &e.preferred_node,
+                                                                  &trigger);
+            else
+                sscanf_event<ROCPROFILER_UVM_EVENT_MIGRATE_END>(_str,
+                                                                &rec.end_timestamp,
+                                                                &rec.pid,
+                                                                &e.start_addr,
+                                                                &e.end_addr,
+                                                                &e.from_node,
+                                                                &e.to_node,
+                                                                &trigger);
+            e.end_addr += e.start_addr;
+            e.trigger    = static_cast<rocprofiler_page_migration_trigger_t>(trigger);
+            e.start_addr = page_to_bytes(e.start_addr);
+            e.end_addr   = page_to_bytes(e.end_addr) - 1;
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_QUEUE_EVICTION:
+        {
+            sscanf_event<ROCPROFILER_UVM_EVENT_QUEUE_EVICTION>(
+                _str, &rec.start_timestamp, &rec.pid, &node_id, &trigger);
+            rec.queue_suspend.node_id = node_id;
+            rec.queue_suspend.trigger =
+                static_cast<rocprofiler_page_migration_queue_suspend_trigger_t>(trigger);
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_QUEUE_RESTORE:
+        {
+            sscanf_event<ROCPROFILER_UVM_EVENT_QUEUE_RESTORE>(
+                _str, &rec.end_timestamp, &rec.pid, &node_id);
+            rec.queue_suspend.node_id     = node_id;
+            rec.queue_suspend.rescheduled = (event.back() == 'R');
+            break;
+        }
+        case ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU:
+        {
+            using unmap_trigger_t = rocprofiler_page_migration_unmap_from_gpu_trigger_t;
+
+            auto& e = rec.unmap_from_gpu;
+            sscanf_event<ROCPROFILER_UVM_EVENT_UNMAP_FROM_GPU>(_str,
+                                                               &rec.start_timestamp,
+                                                               &rec.pid,
+                                                               &e.start_addr,
+                                                               &e.end_addr,
+                                                               &node_id,
+                                                               &trigger);
+            e.end_addr += e.start_addr;
+            e.node_id         = node_id;
+            e.trigger         = static_cast<unmap_trigger_t>(trigger);
+            e.start_addr      = page_to_bytes(e.start_addr);
+            e.end_addr        = page_to_bytes(e.end_addr);
+            rec.end_timestamp = rec.start_timestamp;
+            break;
+        }
+        default: return ROCPROFILER_UVM_EVENT_NONE;
+    }
+
+    return _uvm_id;
+}
+
+// returns the best parse throughput (in millions of events per second)
+template <typename FuncT>
+double
+measure(const std::string& batch, FuncT&& parse_event, std::vector<page_migration_record_t>& out)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    auto _best   = std::chrono::duration<double>::max();
+    auto _record = page_migration_record_t{};
+    auto _count  = size_t{0};
+
+    auto&& _handle_event = [&](std::string_view event) {
+        if(parse_event(event, _record) != page_migration::ROCPROFILER_UVM_EVENT_NONE)
+        {
+            if(out.size() < out.capacity()) out.emplace_back(_record);
+            ++_count;
+        }
+    };
+
+    for(size_t n = 0; n < num_iterations; ++n)
+    {
+        _count    = 0;
+        auto _beg = clock_type::now();
+        for(size_t i = 0; i < num_batches; ++i)
+        {
+            auto _events = std::string_view{batch};
+            KFD_EVENT_PARSE_EVENTS(_events, _handle_event);
+        }
+        auto _end = clock_type::now();
+
+        _best = std::min<std::chrono::duration<double>>(_best, _end - _beg);
+    }
+
+    return _count / _best.count() / 1.0e6;
+}
+}  // namespace
+
+TEST(page_migration, parse_benchmark)
+{
+    auto _batch = get_batch();
+
+    auto _sscanf_records = std::vector<page_migration_record_t>{};
+    auto _parser_records = std::vector<page_migration_record_t>{};
+    _sscanf_records.reserve(1024);
+    _parser_records.reserve(1024);
+
+    auto _sscanf_rate = measure(_batch, sscanf_kfd_event, _sscanf_records);
+    auto _parser_rate = measure(_batch, page_migration::parse_kfd_event, _parser_records);
+
+    std::cout << std::setw(12) << "parser" << std::setw(20) << "events/sec" << "\n";
+    std::cout << std::fixed << std::setprecision(3) << std::setw(12) << "sscanf" << std::setw(14)
+              << _sscanf_rate << " M/sec\n";
+    std::cout << std::setw(12) << "tokenizer" << std::setw(14) << _parser_rate << " M/sec"
+              << std::endl;
+
+    ASSERT_EQ(_sscanf_records.size(), _parser_records.size());
+    for(size_t i = 0; i < _parser_records.size(); ++i)
+    {
+        EXPECT_EQ(std::memcmp(&_sscanf_records.at(i),
+                              &_parser_records.at(i),
+                              sizeof(page_migration_record_t)),
+                  0)
+            << "record " << i << " differs";
+    }
+}
@@ -0,0 +1,301 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// CPU-only test of hsa::profiler_serializer. The HSA signal functions are replaced by mock
+// implementations so no GPU (or HSA runtime initialization) is required. A kernel of a queue is
+// running when the serializer releases the block signal of the queue.
+
+#include "lib/rocprofiler-sdk/hsa/agent_cache.hpp"
+#include "lib/rocprofiler-sdk/hsa/profile_serializer.hpp"
+#include "lib/rocprofiler-sdk/hsa/queue.hpp"
+
+#include <rocprofiler-sdk/agent.h>
+#include <rocprofiler-sdk/fwd.h>
+
+#include <gtest/gtest.h>
+
+#include <hsa/hsa.h>
+#include <hsa/hsa_api_trace.h>
+#include <hsa/hsa_ext_amd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+namespace hsa = ::rocprofiler::hsa;
+
+using serializer_t = hsa::profiler_serializer;
+
+constexpr size_t num_agents        = 4;
+constexpr size_t queues_per_agent  = 2;
+constexpr size_t kernels_per_queue = 8;
+
+uint64_t                                         next_signal   = 1;
+std::unordered_map<uint64_t, hsa_signal_value_t> signal_values = {};
+
+hsa_status_t
+mock_signal_create(hsa_signal_value_t value, uint32_t, const hsa_agent_t*, hsa_signal_t* signal)
+{
+    signal->handle                = next_signal++;
+    signal_values[signal->handle] = value;
+    return HSA_STATUS_SUCCESS;
+}
+
+hsa_status_t
+mock_amd_signal_create(hsa_signal_value_t value,
+                       uint32_t           num_consumers,
+                       const hsa_agent_t* consumers,
+                       uint64_t,
+                       hsa_signal_t* signal)
+{
+    return mock_signal_create(value, num_consumers, consumers, signal);
+}
+
+hsa_status_t
+mock_signal_destroy(hsa_signal_t signal)
+{
+    signal_values.erase(signal.handle);
+    return HSA_STATUS_SUCCESS;
+}
+
+void
+mock_signal_store(hsa_signal_t signal, hsa_signal_value_t value)
+{
+    signal_values[signal.handle] = value;
+}
+
+hsa_signal_value_t
+mock_signal_load(hsa_signal_t signal)
+{
+    return signal_values[signal.handle];
+}
+
+hsa_signal_value_t
+mock_signal_wait(hsa_signal_t signal,
+                 hsa_signal_condition_t,
+                 hsa_signal_value_t,
+                 uint64_t,
+                 hsa_wait_state_t)
+{
+    return mock_signal_load(signal);
+}
+
+hsa_status_t
+mock_iterate_memory_pools(hsa_agent_t, hsa_status_t (*)(hsa_amd_memory_pool_t, void*), void*)
+{
+    return HSA_STATUS_ERROR;
+}
+
+CoreApiTable
+get_mock_core_table()
+{
+    auto _v                          = CoreApiTable{};
+    _v.hsa_signal_create_fn          = mock_signal_create;
+    _v.hsa_signal_destroy_fn         = mock_signal_destroy;
+    _v.hsa_signal_store_relaxed_fn   = mock_signal_store;
+    _v.hsa_signal_store_screlease_fn = mock_signal_store;
+    _v.hsa_signal_load_scacquire_fn  = mock_signal_load;
+    _v.hsa_signal_wait_relaxed_fn    = mock_signal_wait;
+    return _v;
+}
+
+AmdExtTable
+get_mock_ext_table()
+{
+    auto _v                                  = AmdExtTable{};
+    _v.hsa_amd_signal_create_fn              = mock_amd_signal_create;
+    _v.hsa_amd_agent_iterate_memory_pools_fn = mock_iterate_memory_pools;
+    return _v;
+}
+
+class MockQueue : public hsa::Queue
+{
+public:
+    MockQueue(const hsa::AgentCache& agent, uint64_t id)
+    : Queue(agent, get_mock_core_table(), get_mock_ext_table())
+    , m_id{id}
+    {
+        create_signal(0, &ready_signal);
+        create_signal(0, &block_signal);
+        mock_signal_store(ready_signal, 0);
+        mock_signal_store(block_signal, 1);
+    }
+
+    rocprofiler_queue_id_t get_id() const final { return {.handle = m_id}; }
+
+    bool is_running() const { return mock_signal_load(block_signal) == 0; }
+
+    size_t pending = kernels_per_queue;
+
+private:
+    uint64_t m_id = 0;
+};
+
+struct mock_node
+{
+    mock_node()
+    {
+        // signals of the previous test must not carry over
+        next_signal = 1;
+        signal_values.clear();
+
+        for(size_t i = 0; i < num_agents; ++i)
+        {
+            auto& _rocp_agent = rocp_agents.at(i);
+            _rocp_agent.size  = sizeof(rocprofiler_agent_t);
+            _rocp_agent.id    = rocprofiler_agent_id_t{.handle = 100 + i};
+            _rocp_agent.type  = ROCPROFILER_AGENT_TYPE_GPU;
+            _rocp_agent.name  = "mock";
+
+            agents.emplace_back(std::make_unique<hsa::AgentCache>(&_rocp_agent,
+                                                                  hsa_agent_t{.handle = 1 + i},
+                                                                  i,
+                                                                  hsa_agent_t{.handle = 0},
+                                                                  get_mock_ext_table(),
+                                                                  get_mock_core_table()));
+        }
+
+        for(size_t i = 0; i < num_agents * queues_per_agent; ++i)
+            queues.emplace_back(std::make_unique<MockQueue>(*agents.at(i % num_agents), i));
+    }
+
+    std::array<rocprofiler_agent_t, num_agents>   rocp_agents = {};
+    std::vector<std::unique_ptr<hsa::AgentCache>> agents      = {};
+    std::vector<std::unique_ptr<MockQueue>>       queues      = {};
+};
+
+// Every queue has kernels_per_queue kernels ready to be dispatched. Each step completes all of
+// the running kernels and records how many kernels ran concurrently. Returns the maximum.
+size_t
+run_kernels(serializer_t& serializer, mock_node& node)
+{
+    serializer.enable({});
+
+    for(auto& itr : node.queues)
+        serializer.queue_ready(nullptr, *itr);
+
+    size_t _max_running = 0;
+    size_t _completed   = 0;
+    while(_completed < node.queues.size() * kernels_per_queue)
+    {
+        auto _running = std::vector<MockQueue*>{};
+        for(auto& itr : node.queues)
+        {
+            if(itr->is_running()) _running.emplace_back(itr.get());
+        }
+
+        // a stalled serializer would never finish
+        EXPECT_FALSE(_running.empty());
+        if(_running.empty()) break;
+
+        // at most one kernel per agent runs at a time
+        for(auto* itr : _running)
+        {
+            EXPECT_EQ(serializer.get_dispatch_queue(*itr), itr);
+            EXPECT_EQ(std::count_if(_running.begin(),
+                                    _running.end(),
+                                    [itr](const MockQueue* q) {
+                                        return &q->get_agent() == &itr->get_agent();
+                                    }),
+                      1);
+        }
+        _max_running = std::max(_max_running, _running.size());
+
+        for(auto* itr : _running)
+        {
+            serializer.kernel_completion_signal(*itr);
+            ++_completed;
+            if(--itr->pending > 0) serializer.queue_ready(nullptr, *itr);
+        }
+    }
+
+    for(auto& itr : node.queues)
+    {
+        EXPECT_EQ(itr->pending, 0);
+        EXPECT_FALSE(itr->is_running());
+    }
+
+    return _max_running;
+}
+}  // namespace
+
+TEST(profiler_serializer, agent_scope)
+{
+    auto _node       = mock_node{};
+    auto _serializer = serializer_t{serializer_t::Scope::AGENT};
+
+    EXPECT_EQ(_serializer.get_scope(), serializer_t::Scope::AGENT);
+    // kernels dispatched to different agents overlap
+    EXPECT_EQ(run_kernels(_serializer, _node), num_agents);
+}
+
+TEST(profiler_serializer, process_scope)
+{
+    auto _node       = mock_node{};
+    auto _serializer = serializer_t{serializer_t::Scope::PROCESS};
+
+    EXPECT_EQ(_serializer.get_scope(), serializer_t::Scope::PROCESS);
+    // all kernels of the process are serialized
+    EXPECT_EQ(run_kernels(_serializer, _node), 1);
+}
+
+TEST(profiler_serializer, agent_scope_fifo)
+{
+    auto  _node       = mock_node{};
+    auto  _serializer = serializer_t{serializer_t::Scope::AGENT};
+    auto& _q0         = *_node.queues.at(0);
+    auto& _q1         = *_node.queues.at(1);
+    auto& _q4         = *_node.queues.at(num_agents);
+
+    // _q0 and _q4 are on the first agent, _q1 on the second agent
+    ASSERT_EQ(&_q0.get_agent(), &_q4.get_agent());
+    ASSERT_NE(&_q0.get_agent(), &_q1.get_agent());
+
+    _serializer.enable({});
+    _serializer.queue_ready(nullptr, _q0);
+    _serializer.queue_ready(nullptr, _q4);
+    _serializer.queue_ready(nullptr, _q1);
+
+    EXPECT_TRUE(_q0.is_running());
+    EXPECT_FALSE(_q4.is_running());
+    EXPECT_TRUE(_q1.is_running());
+    EXPECT_EQ(_serializer.get_dispatch_queue(_q4), &_q0);
+
+    // completing the kernel of the second agent does not release the first agent
+    _serializer.kernel_completion_signal(_q1);
+    EXPECT_TRUE(_q0.is_running());
+    EXPECT_FALSE(_q4.is_running());
+    EXPECT_EQ(_serializer.get_dispatch_queue(_q1), nullptr);
+
+    _serializer.kernel_completion_signal(_q0);
+    EXPECT_FALSE(_q0.is_running());
+    EXPECT_TRUE(_q4.is_running());
+
+    _serializer.kernel_completion_signal(_q4);
+    EXPECT_FALSE(_q4.is_running());
+}
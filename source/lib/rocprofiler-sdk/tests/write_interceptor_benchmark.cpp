@@ -0,0 +1,292 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// CPU-only benchmark of hsa::WriteInterceptor. The HSA signal functions are replaced by mock
+// implementations so no GPU (or HSA runtime initialization) is required. Completion of the
+// dispatches is simulated by invoking the async signal handlers registered by the interceptor.
+
+#include "lib/rocprofiler-sdk/hsa/agent_cache.hpp"
+#include "lib/rocprofiler-sdk/hsa/queue.hpp"
+
+#include <rocprofiler-sdk/agent.h>
+#include <rocprofiler-sdk/fwd.h>
+
+#include <gtest/gtest.h>
+
+#include <hsa/hsa.h>
+#include <hsa/hsa_api_trace.h>
+#include <hsa/hsa_ext_amd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+namespace hsa = ::rocprofiler::hsa;
+
+using pending_handler_t = std::pair<hsa_amd_signal_handler, void*>;
+
+constexpr size_t num_dispatches = 1 << 18;
+constexpr size_t num_iterations = 5;
+// number of in-flight dispatches before the completion of the dispatches is simulated
+constexpr size_t max_in_flight = 256;
+
+auto created_signals   = std::atomic<uint64_t>{0};
+auto destroyed_signals = std::atomic<uint64_t>{0};
+auto written_packets   = std::atomic<uint64_t>{0};
+auto pending_handlers  = std::vector<pending_handler_t>{};
+
+auto*
+get_signal(hsa_signal_t signal)
+{
+    return reinterpret_cast<std::atomic<hsa_signal_value_t>*>(signal.handle);
+}
+
+hsa_status_t
+mock_signal_create(hsa_signal_value_t value, uint32_t, const hsa_agent_t*, hsa_signal_t* signal)
+{
+    ++created_signals;
+    signal->handle = reinterpret_cast<uint64_t>(new std::atomic<hsa_signal_value_t>{value});
+    return HSA_STATUS_SUCCESS;
+}
+
+hsa_status_t
+mock_amd_signal_create(hsa_signal_value_t value,
+                       uint32_t           num_consumers,
+                       const hsa_agent_t* consumers,
+                       uint64_t,
+                       hsa_signal_t* signal)
+{
+    return mock_signal_create(value, num_consumers, consumers, signal);
+}
+
+hsa_status_t
+mock_signal_destroy(hsa_signal_t signal)
+{
+    ++destroyed_signals;
+    delete get_signal(signal);
+    return HSA_STATUS_SUCCESS;
+}
+
+void
+mock_signal_store(hsa_signal_t signal, hsa_signal_value_t value)
+{
+    get_signal(signal)->store(value);
+}
+
+void
+mock_signal_add(hsa_signal_t signal, hsa_signal_value_t value)
+{
+    get_signal(signal)->fetch_add(value);
+}
+
+void
+mock_signal_subtract(hsa_signal_t signal, hsa_signal_value_t value)
+{
+    get_signal(signal)->fetch_sub(value);
+}
+
+hsa_signal_value_t
+mock_signal_load(hsa_signal_t signal)
+{
+    return get_signal(signal)->load();
+}
+
+hsa_signal_value_t
+mock_signal_wait(hsa_signal_t signal,
+                 hsa_signal_condition_t,
+                 hsa_signal_value_t,
+                 uint64_t,
+                 hsa_wait_state_t)
+{
+    return get_signal(signal)->load();
+}
+
+hsa_status_t
+mock_signal_async_handler(hsa_signal_t,
+                          hsa_signal_condition_t,
+                          hsa_signal_value_t,
+                          hsa_amd_signal_handler handler,
+                          void*                  arg)
+{
+    pending_handlers.emplace_back(handler, arg);
+    return HSA_STATUS_SUCCESS;
+}
+
+hsa_status_t
+mock_iterate_memory_pools(hsa_agent_t, hsa_status_t (*)(hsa_amd_memory_pool_t, void*), void*)
+{
+    return HSA_STATUS_ERROR;
+}
+
+void
+mock_writer(const void*, uint64_t pkt_count)
+{
+    written_packets += pkt_count;
+}
+
+CoreApiTable
+get_mock_core_table()
+{
+    auto _v                           = CoreApiTable{};
+    _v.hsa_signal_create_fn           = mock_signal_create;
+    _v.hsa_signal_destroy_fn          = mock_signal_destroy;
+    _v.hsa_signal_store_relaxed_fn    = mock_signal_store;
+    _v.hsa_signal_store_screlease_fn  = mock_signal_store;
+    _v.hsa_signal_add_relaxed_fn      = mock_signal_add;
+    _v.hsa_signal_subtract_relaxed_fn = mock_signal_subtract;
+    _v.hsa_signal_load_scacquire_fn   = mock_signal_load;
+    _v.hsa_signal_wait_relaxed_fn     = mock_signal_wait;
+    return _v;
+}
+
+AmdExtTable
+get_mock_ext_table()
+{
+    auto _v                                  = AmdExtTable{};
+    _v.hsa_amd_signal_create_fn              = mock_amd_signal_create;
+    _v.hsa_amd_signal_async_handler_fn       = mock_signal_async_handler;
+    _v.hsa_amd_agent_iterate_memory_pools_fn = mock_iterate_memory_pools;
+    return _v;
+}
+
+class MockQueue : public hsa::Queue
+{
+public:
+    MockQueue(const hsa::AgentCache& agent)
+    : Queue(agent, get_mock_core_table(), get_mock_ext_table())
+    {}
+
+    rocprofiler_queue_id_t get_id() const final { return {.handle = 0}; }
+};
+
+// invokes the async signal handlers as if all the in-flight dispatches completed
+void
+complete_dispatches()
+{
+    for(auto [handler, arg] : pending_handlers)
+        handler(-1, arg);
+    pending_handlers.clear();
+}
+
+// returns the best dispatch throughput (in millions of dispatches per second)
+double
+measure(MockQueue& queue, size_t batch_size)
+{
+    auto _packets = std::vector<hsa::rocprofiler_packet>(batch_size);
+    for(auto& itr : _packets)
+    {
+        itr.kernel_dispatch        = hsa_kernel_dispatch_packet_t{};
+        itr.kernel_dispatch.header = HSA_PACKET_TYPE_KERNEL_DISPATCH << HSA_PACKET_HEADER_TYPE;
+        itr.kernel_dispatch.workgroup_size_x = 64;
+        itr.kernel_dispatch.grid_size_x      = 1024;
+    }
+
+    using clock_type = std::chrono::steady_clock;
+
+    auto _nbatch = num_dispatches / batch_size;
+    auto _best   = std::chrono::duration<double>::max();
+    pending_handlers.reserve(max_in_flight + batch_size);
+
+    for(size_t n = 0; n < num_iterations; ++n)
+    {
+        auto _beg = clock_type::now();
+        for(size_t i = 0; i < _nbatch; ++i)
+        {
+            hsa::WriteInterceptor(_packets.data(), batch_size, 0, &queue, mock_writer);
+            if(pending_handlers.size() >= max_in_flight) complete_dispatches();
+        }
+        complete_dispatches();
+        auto _end = clock_type::now();
+
+        _best = std::min<std::chrono::duration<double>>(_best, _end - _beg);
+    }
+
+    return (_nbatch * batch_size) / _best.count() / 1.0e6;
+}
+}  // namespace
+
+TEST(write_interceptor, benchmark)
+{
+    auto _rocp_agent = rocprofiler_agent_t{};
+    _rocp_agent.size = sizeof(rocprofiler_agent_t);
+    _rocp_agent.id   = rocprofiler_agent_id_t{std::numeric_limits<uint64_t>::max()};
+    _rocp_agent.type = ROCPROFILER_AGENT_TYPE_GPU;
+    _rocp_agent.name = "mock";
+
+    auto _agent = hsa::AgentCache{&_rocp_agent,
+                                  hsa_agent_t{.handle = 1},
+                                  0,
+                                  hsa_agent_t{.handle = 2},
+                                  get_mock_ext_table(),
+                                  get_mock_core_table()};
+    auto _queue = std::make_unique<MockQueue>(_agent);
+
+    // a notifier is required for the interceptor to transform the packets
+    _queue->register_callback(
+        0,
+        [](const hsa::Queue&,
+           const hsa::rocprofiler_packet&,
+           rocprofiler_kernel_id_t,
+           rocprofiler_dispatch_id_t,
+           rocprofiler_user_data_t*,
+           const hsa::Queue::queue_info_session_t::external_corr_id_map_t&,
+           const rocprofiler::context::correlation_id*) -> std::unique_ptr<hsa::AQLPacket> {
+            return nullptr;
+        },
+        [](const hsa::Queue&,
+           const hsa::rocprofiler_packet&,
+           const hsa::Queue::queue_info_session_t&,
+           hsa::inst_pkt_t&,
+           rocprofiler::kernel_dispatch::profiling_time) {});
+
+    // warm-up populates the signal and session pools
+    measure(*_queue, 64);
+
+    std::cout << std::setw(8) << "batch" << std::setw(20) << "dispatches/sec" << std::setw(20)
+              << "signals created" << "\n";
+
+    for(size_t batch_size : {1, 4, 16, 64})
+    {
+        auto _created = created_signals.load();
+        auto _rate    = measure(*_queue, batch_size);
+        auto _signals = created_signals.load() - _created;
+
+        std::cout << std::setw(8) << batch_size << std::fixed << std::setprecision(3)
+                  << std::setw(14) << _rate << " M/sec" << std::setw(20) << _signals << std::endl;
+
+        // steady-state interception should recycle the signals of the completed dispatches
+        EXPECT_EQ(_signals, 0);
+    }
+
+    EXPECT_GE(written_packets.load(), num_dispatches);
+
+    _queue->remove_callback(0);
+    _queue.reset();
+}
@@ -25,6 +25,7 @@
 #include <rocprofiler-sdk/rocprofiler.h>
 
 #include "lib/common/container/stable_vector.hpp"
+#include "lib/common/environment.hpp"
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk/buffer.hpp"
 #include "lib/rocprofiler-sdk/context/context.hpp"
@@ -34,8 +35,10 @@
 
 #include <hsa/hsa_api_trace.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <exception>
 #include <mutex>
 #include <stdexcept>
 #include <string>
@@ -161,12 +164,19 @@ ThreadTracerQueue::Submit(hsa_ext_amd_aql_pm4_packet_t* packet, bool bWait)
 ThreadTracerQueue::ThreadTracerQueue(thread_trace_parameter_pack _params,
                                      const hsa::AgentCache&      cache,
                                      const CoreApiTable&         coreapi,
-                                     const AmdExtTable&          ext)
+                                     const AmdExtTable&          ext,
+                                     size_t                      num_offload_buffers)
 : params(std::move(_params))
 , agent_id(cache.get_rocp_agent()->id)
 {
     factory = std::make_unique<aql::ThreadTraceAQLPacketFactory>(cache, this->params, coreapi, ext);
-    control_packet = factory->construct_control_packet();
+
+    // every control packet owns a separate trace buffer, the first one is the shared buffer
+    for(size_t i = 0; i < num_offload_buffers + 1; ++i)
+    {
+        control_pool.emplace_back(factory->construct_control_packet());
+        if(i > 0) free_buffers.emplace_back(i);
+    }
 
     auto status = coreapi.hsa_queue_create_fn(cache.get_hsa_agent(),
                                               QUEUE_SIZE,
@@ -194,10 +204,28 @@ ThreadTracerQueue::ThreadTracerQueue(thread_trace_parameter_pack _params,
         [this](uint64_t codeobj_id) { this->unload_codeobj(codeobj_id); });
 
     codeobj_reg->IterateLoaded();
+
+    if(num_offload_buffers > 0)
+    {
+        internal_threading::notify_pre_internal_thread_create(ROCPROFILER_LIBRARY);
+        offload_thread = std::thread{[this]() { this->offload_worker(); }};
+        internal_threading::notify_post_internal_thread_create(ROCPROFILER_LIBRARY);
+    }
 }
 
 ThreadTracerQueue::~ThreadTracerQueue()
 {
+    if(offload_thread.joinable())
+    {
+        // the worker exits once every buffer handed to it has been drained
+        {
+            std::unique_lock<std::mutex> offload_lk(offload_mut);
+            offload_exit = true;
+        }
+        offload_cv.notify_all();
+        offload_thread.join();
+    }
+
     std::unique_lock<std::mutex> lk(trace_resources_mut);
     if(active_traces.load() < 1)
     {
@@ -207,6 +235,7 @@ ThreadTracerQueue::~ThreadTracerQueue()
 
     ROCP_WARNING << "Thread tracer being destroyed with thread trace active";
 
+    auto& control_packet = control_pool.front();
     control_packet->clear();
     control_packet->populate_after();
 
@@ -225,7 +254,7 @@ ThreadTracerQueue::get_control(bool bStart)
 {
     std::unique_lock<std::mutex> lk(trace_resources_mut);
 
-    auto active_resources = std::make_unique<hsa::TraceControlAQLPacket>(*control_packet);
+    auto active_resources = std::make_unique<hsa::TraceControlAQLPacket>(*control_pool.front());
     active_resources->clear();
 
     if(bStart) active_traces.fetch_add(1);
@@ -233,6 +262,117 @@ ThreadTracerQueue::get_control(bool bStart)
     return active_resources;
 }
 
+// invoked from the kernel dispatch interceptor so it never waits for the offload worker: the
+// shared buffer is used while every offload buffer is being drained
+std::unique_ptr<hsa::TraceControlAQLPacket>
+ThreadTracerQueue::acquire_control()
+{
+    size_t idx = 0;
+    {
+        std::unique_lock<std::mutex> offload_lk(offload_mut);
+        if(!free_buffers.empty())
+        {
+            idx = free_buffers.back();
+            free_buffers.pop_back();
+        }
+    }
+
+    std::unique_lock<std::mutex> lk(trace_resources_mut);
+
+    auto active_resources = std::make_unique<hsa::TraceControlAQLPacket>(*control_pool.at(idx));
+    active_resources->clear();
+
+    active_traces.fetch_add(1);
+
+    return active_resources;
+}
+
+bool
+ThreadTracerQueue::is_shared_buffer(aqlprofile_handle_t handle) const
+{
+    return control_pool.front()->GetHandle().handle == handle.handle;
+}
+
+void
+ThreadTracerQueue::release_control(aqlprofile_handle_t handle)
+{
+    active_traces.fetch_sub(1);
+    if(is_shared_buffer(handle)) return;
+
+    std::unique_lock<std::mutex> offload_lk(offload_mut);
+
+    for(size_t i = 1; i < control_pool.size(); i++)
+    {
+        if(control_pool.at(i)->GetHandle().handle != handle.handle) continue;
+
+        free_buffers.emplace_back(i);
+        return;
+    }
+
+    ROCP_ERROR << "Released thread trace buffer does not belong to the pool";
+}
+
+void
+ThreadTracerQueue::offload_data(aqlprofile_handle_t handle, rocprofiler_user_data_t data)
+{
+    // the next dispatch may use the shared buffer once the serializer releases it so the data is
+    // copied out first. The tool may thus receive it before the data of earlier dispatches which
+    // are still being drained
+    if(is_shared_buffer(handle))
+    {
+        iterate_data(handle, data);
+        release_control(handle);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> offload_lk(offload_mut);
+        offload_queue.emplace_back(offload_request{handle, data});
+        ++num_offloading;
+    }
+    offload_cv.notify_one();
+}
+
+void
+ThreadTracerQueue::drain()
+{
+    // the tool may stop the context from within the shader data callback
+    if(std::this_thread::get_id() == offload_thread.get_id()) return;
+
+    std::unique_lock<std::mutex> offload_lk(offload_mut);
+    release_cv.wait(offload_lk, [this]() { return num_offloading == 0; });
+}
+
+void
+ThreadTracerQueue::offload_worker()
+{
+    std::unique_lock<std::mutex> offload_lk(offload_mut);
+
+    while(true)
+    {
+        offload_cv.wait(offload_lk, [this]() { return offload_exit || !offload_queue.empty(); });
+        if(offload_queue.empty()) return;
+
+        auto request = offload_queue.front();
+        offload_queue.pop_front();
+        offload_lk.unlock();
+
+        try
+        {
+            iterate_data(request.handle, request.userdata);
+        } catch(std::exception& e)
+        {
+            ROCP_ERROR << "Thread trace offload failed: " << e.what();
+        }
+
+        release_control(request.handle);
+
+        offload_lk.lock();
+        --num_offloading;
+        release_cv.notify_all();
+    }
+}
+
 hsa_status_t
 thread_trace_callback(uint32_t shader, void* buffer, uint64_t size, void* callback_data)
 {
@@ -252,8 +392,6 @@ ThreadTracerQueue::iterate_data(aqlprofile_handle_t handle, rocprofiler_user_dat
 
     auto status = aqlprofile_att_iterate_data(handle, thread_trace_callback, &cb_dt);
     CHECK_HSA(status, "Failed to iterate ATT data");
-
-    active_traces.fetch_sub(1);
 }
 
 void
@@ -261,7 +399,8 @@ ThreadTracerQueue::load_codeobj(code_object_id_t id, uint64_t addr, uint64_t siz
 {
     std::unique_lock<std::mutex> lk(trace_resources_mut);
 
-    control_packet->add_codeobj(id, addr, size);
+    for(auto& control_packet : control_pool)
+        control_packet->add_codeobj(id, addr, size);
 
     if(!queue || active_traces.load() < 1) return;
 
@@ -274,7 +413,11 @@ ThreadTracerQueue::unload_codeobj(code_object_id_t id)
 {
     std::unique_lock<std::mutex> lk(trace_resources_mut);
 
-    if(!control_packet->remove_codeobj(id)) return;
+    bool removed = false;
+    for(auto& control_packet : control_pool)
+        if(control_packet->remove_codeobj(id)) removed = true;
+
+    if(!removed) return;
     if(!queue || active_traces.load() < 1) return;
 
     auto packet = factory->construct_unload_marker_packet(id);
@@ -296,7 +439,12 @@ DispatchThreadTracer::resource_init(const hsa::AgentCache& cache,
         return;
     }
 
-    auto new_tracer = std::make_unique<ThreadTracerQueue>(this->params, cache, coreapi, ext);
+    // the pool holds the shared buffer and the offload buffers, which the traced dispatches rotate
+    // through while the completed ones are being drained. Each buffer is a full trace buffer
+    auto pool_size = common::get_env("ROCPROFILER_ATT_BUFFER_POOL_SIZE",
+                                     size_t{thread_trace_parameter_pack::DEFAULT_BUFFER_POOL_SIZE});
+    auto new_tracer = std::make_unique<ThreadTracerQueue>(
+        this->params, cache, coreapi, ext, std::max<size_t>(pool_size, 1) - 1);
     agents.emplace(agent, std::move(new_tracer));
 }
 
@@ -360,7 +508,8 @@ DispatchThreadTracer::pre_kernel_call(const hsa::Queue&              queue,
     auto it = agents.find(queue.get_agent().get_hsa_agent());
     assert(it != agents.end() && it->second != nullptr);
 
-    auto packet = it->second->get_control(true);
+    // does not wait for the offload buffers being drained
+    auto packet = it->second->acquire_control();
 
     post_move_data.fetch_add(1);
     maybe_add_serialization(packet);
@@ -403,11 +552,15 @@ DispatchThreadTracer::post_kernel_call(DispatchThreadTracer::inst_pkt_t&       a
         std::shared_lock<std::shared_mutex> lk(agents_map_mut);
         post_move_data.fetch_sub(1);
 
-        if(pkt->after_krn_pkt.empty()) continue;
-
         auto it = agents.find(pkt->GetAgent());
-        if(it != agents.end() && it->second != nullptr)
-            it->second->iterate_data(pkt->GetHandle(), session.user_data);
+        if(it == agents.end() || it->second == nullptr) continue;
+
+        // copying the trace out is deferred to the offload worker of the agent so the completion
+        // of other dispatches is not held up by it
+        if(pkt->after_krn_pkt.empty())
+            it->second->release_control(pkt->GetHandle());
+        else
+            it->second->offload_data(pkt->GetHandle(), session.user_data);
     }
 }
 
@@ -441,7 +594,7 @@ DispatchThreadTracer::start_context()
 }
 
 void
-DispatchThreadTracer::stop_context()  // NOLINT(readability-convert-member-functions-to-static)
+DispatchThreadTracer::stop_context()
 {
     client.wlock([&](auto& client_id) {
         if(!client_id) return;
@@ -451,6 +604,13 @@ DispatchThreadTracer::stop_context()  // NOLINT(readability-convert-member-funct
         client_id = std::nullopt;
     });
 
+    {
+        // deliver the trace data of the completed dispatches before returning
+        std::shared_lock<std::shared_mutex> lk(agents_map_mut);
+        for(auto& [_, tracer] : agents)
+            if(tracer) tracer->drain();
+    }
+
     auto* controller = hsa::get_queue_controller();
     if(controller) controller->disable_serialization();
 }
@@ -536,6 +696,7 @@ AgentThreadTracer::stop_context()
         signal->WaitOn();
         rocprofiler_user_data_t userdata{.ptr = tracer->params.callback_userdata};
         tracer->iterate_data(handle, userdata);
+        tracer->release_control(handle);
     }
 }
 
@@ -34,12 +34,15 @@
 #include <rocprofiler-sdk/cxx/operators.hpp>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -76,9 +79,23 @@ struct thread_trace_parameter_pack
     static constexpr size_t DEFAULT_BUFFER_SIZE           = 0x8000000;
     static constexpr size_t PERFCOUNTER_SIMD_MASK_SHIFT   = 28;
 
+    // number of trace buffers per agent for dispatch tracing (ROCPROFILER_ATT_BUFFER_POOL_SIZE).
+    // Each one is a full trace buffer of buffer_size bytes (128 MB by default) so the memory used
+    // per agent is the pool size times the buffer size
+    static constexpr size_t DEFAULT_BUFFER_POOL_SIZE = 1;
+
     bool are_params_valid() const;
 };
 
+/**
+ * Owns the thread trace resources of one agent. Every agent has a shared trace buffer whose data
+ * is copied out synchronously: by iterate_data for agent tracing and on the completion path of the
+ * dispatch for dispatch tracing. When constructed with a non-zero number of offload buffers
+ * (dispatch tracing), each of them is a separate full-size trace buffer: a traced dispatch
+ * acquires a free offload buffer and, once the dispatch completes, ownership of the buffer is
+ * handed to a worker thread which copies the data out to the tool and returns the buffer to the
+ * pool. A dispatch falls back to the shared buffer while every offload buffer is being drained.
+ */
 class ThreadTracerQueue
 {
     using code_object_id_t = uint64_t;
@@ -87,7 +104,8 @@ public:
     ThreadTracerQueue(thread_trace_parameter_pack _params,
                       const hsa::AgentCache&,
                       const CoreApiTable&,
-                      const AmdExtTable&);
+                      const AmdExtTable&,
+                      size_t num_offload_buffers = 0);
     virtual ~ThreadTracerQueue();
 
     void load_codeobj(code_object_id_t id, uint64_t addr, uint64_t size);
@@ -96,13 +114,23 @@ public:
     std::unique_ptr<hsa::TraceControlAQLPacket> get_control(bool bStart);
     void iterate_data(aqlprofile_handle_t handle, rocprofiler_user_data_t data);
 
+    // Acquires a free offload buffer or, when there is none, the shared buffer. Never blocks
+    std::unique_ptr<hsa::TraceControlAQLPacket> acquire_control();
+    // Hands an offload buffer of a completed dispatch to the worker, which releases it once
+    // drained. The shared buffer is copied out and released before returning
+    void offload_data(aqlprofile_handle_t handle, rocprofiler_user_data_t data);
+    // Ends the trace using the buffer and returns an offload buffer to the pool. The contents of
+    // the buffer are not read
+    void release_control(aqlprofile_handle_t handle);
+    // Waits until the worker has drained all the buffers handed to it
+    void drain();
+
     hsa_queue_t*                queue = nullptr;
     std::mutex                  trace_resources_mut;
     thread_trace_parameter_pack params;
     std::atomic<int>            active_traces{0};
     std::atomic<int>            active_queues{1};
 
-    std::unique_ptr<hsa::TraceControlAQLPacket>       control_packet;
     std::unique_ptr<aql::ThreadTraceAQLPacketFactory> factory;
 
     [[nodiscard]] std::unique_ptr<class Signal> Submit(hsa_ext_amd_aql_pm4_packet_t* packet,
@@ -120,10 +148,33 @@ public:
     }
 
 private:
+    struct offload_request
+    {
+        aqlprofile_handle_t     handle   = {};
+        rocprofiler_user_data_t userdata = {};
+    };
+
+    void offload_worker();
+    bool is_shared_buffer(aqlprofile_handle_t handle) const;
+
     std::unique_ptr<code_object::CodeobjCallbackRegistry> codeobj_reg{nullptr};
 
     rocprofiler_agent_id_t agent_id;
 
+    // the first packet owns the shared buffer and the others the offload buffers. The code object
+    // markers of the packets are guarded by trace_resources_mut, the free list of offload buffers
+    // and the offload queue by offload_mut
+    std::vector<std::unique_ptr<hsa::TraceControlAQLPacket>> control_pool = {};
+
+    std::vector<size_t>         free_buffers   = {};
+    std::deque<offload_request> offload_queue  = {};
+    size_t                      num_offloading = 0;
+    bool                        offload_exit   = false;
+    std::mutex                  offload_mut    = {};
+    std::condition_variable     offload_cv     = {};
+    std::condition_variable     release_cv     = {};
+    std::thread                 offload_thread = {};
+
     decltype(hsa_queue_load_read_index_relaxed)* load_read_index_relaxed_fn{nullptr};
     decltype(hsa_queue_add_write_index_relaxed)* add_write_index_relaxed_fn{nullptr};
     decltype(hsa_signal_store_screlease)*        signal_store_screlease_fn{nullptr};
@@ -22,11 +22,15 @@
 
 #include <rocprofiler-sdk/amd_detail/thread_trace.h>
 #include <rocprofiler-sdk/rocprofiler.h>
+#include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include "lib/rocprofiler-sdk/aql/aql_profile_v2.h"
+#include "lib/rocprofiler-sdk/internal_threading.hpp"
 
 #define AQLPROFILE_OCCUPANCY_RESOLUTION 8
 
@@ -72,29 +76,108 @@ forward_hsa_error(hsa_status_t error_code)
     return ROCPROFILER_STATUS_ERROR;
 }
 
-struct userdata_callback_table_t
+struct trace_type_ids_t
 {
-    rocprofiler_att_parser_trace_callback_t   trace;
-    rocprofiler_att_parser_isa_callback_t     isa;
-    rocprofiler_att_parser_se_data_callback_t se_data;
-    void*                                     user;
-
-    std::vector<pcinfo_t> kernel_id_map;
+    int trace_data  = -1;
+    int kernel_addr = -1;
+    int occupancy   = -1;
 };
 
-thread_local int TRACE_DATA_ID{-1};
-thread_local int KERNEL_ADDR_ID{-1};
-thread_local int OCCUPANCY_ID{-1};
-
 void
-iterate_trace_type(int id, const char* metadata, void*)
+iterate_trace_type(int id, const char* metadata, void* userdata)
 {
+    auto& ids = *static_cast<trace_type_ids_t*>(userdata);
     if(std::string_view(metadata).find("occupancy") == 0)
-        OCCUPANCY_ID = id;
+        ids.occupancy = id;
     else if(std::string_view(metadata).find("kernel_ids_addr") == 0)
-        KERNEL_ADDR_ID = id;
+        ids.kernel_addr = id;
     else if(std::string_view(metadata).find("tracedata") == 0)
-        TRACE_DATA_ID = id;
+        ids.trace_data = id;
+}
+
+const trace_type_ids_t&
+get_trace_type_ids()
+{
+    static const auto _v = []() {
+        auto _ids = trace_type_ids_t{};
+        aqlprofile_att_parser_iterate_event_list(iterate_trace_type, &_ids);
+        return _ids;
+    }();
+    return _v;
+}
+
+// number of records of each type delivered per batch
+constexpr size_t batch_capacity = 16384;
+
+struct userdata_callback_table_t
+{
+    rocprofiler_att_parser_trace_callback_t   trace   = nullptr;
+    rocprofiler_att_parser_batch_callback_t   batch   = nullptr;
+    rocprofiler_att_parser_isa_callback_t     isa     = nullptr;
+    rocprofiler_att_parser_se_data_callback_t se_data = nullptr;
+    void*                                     user    = nullptr;
+
+    // shader engine being parsed by rocprofiler_att_parse_data_batched
+    const rocprofiler_att_parser_shader_engine_data_t* shader_engine = nullptr;
+    bool                                               consumed      = false;
+
+    std::vector<pcinfo_t>                              kernel_id_map = {};
+    std::vector<rocprofiler_att_data_type_isa_t>       isa_batch     = {};
+    std::vector<rocprofiler_att_data_type_occupancy_t> occ_batch     = {};
+
+    void flush();
+};
+
+void
+userdata_callback_table_t::flush()
+{
+    if(isa_batch.empty() && occ_batch.empty()) return;
+
+    auto _batch             = rocprofiler_att_parser_batch_t{};
+    _batch.size             = sizeof(rocprofiler_att_parser_batch_t);
+    _batch.shader_engine_id = shader_engine->shader_engine_id;
+    _batch.isa              = isa_batch.data();
+    _batch.isa_count        = isa_batch.size();
+    _batch.occupancy        = occ_batch.data();
+    _batch.occupancy_count  = occ_batch.size();
+    batch(&_batch, user);
+
+    isa_batch.clear();
+    occ_batch.clear();
+}
+
+void
+set_kernel_id_map(userdata_callback_table_t& table, const void* trace_events, uint64_t trace_size)
+{
+    const auto* events = static_cast<const pcinfo_t*>(trace_events);
+    table.kernel_id_map.assign(events, events + trace_size);
+}
+
+rocprofiler_att_data_type_occupancy_t
+get_occupancy(const userdata_callback_table_t& table, const att_occupancy_info_t& event)
+{
+    auto occ      = rocprofiler_att_data_type_occupancy_t{};
+    occ.timestamp = event.time * AQLPROFILE_OCCUPANCY_RESOLUTION;
+    occ.enabled   = event.enable;
+    // Not having a kernel_id_map entry is unexpected, but valid
+    if(event.kernel_id < table.kernel_id_map.size())
+    {
+        const auto& kernel_id_addr = table.kernel_id_map[event.kernel_id];
+        occ.marker_id              = kernel_id_addr.marker_id;
+        occ.offset                 = kernel_id_addr.addr;
+    }
+    return occ;
+}
+
+rocprofiler_att_data_type_isa_t
+get_isa(const att_trace_event_t& event)
+{
+    auto isa      = rocprofiler_att_data_type_isa_t{};
+    isa.marker_id = event.pc.marker_id;
+    isa.offset    = event.pc.addr;
+    isa.hitcount  = event.hitcount;
+    isa.latency   = event.latency;
+    return isa;
 }
 
 hsa_status_t
@@ -105,44 +188,28 @@ trace_callback(int trace_type_id,
                void*    userdata)
 {
     assert(userdata);
-    auto& table = *reinterpret_cast<userdata_callback_table_t*>(userdata);
+    auto&       table = *reinterpret_cast<userdata_callback_table_t*>(userdata);
+    const auto& ids   = get_trace_type_ids();
 
-    if(trace_type_id == KERNEL_ADDR_ID)
+    if(trace_type_id == ids.kernel_addr)
     {
-        table.kernel_id_map.resize(trace_size);
-        const auto* events = reinterpret_cast<const pcinfo_t*>(trace_events);
-
-        for(size_t i = 0; i < trace_size; i++)
-            table.kernel_id_map.at(i) = events[i];
+        set_kernel_id_map(table, trace_events, trace_size);
     }
-    else if(trace_type_id == OCCUPANCY_ID)
+    else if(trace_type_id == ids.occupancy)
     {
         const auto* events = reinterpret_cast<const att_occupancy_info_t*>(trace_events);
         for(size_t i = 0; i < trace_size; i++)
         {
-            rocprofiler_att_data_type_occupancy_t occ{};
-            occ.timestamp = events[i].time * AQLPROFILE_OCCUPANCY_RESOLUTION;
-            occ.enabled   = events[i].enable;
-            try
-            {
-                pcinfo_t kernel_id_addr = table.kernel_id_map.at(events[i].kernel_id);
-                occ.marker_id           = kernel_id_addr.marker_id;
-                occ.offset              = kernel_id_addr.addr;
-            } catch(...)
-            {}  // Not having a kernel_id_map entry is unexpected, but valid
+            auto occ = get_occupancy(table, events[i]);
             table.trace(ROCPROFILER_ATT_PARSER_DATA_TYPE_OCCUPANCY, (void*) &occ, table.user);
         }
     }
-    else if(trace_type_id == TRACE_DATA_ID)
+    else if(trace_type_id == ids.trace_data)
     {
         const auto* events = reinterpret_cast<const att_trace_event_t*>(trace_events);
         for(size_t i = 0; i < trace_size; i++)
         {
-            rocprofiler_att_data_type_isa_t isa{};
-            isa.marker_id = events[i].pc.marker_id;
-            isa.offset    = events[i].pc.addr;
-            isa.hitcount  = events[i].hitcount;
-            isa.latency   = events[i].latency;
+            auto isa = get_isa(events[i]);
             table.trace(ROCPROFILER_ATT_PARSER_DATA_TYPE_ISA, (void*) &isa, table.user);
         }
     }
@@ -150,6 +217,44 @@ trace_callback(int trace_type_id,
     return HSA_STATUS_SUCCESS;
 }
 
+// same as trace_callback but the records are appended to the batches of the table
+hsa_status_t
+batch_trace_callback(int trace_type_id,
+                     int /* correlation_id */,
+                     void*    trace_events,
+                     uint64_t trace_size,
+                     void*    userdata)
+{
+    assert(userdata);
+    auto&       table = *reinterpret_cast<userdata_callback_table_t*>(userdata);
+    const auto& ids   = get_trace_type_ids();
+
+    if(trace_type_id == ids.kernel_addr)
+    {
+        set_kernel_id_map(table, trace_events, trace_size);
+    }
+    else if(trace_type_id == ids.occupancy)
+    {
+        const auto* events = reinterpret_cast<const att_occupancy_info_t*>(trace_events);
+        for(size_t i = 0; i < trace_size; i++)
+        {
+            table.occ_batch.emplace_back(get_occupancy(table, events[i]));
+            if(table.occ_batch.size() == batch_capacity) table.flush();
+        }
+    }
+    else if(trace_type_id == ids.trace_data)
+    {
+        const auto* events = reinterpret_cast<const att_trace_event_t*>(trace_events);
+        for(size_t i = 0; i < trace_size; i++)
+        {
+            table.isa_batch.emplace_back(get_isa(events[i]));
+            if(table.isa_batch.size() == batch_capacity) table.flush();
+        }
+    }
+
+    return HSA_STATUS_SUCCESS;
+}
+
 hsa_status_t
 isa_callback(char* isa,
              char* /*  source_reference  */,
@@ -179,6 +284,46 @@ se_data_callback(int* seid, uint8_t** buffer, uint64_t* buffer_size, void* userd
     return table.se_data(seid, buffer, buffer_size, table.user);
 }
 
+// hands the data of the shader engine to the parser in a single call
+uint64_t
+shader_engine_data_callback(int* seid, uint8_t** buffer, uint64_t* buffer_size, void* userdata)
+{
+    assert(userdata);
+    auto& table = *reinterpret_cast<userdata_callback_table_t*>(userdata);
+    if(table.consumed) return 0;
+
+    table.consumed = true;
+    *seid          = static_cast<int>(table.shader_engine->shader_engine_id);
+    *buffer        = const_cast<uint8_t*>(table.shader_engine->data);
+    *buffer_size   = table.shader_engine->data_size;
+    return *buffer_size;
+}
+
+rocprofiler_status_t
+parse_shader_engine(const rocprofiler_att_parser_shader_engine_data_t& shader_engine,
+                    rocprofiler_att_parser_batch_callback_t            batch_callback,
+                    rocprofiler_att_parser_isa_callback_t              isa_callback,
+                    void*                                              userdata)
+{
+    auto table          = userdata_callback_table_t{};
+    table.batch         = batch_callback;
+    table.isa           = isa_callback;
+    table.user          = userdata;
+    table.shader_engine = &shader_engine;
+    table.isa_batch.reserve(batch_capacity);
+    table.occ_batch.reserve(batch_capacity);
+
+    hsa_status_t status = aqlprofile_att_parse_data(shader_engine_data_callback,
+                                                    batch_trace_callback,
+                                                    rocprofiler::att_parser::isa_callback,
+                                                    &table);
+    // deliver whatever was parsed, even on failure
+    table.flush();
+
+    if(status != HSA_STATUS_SUCCESS) return forward_hsa_error(status);
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
 }  // namespace att_parser
 }  // namespace rocprofiler
 
@@ -189,12 +334,8 @@ rocprofiler_att_parse_data(rocprofiler_att_parser_se_data_callback_t user_se_dat
                            rocprofiler_att_parser_isa_callback_t     user_isa_callback,
                            void*                                     userdata)
 {
-    static thread_local bool bInit = []() {
-        aqlprofile_att_parser_iterate_event_list(rocprofiler::att_parser::iterate_trace_type,
-                                                 nullptr);
-        return true;
-    }();
-    (void) bInit;
+    // initializes the trace type ids
+    rocprofiler::att_parser::get_trace_type_ids();
 
     rocprofiler::att_parser::userdata_callback_table_t table;
     table.trace   = user_trace_callback;
@@ -210,4 +351,52 @@ rocprofiler_att_parse_data(rocprofiler_att_parser_se_data_callback_t user_se_dat
     if(status != HSA_STATUS_SUCCESS) return rocprofiler::att_parser::forward_hsa_error(status);
     return ROCPROFILER_STATUS_SUCCESS;
 }
+
+rocprofiler_status_t
+rocprofiler_att_parse_data_batched(
+    const rocprofiler_att_parser_shader_engine_data_t* shader_engines,
+    uint64_t                                           num_shader_engines,
+    rocprofiler_att_parser_batch_callback_t            batch_callback,
+    rocprofiler_att_parser_isa_callback_t              isa_callback,
+    uint64_t                                           flags,
+    void*                                              userdata)
+{
+    if(!batch_callback || !isa_callback || (num_shader_engines > 0 && !shader_engines))
+        return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    rocprofiler::att_parser::get_trace_type_ids();
+
+    auto _status = std::vector<rocprofiler_status_t>(num_shader_engines,
+                                                     ROCPROFILER_STATUS_SUCCESS);
+    auto _next   = std::atomic<size_t>{0};
+    auto _worker = [&]() {
+        for(size_t i = _next++; i < num_shader_engines; i = _next++)
+            _status.at(i) = rocprofiler::att_parser::parse_shader_engine(
+                shader_engines[i], batch_callback, isa_callback, userdata);
+    };
+
+    // the shader engines are distributed over the threads of the internal thread pool and the
+    // calling thread, which is one of the workers. The shader engines are parsed in the calling
+    // thread when the thread pool is not available (i.e. after finalization)
+    auto* _task_group = (flags & ROCPROFILER_ATT_PARSER_FLAG_PARALLEL_SHADER_ENGINES) != 0
+                            ? rocprofiler::internal_threading::get_parallel_task_group()
+                            : nullptr;
+    if(_task_group)
+    {
+        auto _num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        auto _num_tasks   = std::min<size_t>(num_shader_engines, _num_threads);
+        for(size_t i = 1; i < _num_tasks; ++i)
+            _task_group->exec(_worker);
+        _worker();
+        _task_group->wait();
+    }
+    else
+    {
+        _worker();
+    }
+
+    for(auto itr : _status)
+        if(itr != ROCPROFILER_STATUS_SUCCESS) return itr;
+    return ROCPROFILER_STATUS_SUCCESS;
+}
 }
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <map>
 #include <string>
@@ -103,12 +104,15 @@ TEST(thread_trace, resource_creation)
         thread_trace::thread_trace_parameter_pack params{};
         thread_trace::DispatchThreadTracer        tracer(std::move(params));
 
+        // the shared buffer and two offload buffers per agent
+        setenv("ROCPROFILER_ATT_BUFFER_POOL_SIZE", "3", 1);
         for(const auto& [_, agent] : agents)
         {
             // Init twice to simulate two queues
             tracer.resource_init(agent, get_api_table(), get_ext_table());
             tracer.resource_init(agent, get_api_table(), get_ext_table());
         }
+        unsetenv("ROCPROFILER_ATT_BUFFER_POOL_SIZE");
 
         for(auto& [_, agenttracer] : tracer.agents)
         {
@@ -117,6 +121,37 @@ TEST(thread_trace, resource_creation)
             agenttracer->unload_codeobj(1);
         }
 
+        for(auto& [_, agenttracer] : tracer.agents)
+        {
+            // Each traced dispatch rotates to a separate trace buffer
+            auto first  = agenttracer->acquire_control();
+            auto second = agenttracer->acquire_control();
+            ASSERT_NE(first->GetHandle().handle, second->GetHandle().handle);
+
+            // Without a free offload buffer, dispatches fall back to the shared buffer instead of
+            // waiting
+            auto shared       = agenttracer->acquire_control();
+            auto shared_again = agenttracer->acquire_control();
+            ASSERT_NE(shared->GetHandle().handle, first->GetHandle().handle);
+            ASSERT_NE(shared->GetHandle().handle, second->GetHandle().handle);
+            ASSERT_EQ(shared->GetHandle().handle, shared_again->GetHandle().handle);
+            EXPECT_EQ(agenttracer->active_traces.load(), 4);
+
+            // A released buffer is reused by the next dispatch
+            agenttracer->release_control(first->GetHandle());
+            auto third = agenttracer->acquire_control();
+            ASSERT_EQ(first->GetHandle().handle, third->GetHandle().handle);
+
+            agenttracer->release_control(second->GetHandle());
+            agenttracer->release_control(third->GetHandle());
+            agenttracer->release_control(shared->GetHandle());
+            agenttracer->release_control(shared_again->GetHandle());
+            agenttracer->drain();
+
+            // Every released buffer ends its trace
+            EXPECT_EQ(agenttracer->active_traces.load(), 0);
+        }
+
         for(const auto& [_, agent] : agents)
         {
             // Deinit twice to remove both queues
@@ -0,0 +1,244 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Replays captured thread trace data through the ATT parser without a GPU. The directory in
+// ROCPROFILER_ATT_BENCHMARK_DATA is expected to contain one "*.att" file per shader engine
+// (the raw data received by rocprofiler_att_shader_data_callback_t), the shader engine ids
+// are assigned in the sorted order of the file names. No code objects are loaded: the ISA
+// callback returns a placeholder instruction so the benchmark measures the decoding and the
+// delivery of the records, not the disassembly.
+
+#include "lib/common/filesystem.hpp"
+
+#include <rocprofiler-sdk/amd_detail/thread_trace.h>
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+namespace fs = ::rocprofiler::common::filesystem;
+
+constexpr size_t           num_iterations = 3;
+constexpr std::string_view placeholder    = "s_nop 0";
+
+struct totals_t
+{
+    std::atomic<uint64_t> isa       = {0};
+    std::atomic<uint64_t> occupancy = {0};
+    std::atomic<uint64_t> hitcount  = {0};
+};
+
+// data of the shader engine being parsed by rocprofiler_att_parse_data
+struct replay_t
+{
+    const rocprofiler_att_parser_shader_engine_data_t* shader_engine = nullptr;
+    bool                                               consumed      = false;
+    uint64_t                                           isa           = 0;
+    uint64_t                                           occupancy     = 0;
+    uint64_t                                           hitcount      = 0;
+};
+
+std::vector<std::vector<uint8_t>>
+load_shader_engines(const fs::path& dir)
+{
+    auto _files = std::vector<fs::path>{};
+    for(const auto& itr : fs::directory_iterator{dir})
+        if(itr.path().extension() == ".att") _files.emplace_back(itr.path());
+    std::sort(_files.begin(), _files.end());
+
+    auto _data = std::vector<std::vector<uint8_t>>{};
+    for(const auto& itr : _files)
+    {
+        auto _ifs = std::ifstream{itr, std::ios::binary};
+        _data.emplace_back(std::istreambuf_iterator<char>{_ifs}, std::istreambuf_iterator<char>{});
+    }
+    return _data;
+}
+
+rocprofiler_status_t
+isa_callback(char*     isa_instruction,
+             uint64_t* isa_memory_size,
+             uint64_t* isa_size,
+             uint64_t,
+             uint64_t,
+             void*)
+{
+    auto _size = *isa_size;
+    *isa_size  = placeholder.size();
+    if(_size < placeholder.size()) return ROCPROFILER_STATUS_ERROR_OUT_OF_RESOURCES;
+
+    std::memcpy(isa_instruction, placeholder.data(), placeholder.size());
+    *isa_memory_size = 4;
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
+uint64_t
+se_data_callback(int* seid, uint8_t** buffer, uint64_t* buffer_size, void* userdata)
+{
+    auto& _replay = *static_cast<replay_t*>(userdata);
+    if(_replay.consumed) return 0;
+
+    _replay.consumed = true;
+    *seid            = static_cast<int>(_replay.shader_engine->shader_engine_id);
+    *buffer          = const_cast<uint8_t*>(_replay.shader_engine->data);
+    *buffer_size     = _replay.shader_engine->data_size;
+    return *buffer_size;
+}
+
+void
+trace_callback(rocprofiler_att_parser_data_type_t type, void* att_data, void* userdata)
+{
+    auto& _replay = *static_cast<replay_t*>(userdata);
+    if(type == ROCPROFILER_ATT_PARSER_DATA_TYPE_ISA)
+    {
+        ++_replay.isa;
+        _replay.hitcount += static_cast<rocprofiler_att_data_type_isa_t*>(att_data)->hitcount;
+    }
+    else if(type == ROCPROFILER_ATT_PARSER_DATA_TYPE_OCCUPANCY)
+    {
+        ++_replay.occupancy;
+    }
+}
+
+void
+batch_callback(const rocprofiler_att_parser_batch_t* batch, void* userdata)
+{
+    auto&    _totals   = *static_cast<totals_t*>(userdata);
+    uint64_t _hitcount = 0;
+    for(uint64_t i = 0; i < batch->isa_count; ++i)
+        _hitcount += batch->isa[i].hitcount;
+
+    _totals.isa.fetch_add(batch->isa_count, std::memory_order_relaxed);
+    _totals.occupancy.fetch_add(batch->occupancy_count, std::memory_order_relaxed);
+    _totals.hitcount.fetch_add(_hitcount, std::memory_order_relaxed);
+}
+
+// one rocprofiler_att_parse_data call per shader engine with a callback per record
+void
+parse_per_record(const std::vector<rocprofiler_att_parser_shader_engine_data_t>& shader_engines,
+                 totals_t&                                                       totals)
+{
+    for(const auto& itr : shader_engines)
+    {
+        auto _replay          = replay_t{};
+        _replay.shader_engine = &itr;
+        EXPECT_EQ(rocprofiler_att_parse_data(
+                      se_data_callback, trace_callback, isa_callback, &_replay),
+                  ROCPROFILER_STATUS_SUCCESS);
+        totals.isa += _replay.isa;
+        totals.occupancy += _replay.occupancy;
+        totals.hitcount += _replay.hitcount;
+    }
+}
+
+void
+parse_batched(const std::vector<rocprofiler_att_parser_shader_engine_data_t>& shader_engines,
+              totals_t&                                                       totals,
+              uint64_t                                                        flags)
+{
+    EXPECT_EQ(rocprofiler_att_parse_data_batched(shader_engines.data(),
+                                                 shader_engines.size(),
+                                                 batch_callback,
+                                                 isa_callback,
+                                                 flags,
+                                                 &totals),
+              ROCPROFILER_STATUS_SUCCESS);
+}
+
+// returns the best time (in seconds) of parsing all the shader engines
+template <typename FuncT>
+double
+measure(FuncT&& func)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    auto _best = std::chrono::duration<double>::max();
+    for(size_t n = 0; n < num_iterations; ++n)
+    {
+        auto _beg = clock_type::now();
+        func();
+        auto _end = clock_type::now();
+
+        _best = std::min<std::chrono::duration<double>>(_best, _end - _beg);
+    }
+    return _best.count();
+}
+}  // namespace
+
+TEST(att_parser, benchmark)
+{
+    const char* _dir = getenv("ROCPROFILER_ATT_BENCHMARK_DATA");
+    if(!_dir) GTEST_SKIP() << "set ROCPROFILER_ATT_BENCHMARK_DATA to a directory of .att files";
+
+    auto _data = load_shader_engines(_dir);
+    ASSERT_FALSE(_data.empty()) << "no .att files in " << _dir;
+
+    auto _shader_engines = std::vector<rocprofiler_att_parser_shader_engine_data_t>{};
+    for(size_t i = 0; i < _data.size(); ++i)
+        _shader_engines.emplace_back(rocprofiler_att_parser_shader_engine_data_t{
+            static_cast<int64_t>(i), _data.at(i).data(), _data.at(i).size()});
+
+    auto _per_record = totals_t{};
+    auto _batched    = totals_t{};
+    auto _parallel   = totals_t{};
+
+    auto _per_record_time = measure([&]() { parse_per_record(_shader_engines, _per_record); });
+    auto _batched_time    = measure(
+        [&]() { parse_batched(_shader_engines, _batched, ROCPROFILER_ATT_PARSER_FLAG_NONE); });
+    auto _parallel_time = measure([&]() {
+        parse_batched(
+            _shader_engines, _parallel, ROCPROFILER_ATT_PARSER_FLAG_PARALLEL_SHADER_ENGINES);
+    });
+
+    auto _records = (_per_record.isa + _per_record.occupancy) / num_iterations;
+    std::cout << _data.size() << " shader engines, " << _records << " records\n";
+    for(auto [name, time] : {std::make_pair("per record", _per_record_time),
+                             std::make_pair("batched", _batched_time),
+                             std::make_pair("batched + parallel SE", _parallel_time)})
+    {
+        std::cout << std::setw(24) << name << std::fixed << std::setprecision(3) << std::setw(12)
+                  << time * 1.0e3 << " ms" << std::setw(12) << _records / time / 1.0e6
+                  << " M records/sec" << std::endl;
+    }
+
+    // every mode delivers the same records
+    EXPECT_EQ(_batched.isa.load(), _per_record.isa.load());
+    EXPECT_EQ(_batched.occupancy.load(), _per_record.occupancy.load());
+    EXPECT_EQ(_batched.hitcount.load(), _per_record.hitcount.load());
+    EXPECT_EQ(_parallel.isa.load(), _per_record.isa.load());
+    EXPECT_EQ(_parallel.occupancy.load(), _per_record.occupancy.load());
+    EXPECT_EQ(_parallel.hitcount.load(), _per_record.hitcount.load());
+}
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "lib/common/container/small_flat_map.hpp"
 #include "lib/common/container/small_vector.hpp"
 
 #include <rocprofiler-sdk/fwd.h>
@@ -39,15 +40,20 @@ struct correlation_tracing_service;
 }  // namespace context
 namespace tracing
 {
+constexpr auto context_data_vec_size            = 2;
+constexpr auto external_correlation_id_map_size = 2 * context_data_vec_size;
+constexpr auto empty_user_data                  = rocprofiler_user_data_t{.value = 0};
+
 template <typename Tp, size_t N>
-using small_vector_t                = common::container::small_vector<Tp, N>;
-using correlation_service           = context::correlation_tracing_service;
-using context_t                     = context::context;
-using context_array_t               = common::container::small_vector<const context_t*>;
-using external_correlation_id_map_t = std::unordered_map<const context_t*, rocprofiler_user_data_t>;
+using small_vector_t      = common::container::small_vector<Tp, N>;
+using correlation_service = context::correlation_tracing_service;
+using context_t           = context::context;
+using context_array_t     = common::container::small_vector<const context_t*>;
 
-constexpr auto context_data_vec_size = 2;
-constexpr auto empty_user_data       = rocprofiler_user_data_t{.value = 0};
+// constructed for every traced API call and nearly always holds one or two contexts so
+// avoid heap allocations and hashing
+using external_correlation_id_map_t = common::container::
+    small_flat_map<const context_t*, rocprofiler_user_data_t, external_correlation_id_map_size>;
 
 struct callback_context_data
 {
@@ -73,16 +73,19 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         extern_corr_ids.clear();
     }
 
-    const auto minimal_context_filter = [](const context_t* ctx) {
-        return (ctx->callback_tracer || ctx->buffered_tracer);
-    };
+    const auto snapshot = context::get_active_tracing_snapshot();
 
-    for(const auto* itr : context::get_active_contexts(minimal_context_filter))
-    {
-        if(!itr) continue;
+    // union of the domains + ops of all active contexts: if neither is enabled, no context
+    // will be populated so avoid iterating over the contexts
+    const bool enabled_callback = snapshot->callback_domains(callback_domain_idx, operation_idx);
+    const bool enabled_buffered = snapshot->buffered_domains(buffered_domain_idx, operation_idx);
+
+    if(!enabled_callback && !enabled_buffered) return;
 
+    for(const auto* itr : snapshot->contexts)
+    {
         // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, callback_domain_idx, operation_idx))
+        if(enabled_callback && context_filter(itr, callback_domain_idx, operation_idx))
         {
             callback_contexts.emplace_back(
                 callback_context_data{itr, rocprofiler_callback_tracing_record_t{}});
@@ -90,7 +93,7 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         }
 
         // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, buffered_domain_idx, operation_idx))
+        if(enabled_buffered && context_filter(itr, buffered_domain_idx, operation_idx))
         {
             buffered_contexts.emplace_back(buffered_context_data{itr});
             extern_corr_ids.emplace(itr, empty_user_data);
@@ -114,16 +117,19 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         extern_corr_ids.clear();
     }
 
-    const auto minimal_context_filter = [](const context_t* ctx) {
-        return (ctx->callback_tracer || ctx->buffered_tracer);
-    };
+    const auto snapshot = context::get_active_tracing_snapshot();
 
-    for(const auto* itr : context::get_active_contexts(minimal_context_filter))
-    {
-        if(!itr) continue;
+    // union of the domains + ops of all active contexts: if neither is enabled, no context
+    // will be populated so avoid iterating over the contexts
+    const bool enabled_callback = snapshot->callback_domains(callback_domain_idx);
+    const bool enabled_buffered = snapshot->buffered_domains(buffered_domain_idx);
+
+    if(!enabled_callback && !enabled_buffered) return;
 
+    for(const auto* itr : snapshot->contexts)
+    {
         // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, callback_domain_idx))
+        if(enabled_callback && context_filter(itr, callback_domain_idx))
         {
             callback_contexts.emplace_back(
                 callback_context_data{itr, rocprofiler_callback_tracing_record_t{}});
@@ -131,7 +137,7 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         }
 
         // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, buffered_domain_idx))
+        if(enabled_buffered && context_filter(itr, buffered_domain_idx))
         {
             buffered_contexts.emplace_back(buffered_context_data{itr});
             extern_corr_ids.emplace(itr, empty_user_data);
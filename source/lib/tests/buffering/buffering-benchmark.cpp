@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright (c) 2023 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "buffering.hpp"
+#include "lib/common/container/record_header_buffer.hpp"
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace test = ::rocprofiler::test;
+
+using record_header_buffer_t = rocprofiler::common::container::record_header_buffer;
+using sync_mode_t            = record_header_buffer_t::sync_mode;
+using record_t               = test::raw_array<uint64_t, 4>;
+
+// total number of records emplaced per measurement regardless of the number of threads.
+// NOTE: record_header_buffer reserves one header per byte so keep the buffer modest
+constexpr size_t num_records    = 1 << 17;
+constexpr size_t num_iterations = 5;
+
+const char*
+as_string(sync_mode_t _mode)
+{
+    return (_mode == sync_mode_t::lock_free) ? "lock_free" : "locked";
+}
+
+// returns the best emplace throughput (in millions of records per second) of several iterations.
+// A batch size greater than one emplaces the records in ranges of the batch size
+double
+measure(sync_mode_t _mode, size_t _nthreads, size_t _batch = 1)
+{
+    auto _record = record_t{};
+    test::generate(_record, uint64_t{0}, std::numeric_limits<uint64_t>::max());
+    auto _range = std::vector<record_t>(_batch, _record);
+
+    auto _per_thread = num_records / _nthreads;
+    auto _best       = std::chrono::duration<double>::max();
+
+    for(size_t n = 0; n < num_iterations; ++n)
+    {
+        auto _buffer  = record_header_buffer_t{num_records * sizeof(record_t), _mode};
+        auto _barrier = pthread_barrier_t{};
+        pthread_barrier_init(&_barrier, nullptr, _nthreads + 1);
+
+        using clock_type = std::chrono::steady_clock;
+
+        // each thread records when it started and stopped emplacing since the main thread
+        // may not be rescheduled promptly when the threads are released
+        auto _failed  = std::atomic<size_t>{0};
+        auto _beg     = std::vector<clock_type::time_point>(_nthreads);
+        auto _end     = std::vector<clock_type::time_point>(_nthreads);
+        auto _threads = std::vector<std::thread>{};
+        _threads.reserve(_nthreads);
+        for(size_t i = 0; i < _nthreads; ++i)
+        {
+            _threads.emplace_back([&, i]() {
+                pthread_barrier_wait(&_barrier);
+                _beg.at(i) = clock_type::now();
+                if(_batch == 1)
+                {
+                    for(size_t j = 0; j < _per_thread; ++j)
+                    {
+                        if(!_buffer.emplace(1, 1, _record)) ++_failed;
+                    }
+                }
+                else
+                {
+                    for(size_t j = 0; j < _per_thread; j += _batch)
+                    {
+                        auto _n = std::min(_batch, _per_thread - j);
+                        if(_buffer.emplace_range(1, 1, _range.data(), _n) != _n) ++_failed;
+                    }
+                }
+                _end.at(i) = clock_type::now();
+            });
+        }
+
+        // release the threads and wait for them to finish emplacing
+        pthread_barrier_wait(&_barrier);
+        for(auto& itr : _threads)
+            itr.join();
+        pthread_barrier_destroy(&_barrier);
+
+        EXPECT_EQ(_failed.load(), 0);
+        EXPECT_EQ(_buffer.size(), _per_thread * _nthreads);
+
+        auto _elapsed = *std::max_element(_end.begin(), _end.end()) -
+                        *std::min_element(_beg.begin(), _beg.end());
+        _best = std::min<std::chrono::duration<double>>(_best, _elapsed);
+    }
+
+    return (_per_thread * _nthreads) / _best.count() / 1.0e6;
+}
+}  // namespace
+
+TEST(buffering, benchmark)
+{
+    // reports the emplace throughput of the locked and the lock-free synchronization modes
+    // for an increasing number of threads contending on the same buffer
+
+    // warm-up
+    measure(sync_mode_t::locked, 1);
+    measure(sync_mode_t::lock_free, 1);
+
+    std::cout << std::setw(8) << "threads" << std::setw(18) << as_string(sync_mode_t::locked)
+              << std::setw(18) << as_string(sync_mode_t::lock_free) << std::setw(10) << "speedup"
+              << "\n";
+
+    for(size_t nthreads : {1, 2, 4, 8, 16, 32, 64, 128})
+    {
+        auto _locked    = measure(sync_mode_t::locked, nthreads);
+        auto _lock_free = measure(sync_mode_t::lock_free, nthreads);
+        std::cout << std::setw(8) << nthreads << std::fixed << std::setprecision(3)
+                  << std::setw(11) << _locked << " Mrec/s" << std::setw(11) << _lock_free
+                  << " Mrec/s" << std::setw(9) << (_lock_free / _locked) << "x" << std::endl;
+    }
+}
+
+TEST(buffering, benchmark_range)
+{
+    // reports the throughput of emplacing the records in ranges (as the PC sampling and counter
+    // collection records are) relative to emplacing the records one at a time
+
+    measure(sync_mode_t::locked, 1, 16);
+
+    constexpr auto batch_sizes = std::array<size_t, 4>{1, 16, 64, 256};
+
+    std::cout << std::setw(8) << "threads";
+    for(auto itr : batch_sizes)
+        std::cout << std::setw(18) << ("batch=" + std::to_string(itr));
+    std::cout << "\n";
+
+    for(size_t nthreads : {1, 4, 16})
+    {
+        std::cout << std::setw(8) << nthreads << std::fixed << std::setprecision(3);
+        for(auto itr : batch_sizes)
+            std::cout << std::setw(11) << measure(sync_mode_t::locked, nthreads, itr) << " Mrec/s";
+        std::cout << std::endl;
+    }
+}
@@ -178,22 +178,17 @@ validate(const std::vector<rocprofiler_record_header_t*>& _headers,
 {
     (validate<Tp>(_headers, _seq), ...);
 }
-}  // namespace
 
-TEST(buffering, parallel)
+void
+run_parallel(record_header_buffer_t::sync_mode _mode)
 {
-    // this test launches 160 threads, each with a randomly generated array of data
-    // and has them contend for emplacing their data in the same buffer. The purpose
-    // of this test is to validate that multiple threads can write to the same
-    // (lock-free) buffer without any data corruption or loss.
-
     constexpr auto num_variants = test_data_types::size() * test_data_sizes.size();
     constexpr auto data_size    = get_data_size(test_data_types{}, test_data_sizes);
 
     EXPECT_EQ(num_variants, 150);
 
     // make a buffer large enough to hold all the data we generate
-    auto _buffer = record_header_buffer_t{data_size};
+    auto _buffer = record_header_buffer_t{data_size, _mode};
 
     // create a barrier that all child threads will wait and then race to enqueue their data in the
     // buffer i.e., we want to maximize contention on inserting into buffer
@@ -214,3 +209,21 @@ TEST(buffering, parallel)
     // verify the data pulled out the buffer matches the data put in by the threads
     validate(_buffer.get_record_headers(), test_data_types{}, test_data_sizes);
 }
+}  // namespace
+
+TEST(buffering, parallel)
+{
+    // this test launches 160 threads, each with a randomly generated array of data
+    // and has them contend for emplacing their data in the same buffer. The purpose
+    // of this test is to validate that multiple threads can write to the same
+    // (lock-free) buffer without any data corruption or loss.
+
+    run_parallel(record_header_buffer_t::sync_mode::locked);
+}
+
+TEST(buffering, parallel_lock_free)
+{
+    // same as above but writers do not take the shared mutex when emplacing
+
+    run_parallel(record_header_buffer_t::sync_mode::lock_free);
+}
@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "buffering.hpp"
+#include "lib/common/container/record_header_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace test = ::rocprofiler::test;
+
+using record_header_buffer_t = rocprofiler::common::container::record_header_buffer;
+using sync_mode_t            = record_header_buffer_t::sync_mode;
+using record_t               = test::raw_array<uint64_t, 4>;
+
+constexpr uint32_t record_category = 3;
+constexpr uint32_t record_kind     = 7;
+
+auto
+generate_records(size_t _n)
+{
+    auto _v = std::vector<record_t>(_n);
+    for(auto& itr : _v)
+        test::generate(itr, uint64_t{0}, uint64_t{1000});
+    return _v;
+}
+
+// pulls the records back out of the buffer in the order of the headers
+auto
+extract_records(record_header_buffer_t& _buffer)
+{
+    auto _v = std::vector<record_t>{};
+    for(auto* itr : _buffer.get_record_headers())
+    {
+        EXPECT_EQ(itr->category, record_category);
+        EXPECT_EQ(itr->kind, record_kind);
+        _v.emplace_back(*static_cast<record_t*>(itr->payload));
+    }
+    return _v;
+}
+}  // namespace
+
+TEST(buffering, emplace_range)
+{
+    // verifies that a range is placed in order and that the range is split when the buffer only
+    // has room for the leading records of the range
+    for(auto _mode : {sync_mode_t::locked, sync_mode_t::lock_free})
+    {
+        // the size of the buffer is a multiple of the page size
+        constexpr size_t capacity = 128;
+
+        auto _buffer  = record_header_buffer_t{capacity * sizeof(record_t), _mode};
+        auto _records = generate_records(3 * capacity / 2);
+        ASSERT_EQ(_buffer.capacity(), capacity * sizeof(record_t));
+
+        EXPECT_EQ(_buffer.emplace_range(record_category, record_kind, _records.data(), 0), 0);
+        EXPECT_EQ(_buffer.size(), 0);
+
+        auto _first = _buffer.emplace_range(record_category, record_kind, _records.data(), 10);
+        EXPECT_EQ(_first, 10);
+        EXPECT_EQ(_buffer.size(), 10);
+
+        // only part of the remainder fits
+        auto _second = _buffer.emplace_range(
+            record_category, record_kind, _records.data() + _first, _records.size() - _first);
+        EXPECT_EQ(_second, capacity - _first);
+        EXPECT_EQ(_buffer.size(), capacity);
+        EXPECT_TRUE(_buffer.is_full());
+
+        // the buffer is full
+        EXPECT_EQ(_buffer.emplace_range(
+                      record_category, record_kind, _records.data() + capacity, size_t{1}),
+                  0);
+
+        auto _result = extract_records(_buffer);
+        ASSERT_EQ(_result.size(), capacity);
+        for(size_t i = 0; i < capacity; ++i)
+            EXPECT_EQ(_result.at(i), _records.at(i)) << "record " << i;
+
+        // the remainder of the range is placed after the buffer is cleared
+        _buffer.clear();
+        auto _third = _buffer.emplace_range(record_category,
+                                            record_kind,
+                                            _records.data() + capacity,
+                                            _records.size() - capacity);
+        EXPECT_EQ(_third, _records.size() - capacity);
+
+        _result = extract_records(_buffer);
+        ASSERT_EQ(_result.size(), _records.size() - capacity);
+        for(size_t i = 0; i < _result.size(); ++i)
+            EXPECT_EQ(_result.at(i), _records.at(capacity + i)) << "record " << i;
+    }
+}
+
+TEST(buffering, emplace_range_parallel)
+{
+    // verifies that the ranges emplaced concurrently remain contiguous in the buffer
+    constexpr size_t nthreads   = 8;
+    constexpr size_t nranges    = 64;
+    constexpr size_t range_size = 16;
+
+    for(auto _mode : {sync_mode_t::locked, sync_mode_t::lock_free})
+    {
+        auto _buffer =
+            record_header_buffer_t{nthreads * nranges * range_size * sizeof(record_t), _mode};
+        auto _failed  = std::atomic<size_t>{0};
+        auto _threads = std::vector<std::thread>{};
+        for(size_t i = 0; i < nthreads; ++i)
+        {
+            _threads.emplace_back([&_buffer, &_failed, i]() {
+                // every record of a range holds the thread and range index
+                auto _range = std::vector<record_t>(range_size);
+                for(size_t j = 0; j < nranges; ++j)
+                {
+                    for(size_t k = 0; k < range_size; ++k)
+                    {
+                        _range.at(k)[0] = i;
+                        _range.at(k)[1] = j;
+                        _range.at(k)[2] = k;
+                        _range.at(k)[3] = 0;
+                    }
+                    if(_buffer.emplace_range(
+                           record_category, record_kind, _range.data(), _range.size()) !=
+                       range_size)
+                        ++_failed;
+                }
+            });
+        }
+
+        for(auto& itr : _threads)
+            itr.join();
+
+        EXPECT_EQ(_failed.load(), 0);
+
+        auto _result = extract_records(_buffer);
+        ASSERT_EQ(_result.size(), nthreads * nranges * range_size);
+        for(size_t i = 0; i < _result.size(); i += range_size)
+        {
+            for(size_t k = 0; k < range_size; ++k)
+            {
+                EXPECT_EQ(_result.at(i + k)[0], _result.at(i)[0]);
+                EXPECT_EQ(_result.at(i + k)[1], _result.at(i)[1]);
+                EXPECT_EQ(_result.at(i + k)[2], k);
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/memory/epoch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace memory = ::rocprofiler::common::memory;
+
+struct snapshot
+{
+    uint64_t              value  = 0;
+    std::vector<uint64_t> values = {};
+};
+
+auto
+make_snapshot(uint64_t _value)
+{
+    return std::make_unique<snapshot>(snapshot{_value, std::vector<uint64_t>(64, _value)});
+}
+}  // namespace
+
+TEST(epoch, reclaim)
+{
+    auto _ptr = memory::epoch_ptr<snapshot>{};
+    _ptr.publish(make_snapshot(1));
+    EXPECT_EQ(_ptr.retired_size(), 0);
+
+    {
+        // a guard prevents the snapshot it may be reading from being released
+        auto        _guard = memory::epoch_guard{};
+        const auto* _value = _ptr.load();
+
+        _ptr.publish(make_snapshot(2));
+        _ptr.publish(make_snapshot(3));
+        EXPECT_EQ(_ptr.retired_size(), 2);
+        EXPECT_EQ(_value->value, 1);
+        EXPECT_EQ(_ptr.load()->value, 3);
+    }
+
+    // once the guard is released, the superseded snapshots are released by the next publish
+    _ptr.publish(make_snapshot(4));
+    EXPECT_EQ(_ptr.retired_size(), 0);
+    EXPECT_EQ(_ptr.load()->value, 4);
+}
+
+TEST(epoch, concurrent_readers)
+{
+    constexpr size_t num_readers = 4;
+    constexpr size_t num_updates = 10000;
+
+    auto _ptr  = memory::epoch_ptr<snapshot>{};
+    auto _stop = std::atomic<bool>{false};
+    _ptr.publish(make_snapshot(0));
+
+    auto _readers = std::vector<std::thread>{};
+    for(size_t i = 0; i < num_readers; ++i)
+    {
+        _readers.emplace_back([&_ptr, &_stop]() {
+            while(!_stop.load())
+            {
+                auto        _guard = memory::epoch_guard{};
+                const auto* _value = _ptr.load();
+                for(auto itr : _value->values)
+                    ASSERT_EQ(itr, _value->value);
+            }
+        });
+    }
+
+    for(uint64_t i = 1; i <= num_updates; ++i)
+        _ptr.publish(make_snapshot(i));
+
+    _stop.store(true);
+    for(auto& itr : _readers)
+        itr.join();
+
+    // all the readers have exited so every superseded snapshot is released
+    _ptr.publish(make_snapshot(num_updates + 1));
+    EXPECT_EQ(_ptr.retired_size(), 0);
+}
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/container/small_flat_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace
+{
+namespace container = ::rocprofiler::common::container;
+}  // namespace
+
+TEST(common, small_flat_map)
+{
+    using map_t = container::small_flat_map<int, double, 2>;
+
+    auto _map = map_t{};
+    EXPECT_TRUE(_map.empty());
+
+    // emplace does not overwrite
+    EXPECT_TRUE(_map.emplace(1, 1.0).second);
+    EXPECT_FALSE(_map.emplace(1, 2.0).second);
+    EXPECT_EQ(_map.at(1), 1.0);
+    EXPECT_EQ(_map.size(), 1);
+
+    // grows beyond the inline capacity
+    for(int i = 2; i < 10; ++i)
+        _map.emplace(i, i * 1.0);
+    EXPECT_EQ(_map.size(), 9);
+    for(int i = 1; i < 10; ++i)
+    {
+        EXPECT_EQ(_map.count(i), 1);
+        EXPECT_EQ(_map.at(i), i * 1.0);
+    }
+
+    EXPECT_EQ(_map.find(10), _map.end());
+    EXPECT_EQ(_map.count(10), 0);
+    EXPECT_THROW(_map.at(10), std::out_of_range);
+
+    _map[10] = 10.0;
+    EXPECT_EQ(_map.at(10), 10.0);
+
+    _map.clear();
+    EXPECT_TRUE(_map.empty());
+    EXPECT_EQ(_map.find(1), _map.end());
+}
@@ -0,0 +1,120 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Benchmark of the external correlation id map. Reports the cost per traced API call with an
+// std::unordered_map (previous implementation) vs. a small_flat_map for 1, 2, 4 and 8 active
+// contexts.
+//
+//  usage: common-small-flat-map-benchmark [<number of calls>]
+
+#include "lib/common/container/small_flat_map.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+namespace container = ::rocprofiler::common::container;
+
+struct context
+{
+    uint64_t context_idx = 0;
+};
+
+struct user_data
+{
+    uint64_t value = 0;
+};
+
+// emulates the lifetime of the external correlation id map in a traced API call:
+// populate per active context, assign the external correlation ids, and look up the
+// external correlation id for each callback
+template <typename MapT>
+uint64_t
+traced_call(const std::vector<const context*>& _contexts, uint64_t _internal_corr_id)
+{
+    auto _extern_corr_ids = MapT{};
+    for(const auto* itr : _contexts)
+        _extern_corr_ids.emplace(itr, user_data{});
+
+    for(auto& itr : _extern_corr_ids)
+        itr.second.value = itr.first->context_idx + _internal_corr_id;
+
+    uint64_t _sum = 0;
+    for(const auto* itr : _contexts)
+        _sum += _extern_corr_ids.at(itr).value;
+    return _sum;
+}
+
+template <typename MapT>
+double
+measure(const std::vector<const context*>& _contexts, size_t _ncalls)
+{
+    volatile uint64_t _sink = 0;
+    auto              _beg  = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < _ncalls; ++i)
+        _sink = _sink + traced_call<MapT>(_contexts, i);
+    auto _end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(_end - _beg).count() / _ncalls;
+}
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    size_t _ncalls = 1000000;
+    if(argc > 1) _ncalls = std::stoull(argv[1]);
+
+    using unordered_map_t = std::unordered_map<const context*, user_data>;
+    using flat_map_t      = container::small_flat_map<const context*, user_data, 4>;
+
+    auto _data = std::vector<context>{{1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}};
+
+    std::cout << std::setw(10) << "contexts" << std::setw(18) << "unordered_map" << std::setw(18)
+              << "small_flat_map"
+              << "\n";
+    for(size_t n : {1, 2, 4, 8})
+    {
+        auto _contexts = std::vector<const context*>{};
+        for(size_t i = 0; i < n; ++i)
+            _contexts.emplace_back(&_data.at(i));
+
+        if(traced_call<unordered_map_t>(_contexts, n) != traced_call<flat_map_t>(_contexts, n))
+        {
+            std::cerr << "small_flat_map result differs for " << n << " contexts" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        auto _unordered = measure<unordered_map_t>(_contexts, _ncalls);
+        auto _flat      = measure<flat_map_t>(_contexts, _ncalls);
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(2) << std::setw(15)
+                  << _unordered << " ns" << std::setw(15) << _flat << " ns" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/container/spsc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace container = ::rocprofiler::common::container;
+
+struct record
+{
+    uint64_t value      = 0;
+    uint64_t padding[7] = {};
+};
+}  // namespace
+
+TEST(spsc_queue, ordering)
+{
+    using queue_type = container::spsc_queue<record, 1024>;
+
+    static_assert(queue_type::segment_size == 16);
+
+    auto   _queue = queue_type{};
+    size_t _grown = 0;
+    for(uint64_t i = 0; i < 100; ++i)
+        _grown += (_queue.push(record{i}) ? 1 : 0);
+
+    // 100 records span 7 segments of 16 records
+    EXPECT_EQ(_grown, 6);
+    EXPECT_FALSE(_queue.empty());
+
+    uint64_t _expected = 0;
+    auto     _count    = _queue.consume([&_expected](record& _v) {
+        EXPECT_EQ(_v.value, _expected);
+        ++_expected;
+    });
+    EXPECT_EQ(_count, 100);
+    EXPECT_TRUE(_queue.empty());
+    EXPECT_EQ(_queue.consume([](record&) {}), 0);
+
+    // fill the remainder of the partially consumed segment and beyond
+    for(uint64_t i = 100; i < 150; ++i)
+        _queue.push(record{i});
+
+    _count = _queue.consume([&_expected](record& _v) {
+        EXPECT_EQ(_v.value, _expected);
+        ++_expected;
+    });
+    EXPECT_EQ(_count, 50);
+    EXPECT_TRUE(_queue.empty());
+}
+
+TEST(spsc_queue, capacity)
+{
+    using queue_type = container::spsc_queue<record, 1024>;
+
+    auto _queue = queue_type{3};
+    for(uint64_t i = 0; i < (3 * queue_type::segment_size); ++i)
+    {
+        EXPECT_FALSE(_queue.full());
+        _queue.push(record{i});
+    }
+    EXPECT_TRUE(_queue.full());
+
+    // consuming releases every segment except the one the producer is writing to
+    EXPECT_EQ(_queue.consume([](record&) {}), 3 * queue_type::segment_size);
+    EXPECT_FALSE(_queue.full());
+    EXPECT_TRUE(_queue.empty());
+
+    // an unbounded queue is never full
+    auto _unbounded = queue_type{};
+    for(uint64_t i = 0; i < (10 * queue_type::segment_size); ++i)
+        _unbounded.push(record{i});
+    EXPECT_FALSE(_unbounded.full());
+}
+
+TEST(spsc_queue, concurrent)
+{
+    using queue_type = container::spsc_queue<record, 4096>;
+
+    constexpr uint64_t num_records = 1000000;
+
+    auto _queue    = queue_type{};
+    auto _done     = std::atomic<bool>{false};
+    auto _producer = std::thread{[&_queue, &_done]() {
+        for(uint64_t i = 0; i < num_records; ++i)
+            _queue.push(record{i});
+        _done.store(true);
+    }};
+
+    uint64_t _expected = 0;
+    auto     _consume  = [&_queue, &_expected]() {
+        _queue.consume([&_expected](record& _v) {
+            EXPECT_EQ(_v.value, _expected);
+            ++_expected;
+        });
+    };
+
+    while(!_done.load())
+        _consume();
+    _producer.join();
+    _consume();
+
+    EXPECT_EQ(_expected, num_records);
+    EXPECT_TRUE(_queue.empty());
+}
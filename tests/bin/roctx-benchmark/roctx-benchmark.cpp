@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// CPU-only benchmark of the roctx marker overhead: every thread pushes and pops nested ranges
+// as fast as possible. Run it with and without "rocprofv3 --marker-trace" to measure the
+// overhead of the marker tracing per marker.
+//
+//  usage: roctx-benchmark [<num-threads> [<num-iterations>]]
+
+#include "rocprofiler-sdk-roctx/roctx.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t range_depth = 4;
+
+auto ready_threads = std::atomic<size_t>{0};
+auto start_flag    = std::atomic<bool>{false};
+
+void
+run(size_t num_threads, size_t num_iterations, double& elapsed)
+{
+    ++ready_threads;
+    while(ready_threads.load() < num_threads || !start_flag.load())
+        std::this_thread::yield();
+
+    auto _beg = clock_type::now();
+    for(size_t i = 0; i < num_iterations; ++i)
+    {
+        for(size_t j = 0; j < range_depth; ++j)
+            roctxRangePush("roctx-benchmark");
+        for(size_t j = 0; j < range_depth; ++j)
+            roctxRangePop();
+    }
+    auto _end = clock_type::now();
+
+    elapsed = std::chrono::duration<double, std::nano>(_end - _beg).count();
+}
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    size_t num_threads    = 64;
+    size_t num_iterations = 10000;
+    if(argc > 1) num_threads = std::stoul(argv[1]);
+    if(argc > 2) num_iterations = std::stoul(argv[2]);
+
+    auto _elapsed = std::vector<double>(num_threads, 0.0);
+    auto _threads = std::vector<std::thread>{};
+    _threads.reserve(num_threads);
+    for(size_t i = 0; i < num_threads; ++i)
+        _threads.emplace_back(run, num_threads, num_iterations, std::ref(_elapsed.at(i)));
+
+    auto _beg = clock_type::now();
+    start_flag.store(true);
+    for(auto& itr : _threads)
+        itr.join();
+    auto _end = clock_type::now();
+
+    // every iteration of a thread invokes push and pop range_depth times
+    auto _markers_per_thread = 2 * range_depth * num_iterations;
+    auto _markers            = num_threads * _markers_per_thread;
+    auto _wall = std::chrono::duration<double, std::nano>(_end - _beg).count();
+    auto _max  = *std::max_element(_elapsed.begin(), _elapsed.end());
+    auto _sum  = double{0.0};
+    for(auto itr : _elapsed)
+        _sum += itr;
+
+    std::cout << std::fixed << std::setprecision(2) << "[roctx-benchmark] threads: " << num_threads
+              << ", markers: " << _markers << ", wall time: " << (_wall * 1.0e-6) << " msec"
+              << "\n[roctx-benchmark] overhead per marker: " << (_sum / _markers)
+              << " nsec (average per thread), " << (_max / _markers_per_thread)
+              << " nsec (slowest thread), " << (_wall / _markers) << " nsec (wall / markers)"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}